@@ -71,6 +71,18 @@
 
 #include "up_internal.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest packet that the network may send with the emulated TCP
+ * segmentation offload.
+ */
+
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+#  define SIM_NETDEV_TSOMAX 16384
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -84,10 +96,39 @@ static struct work_s g_recv_work;
 
 static struct net_driver_s g_sim_dev;
 
+/* Packet buffer, used unless the frames are received into I/O buffers */
+
+static void *g_pktbuf;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+static int netdriver_transmit(struct net_driver_s *dev)
+{
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  /* Emulate the checksum offload */
+
+  netdev_offload_txcsum(dev);
+#endif
+
+  NETDEV_TXPACKETS(dev);
+  netdev_send(dev->d_buf, dev->d_len);
+  NETDEV_TXDONE(dev);
+  return OK;
+}
+
+static void netdriver_send(struct net_driver_s *dev)
+{
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  /* Emulate the segmentation offload */
+
+  netdev_offload_tso(dev, netdriver_transmit);
+#else
+  netdriver_transmit(dev);
+#endif
+}
+
 static void netdriver_reply(struct net_driver_s *dev)
 {
   /* If the receiving resulted in data that should be sent out on
@@ -120,9 +161,7 @@ static void netdriver_reply(struct net_driver_s *dev)
 
       /* Send the packet */
 
-      NETDEV_TXPACKETS(dev);
-      netdev_send(dev->d_buf, dev->d_len);
-      NETDEV_TXDONE(dev);
+      netdriver_send(dev);
     }
 }
 
@@ -139,6 +178,17 @@ static void netdriver_recv_work(void *arg)
 
   while (netdev_avail())
     {
+#ifdef CONFIG_NETDEV_IOB_RX
+      /* Receive into an I/O buffer if possible, so that the payload can be
+       * queued for the socket without another copy.
+       */
+
+      if (netdev_iob_prepare(dev, true) < 0)
+        {
+          dev->d_buf = g_pktbuf;
+        }
+#endif
+
       /* netdev_read will return 0 on a timeout event and > 0
        * on a data received event
        */
@@ -236,6 +286,14 @@ static void netdriver_recv_work(void *arg)
         }
     }
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* Do not leave d_buf pointing into the I/O buffer of the device, the
+   * packets polled from the network are built in the packet buffer.
+   */
+
+  dev->d_buf = g_pktbuf;
+#endif
+
   net_unlock();
 }
 
@@ -273,9 +331,7 @@ static int netdriver_txpoll(struct net_driver_s *dev)
         {
           /* Send the packet */
 
-          NETDEV_TXPACKETS(dev);
-          netdev_send(dev->d_buf, dev->d_len);
-          NETDEV_TXDONE(dev);
+          netdriver_send(dev);
         }
     }
 
@@ -297,6 +353,11 @@ static int netdriver_ifdown(struct net_driver_s *dev)
 {
   netdev_carrier_off(dev);
   netdev_ifdown();
+
+#ifdef CONFIG_NETDEV_IOB_RX
+  netdev_iob_release(dev);
+  dev->d_buf = g_pktbuf;
+#endif
   return OK;
 }
 
@@ -307,6 +368,14 @@ static void netdriver_txavail_work(void *arg)
   net_lock();
   if (IFF_IS_UP(dev->d_flags))
     {
+#ifdef CONFIG_NETDEV_IOB_RX
+      /* The packet buffer is the one that is sized for the largest TCP
+       * segment, d_buf may still point at a received I/O buffer.
+       */
+
+      dev->d_buf = g_pktbuf;
+#endif
+
       devif_poll(dev, netdriver_txpoll);
     }
 
@@ -348,7 +417,6 @@ static void netdriver_rxready_interrupt(void *priv)
 int netdriver_init(void)
 {
   struct net_driver_s *dev = &g_sim_dev;
-  void *pktbuf;
   int pktsize;
 
   /* Internal initialization */
@@ -362,17 +430,30 @@ int netdriver_init(void)
   pktsize = dev->d_pktsize ? dev->d_pktsize :
             (MAX_NETDEV_PKTSIZE + CONFIG_NET_GUARDSIZE);
 
+#ifdef CONFIG_SIM_NETDEV_OFFLOAD
+  /* Advertise the emulated offloads.  The packet buffer must then hold the
+   * largest TCP segment.
+   */
+
+  dev->d_offload = NETDEV_OFFLOAD_TXCSUM | NETDEV_OFFLOAD_TSO;
+  dev->d_tsomax  = SIM_NETDEV_TSOMAX;
+  if (pktsize < SIM_NETDEV_TSOMAX + CONFIG_NET_GUARDSIZE)
+    {
+      pktsize = SIM_NETDEV_TSOMAX + CONFIG_NET_GUARDSIZE;
+    }
+#endif
+
   /* Allocate packet buffer */
 
-  pktbuf = kmm_malloc(pktsize);
-  if (pktbuf == NULL)
+  g_pktbuf = kmm_malloc(pktsize);
+  if (g_pktbuf == NULL)
     {
       return -ENOMEM;
     }
 
   /* Set callbacks */
 
-  dev->d_buf     = pktbuf;
+  dev->d_buf     = g_pktbuf;
   dev->d_ifup    = netdriver_ifup;
   dev->d_ifdown  = netdriver_ifdown;
   dev->d_txavail = netdriver_txavail;
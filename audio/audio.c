@@ -596,6 +596,14 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           audinfo("AUDIOIOC_REGISTERMQ\n");
 
           ret = fs_getfilep((mqd_t)arg, &upper->usermq);
+          if (ret >= 0)
+            {
+              /* The lower half posts to the queue from its own context,
+               * the queue is kept without a reference.
+               */
+
+              fs_putfilep(upper->usermq);
+            }
         }
         break;
 
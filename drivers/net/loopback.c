@@ -154,6 +154,12 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
        pkt_input(&priv->lo_dev);
 #endif
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+      /* Checksums are neither computed nor checked on the loopback */
+
+      priv->lo_dev.d_pktflags = NETDEV_PKT_RXCSUM_OK;
+#endif
+
       /* We only accept IP packets of the configured type and ARP packets */
 
 #ifdef CONFIG_NET_IPv4
@@ -251,6 +257,11 @@ static int lo_ifdown(FAR struct net_driver_s *dev)
   /* Mark the device "down" */
 
   priv->lo_bifup = false;
+
+#ifdef CONFIG_NETDEV_IOB_RX
+  netdev_iob_release(dev);
+  dev->d_buf = g_iobuffer;
+#endif
   return OK;
 }
 
@@ -285,6 +296,18 @@ static void lo_txavail_work(FAR void *arg)
           /* If so, then poll the network for new XMIT data */
 
           priv->lo_txdone = false;
+
+#ifdef CONFIG_NETDEV_IOB_RX
+          /* Build the packets in an I/O buffer, so that the looped back
+           * payload can be queued for the receiver without a copy.
+           */
+
+          if (netdev_iob_prepare(&priv->lo_dev, true) < 0)
+            {
+              priv->lo_dev.d_buf = g_iobuffer;
+            }
+#endif
+
           devif_poll(&priv->lo_dev, lo_txpoll);
         }
       while (priv->lo_txdone);
@@ -423,6 +446,9 @@ int localhost_initialize(void)
 #endif
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = priv;         /* Used to recover private state from dev */
+#ifdef CONFIG_NETDEV_OFFLOAD
+  priv->lo_dev.d_offload = NETDEV_OFFLOAD_TXCSUM | NETDEV_OFFLOAD_RXCSUM;
+#endif
 
   /* Register the loopabck device with the OS so that socket IOCTLs can b
    * performed.
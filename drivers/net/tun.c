@@ -137,6 +137,7 @@ struct tun_device_s
   sem_t             write_wait_sem;
   size_t            read_d_len;
   size_t            write_d_len;
+  FAR uint8_t      *write_d_buf; /* The reply to the last packet written */
 
   /* These packet buffer arrays required 16-bit alignment.  That alignment
    * is assured only by the preceding wide data types.
@@ -1041,6 +1042,12 @@ static void tun_dev_uninit(FAR struct tun_device_s *priv)
 
   netdev_unregister(&priv->dev);
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  net_lock();
+  netdev_iob_release(&priv->dev);
+  net_unlock();
+#endif
+
   nxsem_destroy(&priv->waitsem);
   nxsem_destroy(&priv->read_wait_sem);
   nxsem_destroy(&priv->write_wait_sem);
@@ -1108,13 +1115,27 @@ static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
 
       if (priv->write_d_len == 0)
         {
-          memcpy(priv->write_buf, buffer, buflen);
-
           net_lock();
-          priv->dev.d_buf = priv->write_buf;
+
+#ifdef CONFIG_NETDEV_IOB_RX
+          /* Receive into an I/O buffer if possible, so that the payload
+           * can be queued for the socket without another copy.
+           */
+
+          if (netdev_iob_prepare(&priv->dev, true) < 0)
+#endif
+            {
+              priv->dev.d_buf = priv->write_buf;
+            }
+
+          memcpy(priv->dev.d_buf, buffer, buflen);
           priv->dev.d_len = buflen;
 
           tun_net_receive(priv);
+
+          /* The network may have moved d_buf, any reply is found there */
+
+          priv->write_d_buf = priv->dev.d_buf;
           net_unlock();
 
           nwritten = buflen;
@@ -1176,7 +1197,7 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
               break;
             }
 
-          memcpy(buffer, priv->write_buf, priv->write_d_len);
+          memcpy(buffer, priv->write_d_buf, priv->write_d_len);
           nread = priv->write_d_len;
           priv->write_d_len = 0;
 
@@ -29,8 +29,11 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
@@ -41,12 +44,20 @@
  * Private Types
  ****************************************************************************/
 
+/* Each CPU adds its notes to its own buffer, so that no lock is shared
+ * between the CPUs.  The indices run from zero to NOTERAM_WRAP, which is a
+ * multiple of the buffer size, so that the reader can tell when the notes
+ * that it is reading have been overwritten.  Only the owning CPU advances
+ * ni_head; ni_tail is also advanced by noteram_buffer_clear(), both with
+ * compare-and-swap.  ni_read is only changed by the reader.
+ */
+
 struct noteram_info_s
 {
-  unsigned int ni_overwrite;
   volatile unsigned int ni_head;
   volatile unsigned int ni_tail;
   volatile unsigned int ni_read;
+  unsigned int ni_overrun;
   uint8_t ni_buffer[CONFIG_DRIVER_NOTERAM_BUFSIZE];
 };
 
@@ -65,6 +76,20 @@ struct noteram_taskname_s
 };
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define NOTERAM_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define NOTERAM_NCPUS 1
+#endif
+
+#define NOTERAM_WRAP \
+  ((UINT_MAX / CONFIG_DRIVER_NOTERAM_BUFSIZE - 1) * \
+   CONFIG_DRIVER_NOTERAM_BUFSIZE)
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -92,27 +117,56 @@ static const struct file_operations g_noteram_fops =
 #endif
 };
 
-static struct noteram_info_s g_noteram_info =
-{
+static struct noteram_info_s g_noteram_info[NOTERAM_NCPUS];
+
+static volatile unsigned int g_noteram_overwrite =
 #ifdef CONFIG_DRIVER_NOTERAM_DEFAULT_NOOVERWRITE
-  NOTERAM_MODE_OVERWRITE_DISABLE
+  NOTERAM_MODE_OVERWRITE_DISABLE;
 #else
-  NOTERAM_MODE_OVERWRITE_ENABLE
+  NOTERAM_MODE_OVERWRITE_ENABLE;
 #endif
-};
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
 static struct noteram_taskname_s g_noteram_taskname;
-#endif
 
 #ifdef CONFIG_SMP
-static volatile spinlock_t g_noteram_lock;
+static volatile spinlock_t g_noteram_taskname_lock;
+#endif
 #endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: noteram_taskname_lock and noteram_taskname_unlock
+ *
+ * Description:
+ *   Serialize the access to the task name buffer, which is shared by all
+ *   CPUs.
+ *
+ ****************************************************************************/
+
+#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
+static irqstate_t noteram_taskname_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_noteram_taskname_lock);
+#endif
+  return flags;
+}
+
+static void noteram_taskname_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_noteram_taskname_lock);
+#endif
+  up_irq_restore(flags);
+}
+#endif
+
 /****************************************************************************
  * Name: noteram_find_taskname
  *
@@ -255,7 +309,7 @@ static const char *noteram_get_taskname(pid_t pid)
   FAR struct noteram_taskname_info_s *ti;
   FAR struct tcb_s *tcb;
 
-  irq_mask = enter_critical_section();
+  irq_mask = noteram_taskname_lock();
 
   ti = noteram_find_taskname(pid);
   if (ti != NULL)
@@ -272,125 +326,173 @@ static const char *noteram_get_taskname(pid_t pid)
         }
     }
 
-  leave_critical_section(irq_mask);
+  noteram_taskname_unlock(irq_mask);
   return ret;
 }
 #endif
 
 /****************************************************************************
- * Name: noteram_buffer_clear
+ * Name: noteram_next
  *
  * Description:
- *   Clear all contents of the circular buffer.
+ *   Return the circular buffer index at offset from the specified index
+ *   value, handling wraparound
  *
  * Input Parameters:
- *   None.
+ *   ndx - Old circular buffer index
  *
  * Returned Value:
- *   None.
+ *   New circular buffer index
  *
  ****************************************************************************/
 
-static void noteram_buffer_clear(void)
+static inline unsigned int noteram_next(unsigned int ndx,
+                                        unsigned int offset)
 {
-  irqstate_t flags;
-
-  flags = enter_critical_section();
-
-  g_noteram_info.ni_tail = g_noteram_info.ni_head;
-  g_noteram_info.ni_read = g_noteram_info.ni_head;
-
-  if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  ndx += offset;
+  if (ndx >= NOTERAM_WRAP)
     {
-      g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+      ndx -= NOTERAM_WRAP;
     }
 
-#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
-  g_noteram_taskname.buffer_used = 0;
-#endif
-
-  leave_critical_section(flags);
+  return ndx;
 }
 
 /****************************************************************************
- * Name: noteram_next
+ * Name: noteram_after
  *
  * Description:
- *   Return the circular buffer index at offset from the specified index
- *   value, handling wraparound
- *
- * Input Parameters:
- *   ndx - Old circular buffer index
- *
- * Returned Value:
- *   New circular buffer index
+ *   Return true if the circular buffer index 'ndx' is not before 'tail',
+ *   that is, if the data at 'ndx' has not been overwritten yet.
  *
  ****************************************************************************/
 
-static inline unsigned int noteram_next(unsigned int ndx,
-                                        unsigned int offset)
+static inline bool noteram_after(unsigned int ndx, unsigned int tail)
 {
-  ndx += offset;
-  if (ndx >= CONFIG_DRIVER_NOTERAM_BUFSIZE)
+  if (ndx < tail)
     {
-      ndx -= CONFIG_DRIVER_NOTERAM_BUFSIZE;
+      ndx += NOTERAM_WRAP;
     }
 
-  return ndx;
+  return ndx - tail <= CONFIG_DRIVER_NOTERAM_BUFSIZE;
 }
 
 /****************************************************************************
  * Name: noteram_length
  *
  * Description:
- *   Length of data currently in circular buffer.
+ *   Length of data between two circular buffer indices.
  *
- * Input Parameters:
- *   None
+ ****************************************************************************/
+
+static inline unsigned int noteram_length(unsigned int head,
+                                          unsigned int tail)
+{
+  if (tail > head)
+    {
+      head += NOTERAM_WRAP;
+    }
+
+  return head - tail;
+}
+
+/****************************************************************************
+ * Name: noteram_copyin and noteram_copyout
  *
- * Returned Value:
- *   Length of data currently in circular buffer.
+ * Description:
+ *   Copy data to and from the circular buffer at an index.
  *
  ****************************************************************************/
 
-static unsigned int noteram_length(void)
+static void noteram_copyin(FAR struct noteram_info_s *info,
+                           unsigned int ndx, FAR const void *src,
+                           size_t len)
 {
-  unsigned int head = g_noteram_info.ni_head;
-  unsigned int tail = g_noteram_info.ni_tail;
+  size_t off = ndx % CONFIG_DRIVER_NOTERAM_BUFSIZE;
+  size_t n   = CONFIG_DRIVER_NOTERAM_BUFSIZE - off;
 
-  if (tail > head)
+  if (n > len)
     {
-      head += CONFIG_DRIVER_NOTERAM_BUFSIZE;
+      n = len;
     }
 
-  return head - tail;
+  memcpy(&info->ni_buffer[off], src, n);
+  memcpy(info->ni_buffer, (FAR const uint8_t *)src + n, len - n);
+}
+
+static void noteram_copyout(FAR struct noteram_info_s *info,
+                            unsigned int ndx, FAR void *dst, size_t len)
+{
+  size_t off = ndx % CONFIG_DRIVER_NOTERAM_BUFSIZE;
+  size_t n   = CONFIG_DRIVER_NOTERAM_BUFSIZE - off;
+
+  if (n > len)
+    {
+      n = len;
+    }
+
+  memcpy(dst, &info->ni_buffer[off], n);
+  memcpy((FAR uint8_t *)dst + n, info->ni_buffer, len - n);
 }
 
 /****************************************************************************
- * Name: noteram_unread_length
+ * Name: noteram_buffer_clear
  *
  * Description:
- *   Length of unread data currently in circular buffer.
+ *   Clear all contents of the circular buffer.
  *
  * Input Parameters:
- *   None
+ *   None.
  *
  * Returned Value:
- *   Length of unread data currently in circular buffer.
+ *   None.
  *
  ****************************************************************************/
 
-static unsigned int noteram_unread_length(void)
+static void noteram_buffer_clear(void)
 {
-  unsigned int head = g_noteram_info.ni_head;
-  unsigned int read = g_noteram_info.ni_read;
+  FAR struct noteram_info_s *info;
+  irqstate_t flags;
+#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
+  irqstate_t irq_mask;
+#endif
+  unsigned int head;
+  unsigned int tail;
+  int cpu;
 
-  if (read > head)
+  flags = enter_critical_section();
+
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
     {
-      head += CONFIG_DRIVER_NOTERAM_BUFSIZE;
+      /* The CPU that owns the buffer may be removing notes from the tail
+       * at the same time.
+       */
+
+      info = &g_noteram_info[cpu];
+      tail = __atomic_load_n(&info->ni_tail, __ATOMIC_RELAXED);
+      do
+        {
+          head = __atomic_load_n(&info->ni_head, __ATOMIC_ACQUIRE);
+        }
+      while (!__atomic_compare_exchange_n(&info->ni_tail, &tail, head,
+                                          false, __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
+
+      info->ni_read = head;
     }
 
-  return head - read;
+  if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+    {
+      g_noteram_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+    }
+
+#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
+  irq_mask = noteram_taskname_lock();
+  g_noteram_taskname.buffer_used = 0;
+  noteram_taskname_unlock(irq_mask);
+#endif
+
+  leave_critical_section(flags);
 }
 
 /****************************************************************************
@@ -400,71 +502,215 @@ static unsigned int noteram_unread_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer of this CPU
+ *   tail - The tail index of the circular buffer
  *
  * Returned Value:
- *   None
+ *   The new tail index of the circular buffer.
  *
  * Assumptions:
- *   We are within a critical section.
+ *   Interrupts are disabled.
  *
  ****************************************************************************/
 
-static void noteram_remove(void)
+static unsigned int noteram_remove(FAR struct noteram_info_s *info,
+                                   unsigned int tail)
 {
-  unsigned int tail;
-  unsigned int length;
+  struct note_common_s note;
+  unsigned int next;
 
-  /* Get the tail index of the circular buffer */
+  /* Get the note at the tail index */
 
-  tail = g_noteram_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_DRIVER_NOTERAM_BUFSIZE);
+  noteram_copyout(info, tail, &note, sizeof(note));
+  DEBUGASSERT(note.nc_length <= noteram_length(info->ni_head, tail));
 
-  /* Get the length of the note at the tail index */
+  /* Increment the tail index to remove the entire note from the circular
+   * buffer, unless the buffer has just been cleared.
+   */
 
-  length = g_noteram_info.ni_buffer[tail];
-  DEBUGASSERT(length <= noteram_length());
+  next = noteram_next(tail, note.nc_length);
+  if (!__atomic_compare_exchange_n(&info->ni_tail, &tail, next, false,
+                                   __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+      return tail;
+    }
+
+  /* Count the note if it is lost before it was read */
+
+  if (noteram_after(tail, info->ni_read))
+    {
+      info->ni_overrun++;
+    }
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
-  if (g_noteram_info.ni_buffer[noteram_next(tail, 1)] == NOTE_STOP)
+  if (note.nc_type == NOTE_STOP)
     {
-      uint8_t nc_pid[2];
+      irqstate_t flags;
 
       /* The name of the task is no longer needed because the task is deleted
        * and the corresponding notes are lost.
        */
 
+      flags = noteram_taskname_lock();
+      noteram_remove_taskname(note.nc_pid[0] + (note.nc_pid[1] << 8));
+      noteram_taskname_unlock(flags);
+    }
+#endif
+
+  return next;
+}
+
+/****************************************************************************
+ * Name: noteram_before
+ *
+ * Description:
+ *   Return true if the first note was buffered before the second one.
+ *
+ ****************************************************************************/
+
 #ifdef CONFIG_SMP
-      nc_pid[0] = g_noteram_info.ni_buffer[noteram_next(tail, 4)];
-      nc_pid[1] = g_noteram_info.ni_buffer[noteram_next(tail, 5)];
+static void noteram_unflatten(FAR void *dst, FAR const uint8_t *src,
+                              size_t len)
+{
+#ifdef CONFIG_ENDIAN_BIG
+  FAR uint8_t *end = (FAR uint8_t *)dst + len - 1;
+  while (len-- > 0)
+    {
+      *end-- = *src++;
+    }
 #else
-      nc_pid[0] = g_noteram_info.ni_buffer[noteram_next(tail, 3)];
-      nc_pid[1] = g_noteram_info.ni_buffer[noteram_next(tail, 4)];
+  memcpy(dst, src, len);
 #endif
+}
 
-      noteram_remove_taskname(nc_pid[0] + (nc_pid[1] << 8));
-    }
+static bool noteram_before(FAR const struct note_common_s *note1,
+                           FAR const struct note_common_s *note2)
+{
+#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+  time_t sec1;
+  time_t sec2;
+  long nsec1;
+  long nsec2;
+
+  noteram_unflatten(&sec1, note1->nc_systime_sec, sizeof(sec1));
+  noteram_unflatten(&sec2, note2->nc_systime_sec, sizeof(sec2));
+  noteram_unflatten(&nsec1, note1->nc_systime_nsec, sizeof(nsec1));
+  noteram_unflatten(&nsec2, note2->nc_systime_nsec, sizeof(nsec2));
+
+  return sec1 < sec2 || (sec1 == sec2 && nsec1 < nsec2);
+#else
+  clock_t systime1;
+  clock_t systime2;
+
+  noteram_unflatten(&systime1, note1->nc_systime, sizeof(systime1));
+  noteram_unflatten(&systime2, note2->nc_systime, sizeof(systime2));
+
+  return (sclock_t)(systime1 - systime2) < 0;
+#endif
+}
 #endif
 
-  /* Increment the tail index to remove the entire note from the circular
-   * buffer.
-   */
+/****************************************************************************
+ * Name: noteram_peek
+ *
+ * Description:
+ *   Get the common part of the next note from the read index of a circular
+ *   buffer.  Notes that were overwritten before they were read are skipped.
+ *
+ * Input Parameters:
+ *   info - The circular buffer
+ *   note - Location to return the common part of the note
+ *
+ * Returned Value:
+ *   False if the circular buffer is empty.
+ *
+ ****************************************************************************/
+
+static bool noteram_peek(FAR struct noteram_info_s *info,
+                         FAR struct note_common_s *note)
+{
+  unsigned int head;
+  unsigned int tail;
+  unsigned int read;
 
-  if (g_noteram_info.ni_read == g_noteram_info.ni_tail)
+  for (; ; )
     {
-      /* The read index also needs increment. */
+      tail = __atomic_load_n(&info->ni_tail, __ATOMIC_ACQUIRE);
+      head = __atomic_load_n(&info->ni_head, __ATOMIC_ACQUIRE);
+      read = info->ni_read;
+
+      if (!noteram_after(read, tail))
+        {
+          read = tail;
+          info->ni_read = read;
+        }
+
+      if (read == head)
+        {
+          return false;
+        }
 
-      g_noteram_info.ni_read = noteram_next(tail, length);
+      /* The note is valid if the tail has not moved past it while it was
+       * copied.
+       */
+
+      noteram_copyout(info, read, note, sizeof(*note));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+      tail = __atomic_load_n(&info->ni_tail, __ATOMIC_RELAXED);
+      if (noteram_after(read, tail))
+        {
+          DEBUGASSERT(note->nc_length >= sizeof(*note) &&
+                      note->nc_length <= noteram_length(head, read));
+          return true;
+        }
     }
+}
 
-  g_noteram_info.ni_tail = noteram_next(tail, length);
+/****************************************************************************
+ * Name: noteram_oldest
+ *
+ * Description:
+ *   Find the circular buffer with the oldest unread note.
+ *
+ * Input Parameters:
+ *   note - Location to return the common part of the note
+ *
+ * Returned Value:
+ *   The circular buffer, or NULL if all circular buffers are empty.
+ *
+ ****************************************************************************/
+
+static FAR struct noteram_info_s *
+noteram_oldest(FAR struct note_common_s *note)
+{
+#ifdef CONFIG_SMP
+  FAR struct noteram_info_s *oldest = NULL;
+  struct note_common_s next;
+  int cpu;
+
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+    {
+      if (noteram_peek(&g_noteram_info[cpu], &next) &&
+          (oldest == NULL || noteram_before(&next, note)))
+        {
+          oldest = &g_noteram_info[cpu];
+          *note  = next;
+        }
+    }
+
+  return oldest;
+#else
+  return noteram_peek(&g_noteram_info[0], note) ? &g_noteram_info[0] : NULL;
+#endif
 }
 
 /****************************************************************************
  * Name: noteram_get
  *
  * Description:
- *   Get the next note from the read index of the circular buffer.
+ *   Get the next note from the read index of the circular buffers, in the
+ *   order in which the notes were buffered.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
@@ -479,68 +725,59 @@ static void noteram_remove(void)
 
 static ssize_t noteram_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
+  FAR struct noteram_info_s *info;
+  struct note_common_s note;
   irqstate_t flags;
-  unsigned int remaining;
   unsigned int read;
+  unsigned int tail;
   ssize_t notelen;
-  size_t circlen;
 
   DEBUGASSERT(buffer != NULL);
   flags = enter_critical_section();
 
-  /* Verify that the circular buffer is not empty */
-
-  circlen = noteram_unread_length();
-  if (circlen <= 0)
+  for (; ; )
     {
-      notelen = 0;
-      goto errout_with_csection;
-    }
-
-  /* Get the read index of the circular buffer */
+      /* Verify that the circular buffers are not empty */
 
-  read    = g_noteram_info.ni_read;
-  DEBUGASSERT(read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-
-  /* Get the length of the note at the read index */
-
-  note    = (FAR struct note_common_s *)&g_noteram_info.ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-  /* Is the user buffer large enough to hold the note? */
+      info = noteram_oldest(&note);
+      if (info == NULL)
+        {
+          notelen = 0;
+          break;
+        }
 
-  if (buflen < notelen)
-    {
-      /* Skip the large note so that we do not get constipated. */
+      read    = info->ni_read;
+      notelen = note.nc_length;
 
-      g_noteram_info.ni_read = noteram_next(read, notelen);
+      /* Is the user buffer large enough to hold the note? */
 
-      /* and return an error */
+      if (buflen < notelen)
+        {
+          /* Skip the large note so that we do not get constipated. */
 
-      notelen = -EFBIG;
-      goto errout_with_csection;
-    }
+          info->ni_read = noteram_next(read, notelen);
 
-  /* Loop until the note has been transferred to the user buffer */
+          /* and return an error */
 
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the read index */
+          notelen = -EFBIG;
+          break;
+        }
 
-      *buffer++ = g_noteram_info.ni_buffer[read];
+      /* Transfer the note to the user buffer.  Try again if the note has
+       * been overwritten in the meantime.
+       */
 
-      /* Adjust indices and counts */
+      noteram_copyout(info, read, buffer, notelen);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
 
-      read = noteram_next(read, 1);
-      remaining--;
+      tail = __atomic_load_n(&info->ni_tail, __ATOMIC_RELAXED);
+      if (noteram_after(read, tail))
+        {
+          info->ni_read = noteram_next(read, notelen);
+          break;
+        }
     }
 
-  g_noteram_info.ni_read = read;
-
-errout_with_csection:
   leave_critical_section(flags);
   return notelen;
 }
@@ -550,7 +787,7 @@ errout_with_csection:
  *
  * Description:
  *   Return the size of the next note at the read index of the circular
- *   buffer.
+ *   buffers.
  *
  * Input Parameters:
  *   None.
@@ -563,35 +800,17 @@ errout_with_csection:
 
 static ssize_t noteram_size(void)
 {
-  FAR struct note_common_s *note;
+  struct note_common_s note;
   irqstate_t flags;
-  unsigned int read;
-  ssize_t notelen;
-  size_t circlen;
+  ssize_t notelen = 0;
 
   flags = enter_critical_section();
 
-  /* Verify that the circular buffer is not empty */
-
-  circlen = noteram_unread_length();
-  if (circlen <= 0)
+  if (noteram_oldest(&note) != NULL)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      notelen = note.nc_length;
     }
 
-  /* Get the read index of the circular buffer */
-
-  read = g_noteram_info.ni_read;
-  DEBUGASSERT(read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-
-  /* Get the length of the note at the read index */
-
-  note    = (FAR struct note_common_s *)&g_noteram_info.ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-errout_with_csection:
   leave_critical_section(flags);
   return notelen;
 }
@@ -602,9 +821,14 @@ errout_with_csection:
 
 static int noteram_open(FAR struct file *filep)
 {
-  /* Reset the read index of the circular buffer */
+  int cpu;
+
+  /* Reset the read index of the circular buffers */
 
-  g_noteram_info.ni_read = g_noteram_info.ni_tail;
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+    {
+      g_noteram_info[cpu].ni_read = g_noteram_info[cpu].ni_tail;
+    }
 
   return OK;
 }
@@ -703,7 +927,7 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
           }
         else
           {
-            *(unsigned int *)arg = g_noteram_info.ni_overwrite;
+            *(unsigned int *)arg = g_noteram_overwrite;
             ret = OK;
           }
         break;
@@ -720,7 +944,32 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
           }
         else
           {
-            g_noteram_info.ni_overwrite = *(unsigned int *)arg;
+            g_noteram_overwrite = *(unsigned int *)arg;
+            ret = OK;
+          }
+        break;
+
+      /* NOTERAM_GETOVERRUN
+       *      - Get the number of notes lost before they were read
+       *        Argument: A writable pointer to unsigned int
+       */
+
+      case NOTERAM_GETOVERRUN:
+        if (arg == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            unsigned int overrun = 0;
+            int cpu;
+
+            for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+              {
+                overrun += g_noteram_info[cpu].ni_overrun;
+              }
+
+            *(unsigned int *)arg = overrun;
             ret = OK;
           }
         break;
@@ -792,21 +1041,23 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
 
 void sched_note_add(FAR const void *note, size_t notelen)
 {
-  FAR const char *buf = note;
+  FAR struct noteram_info_s *info;
   unsigned int head;
-  unsigned int next;
+  unsigned int tail;
   irqstate_t flags;
 
+  DEBUGASSERT(note != NULL && notelen < CONFIG_DRIVER_NOTERAM_BUFSIZE);
+
+  /* Each CPU has its own circular buffer, only the reader may access it
+   * concurrently.
+   */
+
   flags = up_irq_save();
-#ifdef CONFIG_SMP
-  spin_lock_wo_note(&g_noteram_lock);
-#endif
+  info  = &g_noteram_info[up_cpu_index()];
 
-  if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-#ifdef CONFIG_SMP
-      spin_unlock_wo_note(&g_noteram_lock);
-#endif
+      info->ni_overrun++;
       up_irq_restore(flags);
       return;
     }
@@ -816,64 +1067,50 @@ void sched_note_add(FAR const void *note, size_t notelen)
 
     {
       FAR struct note_start_s *note_st;
+      irqstate_t irq_mask;
 
       note_st = (FAR struct note_start_s *)note;
       if (note_st->nst_cmn.nc_type == NOTE_START)
         {
+          irq_mask = noteram_taskname_lock();
           noteram_record_taskname(note_st->nst_cmn.nc_pid[0] +
                                   (note_st->nst_cmn.nc_pid[1] << 8),
                                   note_st->nst_name);
+          noteram_taskname_unlock(irq_mask);
         }
     }
 #endif
 
-  /* Get the index to the head of the circular buffer */
+  /* Remove notes from the tail until the new note fits */
 
-  DEBUGASSERT(note != NULL && notelen < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-  head = g_noteram_info.ni_head;
-
-  /* Loop until all bytes have been transferred to the circular buffer */
+  head = info->ni_head;
+  tail = __atomic_load_n(&info->ni_tail, __ATOMIC_RELAXED);
 
-  while (notelen > 0)
+  while (noteram_length(head, tail) + notelen >
+         CONFIG_DRIVER_NOTERAM_BUFSIZE)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
-
-      next = noteram_next(head, 1);
-      if (next == g_noteram_info.ni_tail)
+      if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
         {
-          if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
-            {
-              /* Stop recording if not in overwrite mode */
+          /* Stop recording if not in overwrite mode */
 
-              g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
-
-#ifdef CONFIG_SMP
-              spin_unlock_wo_note(&g_noteram_lock);
-#endif
-              up_irq_restore(flags);
-              return;
-            }
-
-          /* Yes, then remove the note at the tail index */
-
-          noteram_remove();
+          g_noteram_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+          info->ni_overrun++;
+          up_irq_restore(flags);
+          return;
         }
 
-      /* Save the next byte at the head index */
-
-      g_noteram_info.ni_buffer[head] = *buf++;
-
-      head = next;
-      notelen--;
+      tail = noteram_remove(info, tail);
     }
 
-  g_noteram_info.ni_head = head;
+  /* The reader must see the new tail before the removed notes are
+   * overwritten, and the note before the new head.
+   */
+
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  noteram_copyin(info, head, note, notelen);
+  __atomic_store_n(&info->ni_head, noteram_next(head, notelen),
+                   __ATOMIC_RELEASE);
 
-#ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_noteram_lock);
-#endif
   up_irq_restore(flags);
 }
 
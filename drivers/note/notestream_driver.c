@@ -0,0 +1,350 @@
+/****************************************************************************
+ * drivers/note/notestream_driver.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <syslog.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/kthread.h>
+#include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/note/notestream_driver.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NOTESTREAM_INTERVAL \
+  (CONFIG_DRIVER_NOTESTREAM_INTERVAL * USEC_PER_MSEC)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct notestream_buffer_s
+{
+  size_t nb_used;
+  uint8_t nb_data[CONFIG_DRIVER_NOTESTREAM_BUFSIZE];
+};
+
+/* The notes are added to the active buffer while the writer thread writes
+ * the other one out.
+ */
+
+struct notestream_info_s
+{
+  struct notestream_buffer_s ns_buffer[2];
+  unsigned int ns_active;          /* Index of the buffer being filled */
+  unsigned int ns_dropped;         /* Notes dropped since the last swap */
+#ifdef CONFIG_SMP
+  spinlock_t ns_lock;              /* Serializes the CPUs */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct notestream_info_s g_notestream;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: notestream_lock and notestream_unlock
+ ****************************************************************************/
+
+static irqstate_t notestream_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_notestream.ns_lock);
+#endif
+  return flags;
+}
+
+static void notestream_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_notestream.ns_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: notestream_swap
+ *
+ * Description:
+ *   Make the other buffer the active one.
+ *
+ * Input Parameters:
+ *   dropped - Location to return the number of notes that were dropped
+ *             because the active buffer was full.
+ *
+ * Returned Value:
+ *   The buffer that was active until now.
+ *
+ ****************************************************************************/
+
+static FAR struct notestream_buffer_s *
+notestream_swap(FAR unsigned int *dropped)
+{
+  FAR struct notestream_buffer_s *buffer;
+  irqstate_t flags;
+
+  flags = notestream_lock();
+
+  buffer = &g_notestream.ns_buffer[g_notestream.ns_active];
+  g_notestream.ns_active ^= 1;
+
+  *dropped = g_notestream.ns_dropped;
+  g_notestream.ns_dropped = 0;
+
+  notestream_unlock(flags);
+  return buffer;
+}
+
+/****************************************************************************
+ * Name: notestream_write
+ *
+ * Description:
+ *   Write all of a buffer to the stream.
+ *
+ ****************************************************************************/
+
+static int notestream_write(FAR struct file *filep,
+                            FAR const void *buffer, size_t buflen)
+{
+  FAR const uint8_t *ptr = buffer;
+  ssize_t nwritten;
+
+  while (buflen > 0)
+    {
+      nwritten = file_write(filep, ptr, buflen);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          return nwritten;
+        }
+
+      ptr    += nwritten;
+      buflen -= nwritten;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: notestream_open
+ *
+ * Description:
+ *   Open the stream and write the header that describes the notes.  Retry
+ *   until the stream can be opened, the file system or the reader may not
+ *   be there yet.
+ *
+ ****************************************************************************/
+
+static void notestream_open(FAR struct file *filep)
+{
+  struct notestream_header_s header;
+  uint32_t usecpertick = USEC_PER_TICK;
+  int ret;
+
+  memcpy(header.nsh_magic, NOTESTREAM_MAGIC, sizeof(header.nsh_magic));
+  header.nsh_version = NOTESTREAM_VERSION;
+  header.nsh_flags   = 0;
+#ifdef CONFIG_SMP
+  header.nsh_flags  |= NOTESTREAM_FLAG_SMP;
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+  header.nsh_flags  |= NOTESTREAM_FLAG_HIRES;
+  header.nsh_timesize[0] = sizeof(time_t);
+  header.nsh_timesize[1] = sizeof(long);
+#else
+  header.nsh_timesize[0] = sizeof(clock_t);
+  header.nsh_timesize[1] = 0;
+#endif
+  header.nsh_pidsize = sizeof(pid_t);
+  header.nsh_ptrsize = sizeof(uintptr_t);
+  header.nsh_usecpertick[0] = usecpertick & 0xff;
+  header.nsh_usecpertick[1] = (usecpertick >> 8) & 0xff;
+  header.nsh_usecpertick[2] = (usecpertick >> 16) & 0xff;
+  header.nsh_usecpertick[3] = (usecpertick >> 24) & 0xff;
+
+  for (; ; )
+    {
+      ret = file_open(filep, CONFIG_DRIVER_NOTESTREAM_PATH,
+                      O_WRONLY | O_CREAT | O_TRUNC, 0666);
+      if (ret >= 0)
+        {
+          ret = notestream_write(filep, &header, sizeof(header));
+          if (ret >= 0)
+            {
+              return;
+            }
+
+          file_close(filep);
+        }
+
+      nxsig_usleep(NOTESTREAM_INTERVAL);
+    }
+}
+
+/****************************************************************************
+ * Name: notestream_thread
+ *
+ * Description:
+ *   Write the notes out, one buffer every CONFIG_DRIVER_NOTESTREAM_INTERVAL
+ *   milliseconds.
+ *
+ ****************************************************************************/
+
+static int notestream_thread(int argc, FAR char *argv[])
+{
+  FAR struct notestream_buffer_s *buffer;
+  struct file file;
+  unsigned int dropped;
+  int ret;
+
+  notestream_open(&file);
+
+  for (; ; )
+    {
+      nxsig_usleep(NOTESTREAM_INTERVAL);
+
+      /* The buffer that is written out now is not touched by the CPUs
+       * until the next swap.
+       */
+
+      buffer = notestream_swap(&dropped);
+      if (dropped > 0)
+        {
+          syslog(LOG_WARNING, "notestream: %u notes dropped\n", dropped);
+        }
+
+      if (buffer->nb_used > 0)
+        {
+          ret = notestream_write(&file, buffer->nb_data, buffer->nb_used);
+          buffer->nb_used = 0;
+
+          if (ret < 0)
+            {
+              /* Start a new stream, the reader of a pipe may be gone */
+
+              file_close(&file);
+              notestream_open(&file);
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_note_add
+ *
+ * Description:
+ *   Add the variable length note to the active buffer.  The note is
+ *   dropped if the buffer is full.
+ *
+ * Input Parameters:
+ *   note    - The note buffer
+ *   notelen - The buffer length
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_note_add(FAR const void *note, size_t notelen)
+{
+  FAR struct notestream_buffer_s *buffer;
+  irqstate_t flags;
+
+  DEBUGASSERT(note != NULL);
+
+  flags  = notestream_lock();
+  buffer = &g_notestream.ns_buffer[g_notestream.ns_active];
+
+  if (buffer->nb_used + notelen <= CONFIG_DRIVER_NOTESTREAM_BUFSIZE)
+    {
+      memcpy(&buffer->nb_data[buffer->nb_used], note, notelen);
+      buffer->nb_used += notelen;
+    }
+  else
+    {
+      g_notestream.ns_dropped++;
+    }
+
+  notestream_unlock(flags);
+}
+
+/****************************************************************************
+ * Name: notestream_initialize
+ *
+ * Description:
+ *   Start the thread that streams the notes to
+ *   CONFIG_DRIVER_NOTESTREAM_PATH.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero on success. A negated errno value is returned on a failure.
+ *
+ ****************************************************************************/
+
+int notestream_initialize(void)
+{
+  int pid;
+
+#ifdef CONFIG_SMP
+  spin_initialize(&g_notestream.ns_lock, SP_UNLOCKED);
+#endif
+
+  pid = kthread_create("notestream", CONFIG_DRIVER_NOTESTREAM_PRIORITY,
+                       CONFIG_DRIVER_NOTESTREAM_STACKSIZE,
+                       notestream_thread, NULL);
+  return pid < 0 ? pid : OK;
+}
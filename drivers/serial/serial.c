@@ -87,12 +87,21 @@ static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch,
                                 bool oktoblock);
+static size_t  uart_putxmitbuf(FAR uart_dev_t *dev,
+                               FAR const char *buffer, size_t buflen);
+static size_t  uart_xmitrun(FAR uart_dev_t *dev,
+                            FAR const char *buffer, size_t buflen);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev,
                                     FAR const char *buffer,
                                     size_t buflen);
 static int     uart_tcdrain(FAR uart_dev_t *dev,
                             bool cancelable, clock_t timeout);
 
+/* Read support */
+
+static size_t  uart_getrecvbuf(FAR uart_dev_t *dev,
+                               FAR char *buffer, size_t buflen);
+
 /* Character driver methods */
 
 static int     uart_open(FAR struct file *filep);
@@ -185,15 +194,8 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 #endif
           if (fds->revents != 0)
             {
-              int semcount;
-
               finfo("Report events: %08" PRIx32 "\n", fds->revents);
-
-              nxsem_get_value(fds->sem, &semcount);
-              if (semcount < 1)
-                {
-                  nxsem_post(fds->sem);
-                }
+              poll_notify(fds);
             }
         }
     }
@@ -339,6 +341,168 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
   return OK;
 }
 
+/****************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy as much of the buffer as fits into the TX buffer, without
+ *   blocking.  Returns the number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t uart_putxmitbuf(FAR uart_dev_t *dev,
+                              FAR const char *buffer, size_t buflen)
+{
+  FAR struct uart_buffer_s *txbuf = &dev->xmit;
+  size_t nwritten = 0;
+  size_t nspace;
+  int16_t head = txbuf->head;
+  int16_t tail;
+
+  /* At most two copies: up to the end of the buffer, then from its start.
+   * One slot is always left empty so that a full buffer can be told from
+   * an empty one.
+   */
+
+  while (nwritten < buflen)
+    {
+      tail = txbuf->tail;
+      if (head >= tail)
+        {
+          nspace = txbuf->size - head - (tail == 0 ? 1 : 0);
+        }
+      else
+        {
+          nspace = tail - head - 1;
+        }
+
+      if (nspace == 0)
+        {
+          break;
+        }
+
+      if (nspace > buflen - nwritten)
+        {
+          nspace = buflen - nwritten;
+        }
+
+      memcpy(&txbuf->buffer[head], &buffer[nwritten], nspace);
+      nwritten += nspace;
+
+      head += nspace;
+      if (head >= txbuf->size)
+        {
+          head = 0;
+        }
+
+      txbuf->head = head;
+    }
+
+  return nwritten;
+}
+
+/****************************************************************************
+ * Name: uart_xmitrun
+ *
+ * Description:
+ *   Return the number of bytes at the start of the buffer that need no
+ *   output processing and can be copied to the TX buffer as they are.
+ *
+ ****************************************************************************/
+
+static size_t uart_xmitrun(FAR uart_dev_t *dev,
+                           FAR const char *buffer, size_t buflen)
+{
+  size_t i;
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  bool crnl = (dev->tc_oflag & OCRNL) != 0;
+  bool nlcr = (dev->tc_oflag & (ONLCR | ONLRET)) != 0;
+
+  if ((dev->tc_oflag & OPOST) == 0 || (!crnl && !nlcr))
+    {
+      return buflen;
+    }
+
+  for (i = 0; i < buflen; i++)
+    {
+      if ((crnl && buffer[i] == '\r') || (nlcr && buffer[i] == '\n'))
+        {
+          break;
+        }
+    }
+#else
+  if (!dev->isconsole)
+    {
+      return buflen;
+    }
+
+  for (i = 0; i < buflen && buffer[i] != '\n'; i++)
+    {
+    }
+#endif
+
+  return i;
+}
+
+/****************************************************************************
+ * Name: uart_getrecvbuf
+ *
+ * Description:
+ *   Copy up to buflen bytes from the RX buffer, without blocking.  Returns
+ *   the number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t uart_getrecvbuf(FAR uart_dev_t *dev,
+                              FAR char *buffer, size_t buflen)
+{
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  size_t nread = 0;
+  size_t navail;
+  int16_t tail = rxbuf->tail;
+  int16_t head;
+
+  /* At most two copies: up to the end of the buffer, then from its start.
+   * The tail index is only modified here, once per copy.
+   */
+
+  while (nread < buflen)
+    {
+      head = rxbuf->head;
+      if (head == tail)
+        {
+          break;
+        }
+      else if (head > tail)
+        {
+          navail = head - tail;
+        }
+      else
+        {
+          navail = rxbuf->size - tail;
+        }
+
+      if (navail > buflen - nread)
+        {
+          navail = buflen - nread;
+        }
+
+      memcpy(&buffer[nread], &rxbuf->buffer[tail], navail);
+      nread += navail;
+
+      tail += navail;
+      if (tail >= rxbuf->size)
+        {
+          tail = 0;
+        }
+
+      rxbuf->tail = tail;
+    }
+
+  return nread;
+}
+
 /****************************************************************************
  * Name: uart_putc
  ****************************************************************************/
@@ -743,8 +907,11 @@ static ssize_t uart_read(FAR struct file *filep,
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
+  size_t nbulk;
   int16_t tail;
+#ifdef CONFIG_SERIAL_TERMIOS
   char ch;
+#endif
   int ret;
 
   /* Only one user can access rxbuf->tail at a time */
@@ -797,6 +964,19 @@ static ssize_t uart_read(FAR struct file *filep,
       tail = rxbuf->tail;
       if (rxbuf->head != tail)
         {
+#ifdef CONFIG_SERIAL_TERMIOS
+          if ((dev->tc_iflag & (INLCR | IGNCR | ICRNL)) == 0)
+#endif
+            {
+              /* No input processing, copy all that is buffered at once */
+
+              nbulk   = uart_getrecvbuf(dev, buffer, buflen - recvd);
+              buffer += nbulk;
+              recvd  += nbulk;
+              continue;
+            }
+
+#ifdef CONFIG_SERIAL_TERMIOS
           /* Take the next character from the tail of the buffer */
 
           ch = rxbuf->buffer[tail];
@@ -813,28 +993,24 @@ static ssize_t uart_read(FAR struct file *filep,
 
           rxbuf->tail = tail;
 
-#ifdef CONFIG_SERIAL_TERMIOS
-          /* Do input processing if any is enabled */
+          /* Do input processing */
 
-          if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
-            {
-              /* \n -> \r or \r -> \n translation? */
+          /* \n -> \r or \r -> \n translation? */
 
-              if ((ch == '\n') && (dev->tc_iflag & INLCR))
-                {
-                  ch = '\r';
-                }
-              else if ((ch == '\r') && (dev->tc_iflag & ICRNL))
-                {
-                  ch = '\n';
-                }
+          if ((ch == '\n') && (dev->tc_iflag & INLCR))
+            {
+              ch = '\r';
+            }
+          else if ((ch == '\r') && (dev->tc_iflag & ICRNL))
+            {
+              ch = '\n';
+            }
 
-              /* Discarding \r ? */
+          /* Discarding \r ? */
 
-              if ((ch == '\r') & (dev->tc_iflag & IGNCR))
-                {
-                  continue;
-                }
+          if ((ch == '\r') & (dev->tc_iflag & IGNCR))
+            {
+              continue;
             }
 
           /* Specifically not handled:
@@ -845,12 +1021,12 @@ static ssize_t uart_read(FAR struct file *filep,
            * IUCLC - Not Posix
            * IXON/OXOFF - no xon/xoff flow control.
            */
-#endif
 
           /* Store the received character */
 
           *buffer++ = ch;
           recvd++;
+#endif
         }
 
 #ifdef CONFIG_DEV_SERIAL_FULLBLOCKS
@@ -1098,6 +1274,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct inode *inode    = filep->f_inode;
   FAR uart_dev_t   *dev      = inode->i_private;
   ssize_t           nwritten = buflen;
+  size_t            nbulk;
   bool              oktoblock;
   int               ret;
   char              ch;
@@ -1168,8 +1345,28 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
    */
 
   uart_disabletxint(dev);
-  for (; buflen; buflen--)
+  while (buflen > 0)
     {
+      /* Copy the bytes that need no output processing in bulk, as long as
+       * there is space for them in the TX buffer.
+       */
+
+      nbulk = uart_xmitrun(dev, buffer, buflen);
+      if (nbulk > 0)
+        {
+          nbulk = uart_putxmitbuf(dev, buffer, nbulk);
+          if (nbulk > 0)
+            {
+              buffer += nbulk;
+              buflen -= nbulk;
+              continue;
+            }
+        }
+
+      /* Otherwise, put the next character alone, waiting for space in the
+       * TX buffer if it is full.
+       */
+
       ch  = *buffer++;
       ret = OK;
 
@@ -1253,6 +1450,8 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
 
           break;
         }
+
+      buflen--;
     }
 
   if (dev->xmit.head != dev->xmit.tail)
@@ -354,4 +354,35 @@ void uart_recvchars_done(FAR uart_dev_t *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: uart_recvchars_idle
+ *
+ * Description:
+ *   Hand the bytes received so far by an RX DMA transfer to the readers and
+ *   start a new transfer into the rest of the RX circular buffer.
+ *
+ *   The lower half calls this when the RX line goes idle or when its RX
+ *   timeout expires, after stopping the transfer in progress.  Readers are
+ *   then woken once per burst rather than once per byte, and a burst
+ *   shorter than the transfer is not held back until more data arrives.
+ *
+ * Input Parameters:
+ *   dev    - The serial device
+ *   nbytes - The number of bytes received by the stopped transfer
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_idle(FAR uart_dev_t *dev, size_t nbytes)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+
+  DEBUGASSERT(nbytes <= xfer->length + xfer->nlength);
+
+  xfer->nbytes = nbytes;
+  uart_recvchars_done(dev);
+  uart_recvchars_dma(dev);
+}
+#endif
+
 #endif /* CONFIG_SERIAL_TXDMA || CONFIG_SERIAL_RXDMA */
@@ -102,15 +102,23 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp)
       if (ret < 0)
         {
           aioc_free(aioc);
-          goto errout;
+          goto errout_with_filep;
         }
 
       dq_addlast(&aioc->aioc_link, &g_aio_pending);
       aio_unlock();
     }
 
+  /* The transfer runs on a worker thread that has no file list to release
+   * a reference from, so the container keeps the file without one.
+   */
+
+  fs_putfilep(filep);
   return aioc;
 
+errout_with_filep:
+  fs_putfilep(filep);
+
 errout:
   set_errno(-ret);
   return NULL;
@@ -35,6 +35,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
@@ -59,11 +60,19 @@ static int _files_semtake(FAR struct filelist *list)
 
 /****************************************************************************
  * Name: files_extend
+ *
+ * Description:
+ *   Grow the file list to the given number of rows.  The caller holds the
+ *   list semaphore.  The rows are published under the list spinlock since
+ *   fs_getfilep() looks them up without the semaphore.
+ *
  ****************************************************************************/
 
 static int files_extend(FAR struct filelist *list, size_t row)
 {
+  FAR struct file **files;
   FAR struct file **tmp;
+  irqstate_t flags;
   int i;
 
   if (row <= list->fl_rows)
@@ -76,13 +85,22 @@ static int files_extend(FAR struct filelist *list, size_t row)
       return -EMFILE;
     }
 
-  tmp = kmm_realloc(list->fl_files, sizeof(FAR struct file *) * row);
+  /* The old row array cannot be reallocated in place, a lookup may be
+   * indexing it.
+   */
+
+  tmp = kmm_malloc(sizeof(FAR struct file *) * row);
   DEBUGASSERT(tmp);
   if (tmp == NULL)
     {
       return -ENFILE;
     }
 
+  if (list->fl_rows > 0)
+    {
+      memcpy(tmp, list->fl_files, sizeof(FAR struct file *) * list->fl_rows);
+    }
+
   i = list->fl_rows;
   do
     {
@@ -101,8 +119,13 @@ static int files_extend(FAR struct filelist *list, size_t row)
     }
   while (++i < row);
 
+  flags = spin_lock_irqsave(&list->fl_lock);
+  files = list->fl_files;
   list->fl_files = tmp;
   list->fl_rows = row;
+  spin_unlock_irqrestore(&list->fl_lock, flags);
+
+  kmm_free(files);
 
   /* Note: If assertion occurs, the fl_rows has a overflow.
    * And there may be file descriptors leak in system.
@@ -112,6 +135,153 @@ static int files_extend(FAR struct filelist *list, size_t row)
   return 0;
 }
 
+/****************************************************************************
+ * Name: files_install
+ *
+ * Description:
+ *   Fill a free file structure.  The caller holds the list semaphore.  The
+ *   fields are set under the list spinlock so that fs_getfilep() never
+ *   sees a partially initialized file.
+ *
+ ****************************************************************************/
+
+static void files_install(FAR struct filelist *list, FAR struct file *filep,
+                          FAR struct inode *inode, int oflags, off_t pos,
+                          FAR void *priv)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&list->fl_lock);
+  filep->f_oflags = oflags;
+  filep->f_pos    = pos;
+  filep->f_inode  = inode;
+  filep->f_priv   = priv;
+  spin_unlock_irqrestore(&list->fl_lock, flags);
+}
+
+/****************************************************************************
+ * Name: files_current
+ *
+ * Description:
+ *   Return the file that a file list entry currently refers to.  This is
+ *   the entry itself unless dup2() replaced the file while it was in use:
+ *   the users still refer to the old file in the entry, so the new one is
+ *   kept in a file structure of its own.
+ *
+ ****************************************************************************/
+
+static FAR struct file *files_current(FAR struct file *filep)
+{
+  return filep->f_dup != NULL ? filep->f_dup : filep;
+}
+
+/****************************************************************************
+ * Name: files_busy
+ *
+ * Description:
+ *   Mark a file that is still in use as closed and take a reference to it
+ *   for the caller, who must then call files_shutdown().  The list
+ *   spinlock is held.
+ *
+ ****************************************************************************/
+
+static void files_busy(FAR struct filelist *list, FAR struct file *filep)
+{
+  DEBUGASSERT(filep->f_refs < INT16_MAX);
+  filep->f_closed = true;
+  filep->f_refs++;
+  filep->f_list = list;
+}
+
+/****************************************************************************
+ * Name: files_shutdown
+ *
+ * Description:
+ *   Close the driver of a file that was closed while it was in use.  As
+ *   when it is not in use, this interrupts the I/O that other threads are
+ *   blocked in, and the result of the close is returned to the caller of
+ *   close().  Only the release of the inode and of the file structure is
+ *   left to the last fs_putfilep(), since the other threads still refer
+ *   to them.
+ *
+ ****************************************************************************/
+
+static int files_shutdown(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  int ret = OK;
+
+  epoll_fileclose(filep);
+
+  if (inode->u.i_ops && inode->u.i_ops->close)
+    {
+      ret = inode->u.i_ops->close(filep);
+    }
+
+  fs_putfilep(filep);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: files_detach
+ *
+ * Description:
+ *   Move the open file of a file list entry out of the list into the
+ *   caller's file structure so that it can be closed with file_close(),
+ *   and return NULL.  If the file is still referenced, it is marked as
+ *   closed with files_busy() and returned instead: the caller closes it
+ *   with files_shutdown().
+ *
+ ****************************************************************************/
+
+static FAR struct file *files_detach(FAR struct filelist *list,
+                                     FAR struct file *filep,
+                                     FAR struct file *file)
+{
+  FAR struct file *curr;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&list->fl_lock);
+
+  curr = files_current(filep);
+  filep->f_dup = NULL;
+
+  if (curr->f_refs > 0)
+    {
+      files_busy(list, curr);
+      spin_unlock_irqrestore(&list->fl_lock, flags);
+      return curr;
+    }
+
+  memcpy(file, curr, sizeof(struct file));
+  if (curr == filep)
+    {
+      memset(filep, 0, sizeof(struct file));
+    }
+
+  spin_unlock_irqrestore(&list->fl_lock, flags);
+
+  if (curr != filep)
+    {
+      kmm_free(curr);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: files_close
+ *
+ * Description:
+ *   Close what files_detach() returned.
+ *
+ ****************************************************************************/
+
+static int files_close(FAR struct file *busy, FAR struct file *file)
+{
+  return busy != NULL ? files_shutdown(busy) : file_close(file);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -130,6 +300,9 @@ void files_initlist(FAR struct filelist *list)
   /* Initialize the list access mutex */
 
   nxsem_init(&list->fl_sem, 0, 1);
+#ifdef CONFIG_SPINLOCK
+  spin_initialize(&list->fl_lock, SP_UNLOCKED);
+#endif
 }
 
 /****************************************************************************
@@ -156,7 +329,17 @@ void files_releaselist(FAR struct filelist *list)
     {
       for (j = CONFIG_NFILE_DESCRIPTORS_PER_BLOCK - 1; j >= 0; j--)
         {
-          file_close(&list->fl_files[i][j]);
+          FAR struct file *filep = &list->fl_files[i][j];
+          struct file file;
+
+          /* Close the file installed by dup2() first, then the entry */
+
+          if (filep->f_dup != NULL)
+            {
+              files_close(files_detach(list, filep, &file), &file);
+            }
+
+          files_close(files_detach(list, filep, &file), &file);
         }
 
       kmm_free(list->fl_files[i]);
@@ -221,12 +404,11 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
     {
       do
         {
-          if (!list->fl_files[i][j].f_inode)
+          if (!list->fl_files[i][j].f_inode &&
+              !list->fl_files[i][j].f_dup)
             {
-              list->fl_files[i][j].f_oflags = oflags;
-              list->fl_files[i][j].f_pos    = pos;
-              list->fl_files[i][j].f_inode  = inode;
-              list->fl_files[i][j].f_priv   = priv;
+              files_install(list, &list->fl_files[i][j], inode, oflags,
+                            pos, priv);
               _files_semgive(list);
               return i * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK + j;
             }
@@ -242,10 +424,7 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
   ret = files_extend(list, i + 1);
   if (ret >= 0)
     {
-      list->fl_files[i][0].f_oflags = oflags;
-      list->fl_files[i][0].f_pos    = pos;
-      list->fl_files[i][0].f_inode  = inode;
-      list->fl_files[i][0].f_priv   = priv;
+      files_install(list, &list->fl_files[i][0], inode, oflags, pos, priv);
       ret = i * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK;
     }
 
@@ -295,8 +474,9 @@ int files_duplist(FAR struct filelist *plist, FAR struct filelist *clist)
             }
 #endif
 
-          filep = &plist->fl_files[i][j];
-          if (filep->f_inode == NULL || (filep->f_oflags & O_CLOEXEC) != 0)
+          filep = files_current(&plist->fl_files[i][j]);
+          if (filep->f_inode == NULL || filep->f_closed ||
+              (filep->f_oflags & O_CLOEXEC) != 0)
             {
               continue;
             }
@@ -327,7 +507,12 @@ out:
  *
  * Description:
  *   Given a file descriptor, return the corresponding instance of struct
- *   file.
+ *   file and take a reference to it.
+ *
+ *   This is on the path of every read(), write(), ioctl() and poll(), so
+ *   it does not take the list semaphore.  Only the list spinlock is held
+ *   while indexing the list, which is published under it, and while taking
+ *   the reference.
  *
  * Input Parameters:
  *   fd    - The file descriptor
@@ -342,7 +527,9 @@ out:
 int fs_getfilep(int fd, FAR struct file **filep)
 {
   FAR struct filelist *list;
-  int ret;
+  FAR struct file *file;
+  irqstate_t flags;
+  int ret = -EBADF;
 
   DEBUGASSERT(filep != NULL);
   *filep = (FAR struct file *)NULL;
@@ -361,37 +548,102 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  if (fd < 0 || fd >= list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
+  if (fd < 0)
     {
       return -EBADF;
     }
 
-  /* The descriptor is in a valid range to file descriptor... Get the
-   * thread-specific file list.
-   */
+  flags = spin_lock_irqsave(&list->fl_lock);
 
-  /* And return the file pointer from the list */
-
-  ret = _files_semtake(list);
-  if (ret < 0)
+  if (fd < list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
     {
-      return ret;
+      file = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
+                            [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+      file = files_current(file);
+
+      /* If f_inode is NULL, fd was closed.  If f_closed is set, fd was
+       * closed while the file was in use.
+       */
+
+      if (file->f_inode != NULL && !file->f_closed)
+        {
+          DEBUGASSERT(file->f_refs < INT16_MAX);
+          file->f_refs++;
+          file->f_list = list;
+          *filep = file;
+          ret = OK;
+        }
     }
 
-  *filep = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                          [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+  spin_unlock_irqrestore(&list->fl_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: fs_putfilep
+ *
+ * Description:
+ *   Release a reference to a file taken with fs_getfilep().  If the file
+ *   descriptor has been closed while the file was in use, the file is
+ *   released now.  Its driver was already closed by close() or dup2().
+ *
+ *   The reference is released against the file list that it was taken
+ *   from, which is not necessarily the list of the calling task.
+ *
+ * Input Parameters:
+ *   filep - The file returned by fs_getfilep()
+ *
+ * Returned Value:
+ *   Zero (OK) is always returned.
+ *
+ ****************************************************************************/
+
+int fs_putfilep(FAR struct file *filep)
+{
+  FAR struct filelist *list;
+  FAR struct file *alloc = NULL;
+  FAR struct inode *inode = NULL;
+  FAR struct file *dup;
+  irqstate_t flags;
+
+  DEBUGASSERT(filep != NULL);
+
+  list = filep->f_list;
+  DEBUGASSERT(list != NULL);
 
-  /* if f_inode is NULL, fd was closed */
+  flags = spin_lock_irqsave(&list->fl_lock);
 
-  if (!(*filep)->f_inode)
+  DEBUGASSERT(filep->f_refs > 0);
+  if (--filep->f_refs == 0 && filep->f_closed)
     {
-      *filep = (FAR struct file *)NULL;
-      ret = -EBADF;
+      inode = filep->f_inode;
+      if (filep->f_alloc)
+        {
+          /* A file installed by dup2() is no longer in the list once it
+           * is closed.
+           */
+
+          alloc = filep;
+        }
+      else
+        {
+          /* Keep the file that dup2() may have installed over this one */
+
+          dup = filep->f_dup;
+          memset(filep, 0, sizeof(struct file));
+          filep->f_dup = dup;
+        }
     }
 
-  _files_semgive(list);
+  spin_unlock_irqrestore(&list->fl_lock, flags);
 
-  return ret;
+  if (inode != NULL)
+    {
+      inode_release(inode);
+      kmm_free(alloc);
+    }
+
+  return OK;
 }
 
 /****************************************************************************
@@ -415,6 +667,13 @@ int fs_getfilep(int fd, FAR struct file **filep)
 int nx_dup2(int fd1, int fd2)
 {
   FAR struct filelist *list;
+  FAR struct file *filep1;
+  FAR struct file *filep2;
+  FAR struct file *newfile = NULL;
+  FAR struct file *curr;
+  struct file file;
+  struct file old;
+  irqstate_t flags;
   int ret;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
@@ -422,8 +681,7 @@ int nx_dup2(int fd1, int fd2)
   list = nxsched_get_files();
   DEBUGASSERT(list != NULL);
 
-  if (fd1 < 0 || fd1 >= CONFIG_NFILE_DESCRIPTORS_PER_BLOCK * list->fl_rows ||
-      fd2 < 0)
+  if (fd1 < 0 || fd2 < 0)
     {
       return -EBADF;
     }
@@ -436,6 +694,12 @@ int nx_dup2(int fd1, int fd2)
       return ret;
     }
 
+  if (fd1 >= CONFIG_NFILE_DESCRIPTORS_PER_BLOCK * list->fl_rows)
+    {
+      _files_semgive(list);
+      return -EBADF;
+    }
+
   if (fd2 >= CONFIG_NFILE_DESCRIPTORS_PER_BLOCK * list->fl_rows)
     {
       ret = files_extend(list, fd2 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK + 1);
@@ -446,15 +710,88 @@ int nx_dup2(int fd1, int fd2)
         }
     }
 
-  /* Perform the dup2 operation */
+  filep1 = &list->fl_files[fd1 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
+                          [fd1 % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+  filep2 = &list->fl_files[fd2 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
+                          [fd2 % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+  filep1 = files_current(filep1);
 
-  ret = file_dup2(&list->fl_files[fd1 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                                 [fd1 % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK],
-                  &list->fl_files[fd2 / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                                 [fd2 % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]);
+  if (filep1->f_inode == NULL || filep1->f_closed)
+    {
+      _files_semgive(list);
+      return -EBADF;
+    }
+
+  if (fd1 == fd2)
+    {
+      _files_semgive(list);
+      return fd2;
+    }
+
+  /* Perform the dup2 operation into a private file structure first: the
+   * file in fd2 may still be in use by fs_getfilep() callers.
+   */
+
+  memset(&file, 0, sizeof(struct file));
+  ret = file_dup2(filep1, &file);
+  if (ret < 0)
+    {
+      _files_semgive(list);
+      return ret;
+    }
+
+  /* Replace the file in fd2.  If that file is in use, it is closed as in
+   * nx_close(): its driver is closed now, the last fs_putfilep() releases
+   * it.  Its users still refer to it, so the new file is installed beside
+   * it in a file structure of its own.
+   */
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&list->fl_lock);
+      curr  = files_current(filep2);
+      if (curr->f_refs == 0 || newfile != NULL)
+        {
+          break;
+        }
+
+      spin_unlock_irqrestore(&list->fl_lock, flags);
+
+      newfile = kmm_malloc(sizeof(struct file));
+      if (newfile == NULL)
+        {
+          file_close(&file);
+          _files_semgive(list);
+          return -ENOMEM;
+        }
+    }
+
+  memset(&old, 0, sizeof(struct file));
+  if (curr->f_refs == 0)
+    {
+      memcpy(&old, curr, sizeof(struct file));
+      memcpy(curr, &file, sizeof(struct file));
+      curr->f_alloc = old.f_alloc;
+      curr = NULL;
+    }
+  else
+    {
+      files_busy(list, curr);
+
+      memcpy(newfile, &file, sizeof(struct file));
+      newfile->f_alloc = true;
+      filep2->f_dup    = newfile;
+      newfile          = NULL;
+    }
+
+  spin_unlock_irqrestore(&list->fl_lock, flags);
   _files_semgive(list);
 
-  return ret < 0 ? ret : fd2;
+  /* Close the file that was replaced, if any */
+
+  kmm_free(newfile);
+  files_close(curr, &old);
+  return fd2;
 }
 
 /****************************************************************************
@@ -506,6 +843,7 @@ int nx_close(int fd)
 {
   FAR struct filelist *list;
   FAR struct file     *filep;
+  FAR struct file     *busy;
   FAR struct file      file;
   int                  ret;
 
@@ -524,24 +862,29 @@ int nx_close(int fd)
       return ret;
     }
 
-  /* If the file was properly opened, there should be an inode assigned */
-
-  if (fd < 0 || fd >= list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK ||
-      !list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                     [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK].f_inode)
+  if (fd < 0 || fd >= list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
     {
       _files_semgive(list);
       return -EBADF;
     }
 
+  /* If the file was properly opened, there should be an inode assigned */
+
   filep = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
                          [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
-  memcpy(&file, filep, sizeof(struct file));
-  memset(filep, 0,     sizeof(struct file));
+  if (files_current(filep)->f_inode == NULL ||
+      files_current(filep)->f_closed)
+    {
+      _files_semgive(list);
+      return -EBADF;
+    }
+
+  /* If the file is in use, the last fs_putfilep() releases it */
 
+  busy = files_detach(list, filep, &file);
   _files_semgive(list);
 
-  return file_close(&file);
+  return files_close(busy, &file);
 }
 
 /****************************************************************************
@@ -0,0 +1,199 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#if CONFIG_PSEUDOFS_CACHE_SIZE > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_PSEUDOFS_CACHE_SIZE & (CONFIG_PSEUDOFS_CACHE_SIZE - 1)) != 0
+#  error CONFIG_PSEUDOFS_CACHE_SIZE must be a power of two
+#endif
+
+#define INODE_CACHE_MASK (CONFIG_PSEUDOFS_CACHE_SIZE - 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached lookup: 'node' is the child of 'parent' and 'peer' is the
+ * inode to its "left", as inode_search() returns them.
+ */
+
+struct inode_cache_s
+{
+  FAR struct inode *parent;
+  FAR struct inode *node;
+  FAR struct inode *peer;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_cache_s g_inode_cache[CONFIG_PSEUDOFS_CACHE_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_entry
+ *
+ * Description:
+ *   Return the cache entry for a parent inode and a path segment.
+ *
+ ****************************************************************************/
+
+static FAR struct inode_cache_s *
+inode_cache_entry(FAR struct inode *parent, FAR const char *name)
+{
+  uint32_t hash = (uint32_t)(uintptr_t)parent;
+
+  /* FNV-1a over the path segment, seeded with the parent */
+
+  while (*name != '\0' && *name != '/')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619;
+    }
+
+  hash ^= hash >> 16;
+  return &g_inode_cache[hash & INODE_CACHE_MASK];
+}
+
+/****************************************************************************
+ * Name: inode_cache_match
+ *
+ * Description:
+ *   Return true if the path segment 'name' is the name of 'node'.
+ *
+ ****************************************************************************/
+
+static bool inode_cache_match(FAR struct inode *node, FAR const char *name)
+{
+  FAR const char *nname = node->i_name;
+
+  while (*nname != '\0' && *nname == *name)
+    {
+      nname++;
+      name++;
+    }
+
+  return *nname == '\0' && (*name == '\0' || *name == '/');
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the child of 'parent' named by the first path segment of 'name'
+ *   in the pseudo-filesystem lookup cache.
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_cache_lookup(FAR struct inode *parent,
+                                     FAR const char *name,
+                                     FAR struct inode **peer)
+{
+  FAR struct inode_cache_s *entry = inode_cache_entry(parent, name);
+
+  if (entry->node != NULL && entry->parent == parent &&
+      inode_cache_match(entry->node, name))
+    {
+      *peer = entry->peer;
+      return entry->node;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember where a child of 'parent' was found in the inode tree.
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR struct inode *parent, FAR struct inode *node,
+                     FAR struct inode *peer)
+{
+  FAR struct inode_cache_s *entry = inode_cache_entry(parent, node->i_name);
+
+  entry->parent = parent;
+  entry->node   = node;
+  entry->peer   = peer;
+}
+
+/****************************************************************************
+ * Name: inode_cache_remove
+ *
+ * Description:
+ *   Forget a child of 'parent'.
+ *
+ ****************************************************************************/
+
+void inode_cache_remove(FAR struct inode *parent, FAR struct inode *node)
+{
+  FAR struct inode_cache_s *entry;
+
+  if (node != NULL)
+    {
+      entry = inode_cache_entry(parent, node->i_name);
+      if (entry->node == node)
+        {
+          entry->node = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: inode_cache_flush
+ *
+ * Description:
+ *   Forget everything.
+ *
+ ****************************************************************************/
+
+void inode_cache_flush(void)
+{
+  memset(g_inode_cache, 0, sizeof(g_inode_cache));
+}
+
+#endif /* CONFIG_PSEUDOFS_CACHE_SIZE > 0 */
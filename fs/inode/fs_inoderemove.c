@@ -77,6 +77,20 @@ FAR struct inode *inode_unlink(FAR const char *path)
       node = desc.node;
       DEBUGASSERT(node != NULL);
 
+      /* The node and the node to its "right" are cached under the parent,
+       * the nodes below it under the nodes that are about to go away.
+       */
+
+      if (node->i_child != NULL)
+        {
+          inode_cache_flush();
+        }
+      else
+        {
+          inode_cache_remove(desc.parent, node);
+          inode_cache_remove(desc.parent, node->i_peer);
+        }
+
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
@@ -118,6 +118,10 @@ static void inode_insert(FAR struct inode *node,
       node->i_parent  = parent;
       parent->i_child = node;
     }
+
+  /* The node to the "right" has a new node to its "left" */
+
+  inode_cache_remove(parent, node->i_peer);
 }
 
 /****************************************************************************
@@ -275,6 +275,13 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
       else
         {
+          /* Remember where the node is for the next search */
+
+          if (above != NULL)
+            {
+              inode_cache_add(above, node, left);
+            }
+
           /* Now there are three remaining possibilities:
            *   (1) This is the node that we are looking for.
            *   (2) The node we are looking for is "below" this one.
@@ -382,11 +389,18 @@ static int _inode_search(FAR struct inode_search_s *desc)
                 }
 #endif
 
-              /* Keep looking at the next level "down" */
+              /* Keep looking at the next level "down".  If the cache knows
+               * where the node is, skip over the nodes to its "left".
+               */
 
               above = node;
               left  = NULL;
-              node  = node->i_child;
+              node  = inode_cache_lookup(above, name, &left);
+              if (node == NULL)
+                {
+                  left = NULL;
+                  node = above->i_child;
+                }
             }
         }
     }
@@ -368,6 +368,89 @@ FAR struct inode *inode_unlink(FAR const char *path);
 
 int inode_remove(FAR const char *path);
 
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the child of 'parent' named by the first path segment of 'name'
+ *   in the pseudo-filesystem lookup cache.
+ *
+ * Input Parameters:
+ *   parent - The inode above the child
+ *   name   - The path segment, terminated by '/' or by the end of the path
+ *   peer   - The location to return the inode to the "left" of the child
+ *
+ * Returned Value:
+ *   The child inode or NULL if it is not in the cache.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+#if CONFIG_PSEUDOFS_CACHE_SIZE > 0
+FAR struct inode *inode_cache_lookup(FAR struct inode *parent,
+                                     FAR const char *name,
+                                     FAR struct inode **peer);
+#else
+#  define inode_cache_lookup(parent, name, peer) NULL
+#endif
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember where a child of 'parent' was found in the inode tree.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+#if CONFIG_PSEUDOFS_CACHE_SIZE > 0
+void inode_cache_add(FAR struct inode *parent, FAR struct inode *node,
+                     FAR struct inode *peer);
+#else
+#  define inode_cache_add(parent, node, peer)
+#endif
+
+/****************************************************************************
+ * Name: inode_cache_remove
+ *
+ * Description:
+ *   Forget a child of 'parent'.  This must be done when the node is
+ *   unlinked from the inode tree or when the inode to its "left" changes.
+ *   'node' may be NULL.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+#if CONFIG_PSEUDOFS_CACHE_SIZE > 0
+void inode_cache_remove(FAR struct inode *parent, FAR struct inode *node);
+#else
+#  define inode_cache_remove(parent, node)
+#endif
+
+/****************************************************************************
+ * Name: inode_cache_flush
+ *
+ * Description:
+ *   Forget everything.  This must be done when a subtree is unlinked from
+ *   the inode tree.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+#if CONFIG_PSEUDOFS_CACHE_SIZE > 0
+void inode_cache_flush(void);
+#else
+#  define inode_cache_flush()
+#endif
+
 /****************************************************************************
  * Name: inode_addref
  *
@@ -429,6 +512,17 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
 
 int dir_allocate(FAR struct file *filep, FAR const char *relpath);
 
+/****************************************************************************
+ * Name: epoll_fileclose
+ *
+ * Description:
+ *   Remove a file that is being closed from the interest list of every
+ *   epoll instance.
+ *
+ ****************************************************************************/
+
+void epoll_fileclose(FAR struct file *filep);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
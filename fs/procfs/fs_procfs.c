@@ -73,6 +73,7 @@ extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 extern const struct procfs_operations tcbinfo_operations;
+extern const struct procfs_operations wqueue_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
  * deal with them here is not a good coupling. What is really needed is a
@@ -184,6 +185,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #if defined(CONFIG_DEBUG_TCBINFO) && !defined(CONFIG_FS_PROCFS_EXCLUDE_TCBINFO)
   { "tcbinfo",       &tcbinfo_operations,         PROCFS_FILE_TYPE   },
 #endif
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+  { "wqueue",        &wqueue_operations,          PROCFS_FILE_TYPE   },
+#endif
 };
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
@@ -135,6 +135,9 @@ static FAR const char *g_iob_user_names[] =
 #ifdef CONFIG_NET_IPFORWARD
   "ipforward",
 #endif
+#ifdef CONFIG_NETDEV_IOB_RX
+  "netdev_rx",
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   "rad802154",
 #endif
@@ -254,6 +257,7 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct iobinfo_file_s *iobfile;
   FAR struct iob_userstats_s *userstats;
+  struct iob_classstats_s classstats;
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -332,6 +336,42 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       totalsize += copysize;
     }
 
+  /* Then the state of each pool of I/O buffers */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                                   "\n%16s%16s%16s%16s\n",
+                                   "BUFSIZE", "TOTAL", "FREE", "HEAP");
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; iob_getclassstats(i, &classstats) >= 0; i++)
+    {
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                                       "%16u%16u%16u%16u\n",
+                                       classstats.bufsize,
+                                       classstats.ntotal,
+                                       classstats.nfree,
+                                       classstats.nheap);
+
+          copysize   = procfs_memcpy(iobfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
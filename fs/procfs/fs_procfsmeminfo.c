@@ -327,6 +327,48 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+  /* Followed by the statistics of the per-CPU heap caches */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%13s%11s%11s%11s%11s%11s%7s\n", "",
+                                   "hits", "misses", "refills", "drains",
+                                   "cached", "ncache");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (totalsize < buflen)
+        {
+          struct mm_cacheinfo_s cinfo;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          /* Show the heap cache information */
+
+          mm_cacheinfo(entry->heap, &cinfo);
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12s:%11lu%11lu%11lu%11lu%11lu%7lu\n",
+                                       entry->name, cinfo.hits, cinfo.misses,
+                                       cinfo.refills, cinfo.drains,
+                                       (unsigned long)cinfo.cached,
+                                       (unsigned long)cinfo.ncached);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
 #ifdef CONFIG_MM_PGALLOC
   if (totalsize < buflen)
     {
@@ -0,0 +1,333 @@
+/****************************************************************************
+ * fs/procfs/fs_procfswqueue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_WORKQUEUE_STATS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define WQUEUE_LINELEN 96
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[WQUEUE_LINELEN];      /* Pre-allocated buffer for lines */
+};
+
+/* This structure describes one kernel work queue */
+
+struct wqueue_name_s
+{
+  FAR const char *name;           /* Name of the worker threads */
+  int qid;                        /* Work queue ID */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct wqueue_name_s g_wqueue_names[] =
+{
+#ifdef CONFIG_SCHED_HPWORK
+  { "hpwork", HPWORK },
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  { "lpwork", LPWORK },
+#endif
+};
+
+#define WQUEUE_NQUEUES (sizeof(g_wqueue_names) / sizeof(g_wqueue_names[0]))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wqueue_operations =
+{
+  wqueue_open,    /* open */
+  wqueue_close,   /* close */
+  wqueue_read,    /* read */
+  NULL,           /* write */
+  wqueue_dup,     /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  wqueue_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct wqueue_file_s *)
+    kmm_zalloc(sizeof(struct wqueue_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct wqueue_file_s *wqfile;
+  struct work_stats_s stats;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int wndx;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  wqfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(wqfile);
+
+  /* The first line is the headers.  Times are in microseconds. */
+
+  linesize  = procfs_snprintf(wqfile->line, WQUEUE_LINELEN,
+                              "%-8s %3s %3s %5s %10s %10s %8s %8s %8s %8s\n",
+                              "QUEUE", "NDX", "CPU", "PID", "RUN",
+                              "STOLEN", "AVGWAIT", "MAXWAIT", "AVGRUN",
+                              "MAXRUN");
+
+  copysize  = procfs_memcpy(wqfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  /* Loop through each worker of each queue printing its statistics */
+
+  for (i = 0; i < WQUEUE_NQUEUES; i++)
+    {
+      for (wndx = 0;
+           work_stats(g_wqueue_names[i].qid, wndx, &stats) == OK;
+           wndx++)
+        {
+          if (totalsize >= buflen)
+            {
+              break;
+            }
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(wqfile->line, WQUEUE_LINELEN,
+                                       "%-8s %3d %3d %5d %10lu %10lu "
+                                       "%8lu %8lu %8lu %8lu\n",
+                                       g_wqueue_names[i].name, wndx,
+                                       stats.cpu, (int)stats.pid,
+                                       (unsigned long)stats.nrun,
+                                       (unsigned long)stats.nstolen,
+                                       stats.nrun == 0 ? 0ul :
+                                       (unsigned long)(stats.totalwait /
+                                                       stats.nrun),
+                                       (unsigned long)stats.maxwait,
+                                       stats.nrun == 0 ? 0ul :
+                                       (unsigned long)(stats.totalrun /
+                                                       stats.nrun),
+                                       (unsigned long)stats.maxrun);
+
+          copysize   = procfs_memcpy(wqfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct wqueue_file_s *)
+    kmm_malloc(sizeof(struct wqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "wqueue" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_WORKQUEUE_STATS && !CONFIG_FS_PROCFS_EXCLUDE_WQUEUE */
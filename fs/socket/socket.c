@@ -202,6 +202,7 @@ FAR struct socket *file_socket(FAR struct file *filep)
 
 FAR struct socket *sockfd_socket(int sockfd)
 {
+  FAR struct socket *psock;
   FAR struct file *filep;
 
   if (fs_getfilep(sockfd, &filep) < 0)
@@ -209,7 +210,11 @@ FAR struct socket *sockfd_socket(int sockfd)
       return NULL;
     }
 
-  return file_socket(filep);
+  /* The socket is returned without a reference, as it always was */
+
+  psock = file_socket(filep);
+  fs_putfilep(filep);
+  return psock;
 }
 
 /****************************************************************************
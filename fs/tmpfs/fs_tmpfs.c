@@ -49,8 +49,19 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+/* File data pages */
+
+#define TMPFS_PAGESIZE       CONFIG_FS_TMPFS_PAGESIZE
+#define TMPFS_PAGE(pos)      ((size_t)(pos) / TMPFS_PAGESIZE)
+#define TMPFS_PAGEOFF(pos)   ((size_t)(pos) % TMPFS_PAGESIZE)
+#define TMPFS_NPAGES(size)   (((size) + TMPFS_PAGESIZE - 1) / TMPFS_PAGESIZE)
+
+#ifndef MIN
+#  define MIN(a,b)           ((a) < (b) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#  define MAX(a,b)           ((a) > (b) ? (a) : (b))
 #endif
 
 #define tmpfs_lock(fs) \
@@ -89,8 +100,15 @@ struct tmpfs_dir_s
 
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
+static int  tmpfs_realloc_pages(FAR struct tmpfs_file_s *tfo,
+              size_t npages);
+static void tmpfs_release_pages(FAR struct tmpfs_file_s *tfo,
+              size_t npages);
+static FAR uint8_t *tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+              size_t index);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static int  tmpfs_map_file(FAR struct tmpfs_file_s *tfo);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -254,6 +272,112 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
   return ret;
 }
 
+/****************************************************************************
+ * Name: tmpfs_realloc_pages
+ ****************************************************************************/
+
+static int tmpfs_realloc_pages(FAR struct tmpfs_file_s *tfo,
+                               size_t npages)
+{
+  FAR uint8_t **newpages;
+  size_t newsize;
+
+  if (npages <= tfo->tfo_npages)
+    {
+      return OK;
+    }
+
+  /* Grow the page table geometrically so that appending to the file only
+   * rarely reallocates it.  Only the page pointers are copied, the data
+   * stays where it is.
+   */
+
+  newsize  = MAX(npages, 2 * tfo->tfo_npages);
+  newpages = kmm_realloc(tfo->tfo_pages, newsize * sizeof(FAR uint8_t *));
+  if (newpages == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(&newpages[tfo->tfo_npages], 0,
+         (newsize - tfo->tfo_npages) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_pages  = newpages;
+  tfo->tfo_npages = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_release_pages
+ ****************************************************************************/
+
+static void tmpfs_release_pages(FAR struct tmpfs_file_s *tfo,
+                                size_t npages)
+{
+  size_t index;
+
+  /* Free the pages past the first npages that were allocated one by one */
+
+  for (index = MAX(npages, tfo->tfo_nrun); index < tfo->tfo_npages;
+       index++)
+    {
+      if (tfo->tfo_pages[index] != NULL)
+        {
+          kmm_free(tfo->tfo_pages[index]);
+          tfo->tfo_pages[index] = NULL;
+          tfo->tfo_alloc -= TMPFS_PAGESIZE;
+        }
+    }
+
+  /* The run can only be freed as a whole.  Clear its pages past the first
+   * npages instead, they are holes again.
+   */
+
+  if (npages == 0)
+    {
+      kmm_free(tfo->tfo_run);
+      kmm_free(tfo->tfo_pages);
+
+      tfo->tfo_alloc -= tfo->tfo_nrun * TMPFS_PAGESIZE;
+      tfo->tfo_npages = 0;
+      tfo->tfo_nrun   = 0;
+      tfo->tfo_pages  = NULL;
+      tfo->tfo_run    = NULL;
+    }
+  else if (npages < tfo->tfo_nrun)
+    {
+      memset(tfo->tfo_run + npages * TMPFS_PAGESIZE, 0,
+             (tfo->tfo_nrun - npages) * TMPFS_PAGESIZE);
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_alloc_page
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+                                     size_t index)
+{
+  FAR uint8_t *page;
+
+  DEBUGASSERT(index < tfo->tfo_npages);
+
+  /* Fill the hole if the page was never written */
+
+  page = tfo->tfo_pages[index];
+  if (page == NULL)
+    {
+      page = kmm_zalloc(TMPFS_PAGESIZE);
+      if (page != NULL)
+        {
+          tfo->tfo_pages[index] = page;
+          tfo->tfo_alloc       += TMPFS_PAGESIZE;
+        }
+    }
+
+  return page;
+}
+
 /****************************************************************************
  * Name: tmpfs_realloc_file
  ****************************************************************************/
@@ -261,54 +385,107 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
                               size_t newsize)
 {
-  FAR uint8_t *newdata;
-  size_t allocsize;
-  size_t delta;
+  size_t npages = TMPFS_NPAGES(newsize);
+  size_t offset;
+  int ret;
 
   /* Are we growing or shrinking the object? */
 
-  if (newsize <= tfo->tfo_alloc)
+  if (newsize < tfo->tfo_size)
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
+      /* Shrinking ... Release the pages past the new end of the file and
+       * clear the rest of the last page, so that the data past the end of
+       * the file reads back as zeros if the file grows again.
        */
 
-      if (newsize > 0)
-        {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
-           */
+      tmpfs_release_pages(tfo, npages);
 
-          delta = tfo->tfo_alloc - newsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
-            {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+      offset = TMPFS_PAGEOFF(newsize);
+      if (offset > 0 && tfo->tfo_pages[npages - 1] != NULL)
+        {
+          memset(tfo->tfo_pages[npages - 1] + offset, 0,
+                 TMPFS_PAGESIZE - offset);
+        }
+    }
+  else
+    {
+      /* Growing ... Only the page table grows, the new pages are holes
+       * until they are written.
+       */
 
-              tfo->tfo_size = newsize;
-              return OK;
-            }
+      ret = tmpfs_realloc_pages(tfo, npages);
+      if (ret < 0)
+        {
+          return ret;
         }
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
-   */
+  tfo->tfo_size = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_map_file
+ ****************************************************************************/
+
+static int tmpfs_map_file(FAR struct tmpfs_file_s *tfo)
+{
+  FAR uint8_t *newrun;
+  size_t npages = TMPFS_NPAGES(tfo->tfo_size);
+  size_t index;
+
+  /* Nothing to do if the run already holds all of the file */
 
-  allocsize = newsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+  if (npages <= tfo->tfo_nrun)
+    {
+      return OK;
+    }
+
+  /* A single page is a run by itself */
+
+  if (npages == 1)
+    {
+      newrun = tmpfs_alloc_page(tfo, 0);
+      if (newrun == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      tfo->tfo_run  = newrun;
+      tfo->tfo_nrun = 1;
+      return OK;
+    }
 
-  /* Realloc the file object */
+  /* Otherwise, move the data of the file into a new run */
 
-  newdata = kmm_realloc(tfo->tfo_data, allocsize);
-  if (newdata == NULL)
+  newrun = kmm_zalloc(npages * TMPFS_PAGESIZE);
+  if (newrun == NULL)
     {
       return -ENOMEM;
     }
 
-  /* Return the new address of the reallocated file object */
+  for (index = 0; index < npages; index++)
+    {
+      if (tfo->tfo_pages[index] != NULL)
+        {
+          memcpy(newrun + index * TMPFS_PAGESIZE, tfo->tfo_pages[index],
+                 TMPFS_PAGESIZE);
+
+          if (index >= tfo->tfo_nrun)
+            {
+              kmm_free(tfo->tfo_pages[index]);
+              tfo->tfo_alloc -= TMPFS_PAGESIZE;
+            }
+        }
+
+      tfo->tfo_pages[index] = newrun + index * TMPFS_PAGESIZE;
+    }
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_size  = newsize;
-  tfo->tfo_data  = newdata;
+  kmm_free(tfo->tfo_run);
+
+  tfo->tfo_alloc += (npages - tfo->tfo_nrun) * TMPFS_PAGESIZE;
+  tfo->tfo_nrun   = npages;
+  tfo->tfo_run    = newrun;
   return OK;
 }
 
@@ -348,7 +525,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_release_pages(tfo, 0);
       kmm_free(tfo);
     }
 
@@ -517,12 +694,15 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
    * locked with one reference count.
    */
 
-  tfo->tfo_alloc = 0;
-  tfo->tfo_type  = TMPFS_REGULAR;
-  tfo->tfo_refs  = 1;
-  tfo->tfo_flags = 0;
-  tfo->tfo_size  = 0;
-  tfo->tfo_data  = NULL;
+  tfo->tfo_alloc  = 0;
+  tfo->tfo_type   = TMPFS_REGULAR;
+  tfo->tfo_refs   = 1;
+  tfo->tfo_flags  = 0;
+  tfo->tfo_size   = 0;
+  tfo->tfo_npages = 0;
+  tfo->tfo_nrun   = 0;
+  tfo->tfo_pages  = NULL;
+  tfo->tfo_run    = NULL;
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1073,7 +1253,14 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
-      tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+
+      /* The pages of a sparse file may hold less than its size */
+
+      if (to->to_alloc > tmptfo->tfo_size)
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
+
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1149,7 +1336,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_release_pages(tfo, 0);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1442,7 +1629,7 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_release_pages(tfo, 0);
       kmm_free(tfo);
       return OK;
     }
@@ -1461,9 +1648,13 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
                           size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nread;
   off_t startpos;
   off_t endpos;
+  size_t offset;
+  size_t ncopy;
+  size_t pos;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1488,15 +1679,36 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   nread    = buflen;
   endpos   = startpos + buflen;
 
-  if (endpos > tfo->tfo_size)
+  if ((size_t)startpos >= tfo->tfo_size)
+    {
+      nread = 0;
+    }
+  else if (endpos > tfo->tfo_size)
     {
       endpos = tfo->tfo_size;
       nread  = endpos - startpos;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the memory object to the user buffer one page at a
+   * time.  Holes in the file read as zeros.
+   */
+
+  for (pos = 0; pos < (size_t)nread; pos += ncopy)
+    {
+      page   = tfo->tfo_pages[TMPFS_PAGE(startpos + pos)];
+      offset = TMPFS_PAGEOFF(startpos + pos);
+      ncopy  = MIN(TMPFS_PAGESIZE - offset, (size_t)nread - pos);
+
+      if (page != NULL)
+        {
+          memcpy(&buffer[pos], &page[offset], ncopy);
+        }
+      else
+        {
+          memset(&buffer[pos], 0, ncopy);
+        }
+    }
 
-  memcpy(buffer, &tfo->tfo_data[startpos], nread);
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1513,9 +1725,12 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
                            size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nwritten;
   off_t startpos;
   off_t endpos;
+  size_t offset;
+  size_t ncopy;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1537,23 +1752,50 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
   /* Handle attempts to write beyond the end of the file */
 
   startpos = filep->f_pos;
-  nwritten = buflen;
   endpos   = startpos + buflen;
 
   if (endpos > tfo->tfo_size)
     {
-      /* Reallocate the file to handle the write past the end of the file. */
+      /* Grow the page table to handle the write past the end of the file.
+       * Any gap between the end of the file and the write is left as a
+       * hole.
+       */
 
-      ret = tmpfs_realloc_file(tfo, (size_t)endpos);
+      ret = tmpfs_realloc_pages(tfo, TMPFS_NPAGES((size_t)endpos));
       if (ret < 0)
         {
           goto errout_with_lock;
         }
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the user buffer to the memory object one page at a
+   * time, allocating the pages that are written for the first time.
+   */
+
+  for (nwritten = 0; (size_t)nwritten < buflen; nwritten += ncopy)
+    {
+      page = tmpfs_alloc_page(tfo, TMPFS_PAGE(startpos + nwritten));
+      if (page == NULL)
+        {
+          break;
+        }
+
+      offset = TMPFS_PAGEOFF(startpos + nwritten);
+      ncopy  = MIN(TMPFS_PAGESIZE - offset, buflen - (size_t)nwritten);
+      memcpy(&page[offset], &buffer[nwritten], ncopy);
+    }
+
+  if (nwritten == 0 && buflen > 0)
+    {
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  if ((size_t)(startpos + nwritten) > tfo->tfo_size)
+    {
+      tfo->tfo_size = startpos + nwritten;
+    }
 
-  memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
   filep->f_pos += nwritten;
 
   /* Release the lock on the file */
@@ -1634,6 +1876,7 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   FAR struct tmpfs_file_s *tfo;
   FAR void **ppv = (FAR void**)arg;
+  int ret;
 
   finfo("filep: %p cmd: %d arg: %08lx\n", filep, cmd, arg);
   DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
@@ -1649,11 +1892,23 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   if (cmd == FIOC_MMAP && ppv != NULL)
     {
       /* Return the address on the media corresponding to the start of
-       * the file.
+       * the file.  The pages of the file have to be contiguous for that.
        */
 
-      *ppv = (FAR void *)tfo->tfo_data;
-      return OK;
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = tmpfs_map_file(tfo);
+      if (ret >= 0)
+        {
+          *ppv = (FAR void *)tfo->tfo_run;
+        }
+
+      tmpfs_unlock_file(tfo);
+      return ret;
     }
 
   ferr("ERROR: Invalid cmd: %d\n", cmd);
@@ -1754,7 +2009,6 @@ static int tmpfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 static int tmpfs_truncate(FAR struct file *filep, off_t length)
 {
   FAR struct tmpfs_file_s *tfo;
-  size_t oldsize;
   int ret;
 
   finfo("filep: %p length: %ld\n", filep, (long)length);
@@ -1772,36 +2026,20 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
       return ret;
     }
 
-  /* Get the old size of the file.  Do nothing if the file size is not
-   * changing.
-   */
+  /* Do nothing if the file size is not changing. */
 
-  oldsize = tfo->tfo_size;
-  if (oldsize != length)
+  if (tfo->tfo_size != length)
     {
-      /* The size is changing.. up or down.  Reallocate the file memory. */
-
-      ret = tmpfs_realloc_file(tfo, (size_t)length);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-
-      /* If the size has increased, then we need to zero the newly added
-       * memory.
+      /* The size is changing.. up or down.  Reallocate the file memory.
+       * The pages added past the old end of the file are holes, which
+       * read as zeros.
        */
 
-      if (length > oldsize)
-        {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
-        }
-
-      ret = OK;
+      ret = tmpfs_realloc_file(tfo, (size_t)length);
     }
 
   /* Release the lock on the file */
 
-errout_with_lock:
   tmpfs_unlock_file(tfo);
   return ret;
 }
@@ -2237,7 +2475,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_release_pages(tfo, 0);
       kmm_free(tfo);
     }
 
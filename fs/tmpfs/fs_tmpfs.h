@@ -115,15 +115,18 @@ struct tmpfs_file_s
 
   rmutex_t tfo_lock;
 
-  size_t   tfo_alloc;    /* Allocated size of the file object */
+  size_t   tfo_alloc;    /* Allocated size of the file data */
   uint8_t  tfo_type;     /* See enum tmpfs_objtype_e */
   uint8_t  tfo_refs;     /* Reference count */
 
   /* Remaining fields are unique to a directory object */
 
-  uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
-  size_t        tfo_size;  /* Valid file size */
-  FAR uint8_t  *tfo_data;  /* File data starts here */
+  uint8_t       tfo_flags;  /* See TFO_FLAG_* definitions */
+  size_t        tfo_size;   /* Valid file size */
+  size_t        tfo_npages; /* Number of entries in the page table */
+  size_t        tfo_nrun;   /* Number of pages backed by tfo_run */
+  FAR uint8_t **tfo_pages;  /* Page table, NULL entries are holes */
+  FAR uint8_t  *tfo_run;    /* Contiguous data of the first pages */
 };
 
 /* This structure represents one instance of a TMPFS file system */
@@ -65,6 +65,10 @@ int file_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Remove the file from the interest lists of the epoll instances */
+
+      epoll_fileclose(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
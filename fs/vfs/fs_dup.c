@@ -110,7 +110,9 @@ int nx_dup(int fd)
 
   /* Let file_dup() do the real work */
 
-  return file_dup(filep, 0);
+  ret = file_dup(filep, 0);
+  fs_putfilep(filep);
+  return ret;
 }
 
 /****************************************************************************
@@ -83,6 +83,11 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
   temp.f_pos    = filep1->f_pos;
   temp.f_inode  = inode;
   temp.f_priv   = NULL;
+  temp.f_refs   = 0;
+  temp.f_closed = false;
+  temp.f_alloc  = false;
+  temp.f_dup    = NULL;
+  temp.f_list   = NULL;
 
   /* Call the open method on the file, driver, mountpoint so that it
    * can maintain the correct open counts.
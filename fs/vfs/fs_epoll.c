@@ -28,32 +28,74 @@
 
 #include <inttypes.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <poll.h>
+#include <queue.h>
 #include <errno.h>
 #include <string.h>
 #include <debug.h>
 #include <semaphore.h>
 
+#include <nuttx/nuttx.h>
+#include <nuttx/irq.h>
 #include <nuttx/clock.h>
+#include <nuttx/signal.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Event bits that select the reporting mode rather than an event */
+
+#define EPOLL_MODEMASK (EPOLLET | EPOLLONESHOT | EPOLLWAKEUP)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* One registered file descriptor.  Its pollfd stays set up with the driver
+ * from EPOLL_CTL_ADD until EPOLL_CTL_DEL, and the driver reports events
+ * through epoll_callback(), which puts the node on the ready list.  As on
+ * Linux, closing the file removes it from the interest list as well, see
+ * epoll_fileclose().
+ */
+
+struct epoll_head;
+
+struct epoll_node
+{
+  dq_entry_t node;                 /* Link in the setup or free list */
+  FAR struct epoll_node *rdnext;   /* Link in the ready list */
+  FAR struct epoll_head *eph;      /* The epoll instance */
+  FAR struct file *filep;          /* The file being polled */
+  struct pollfd pfd;               /* Registered with the driver */
+  epoll_data_t data;               /* Returned with the events */
+  uint32_t mode;                   /* EPOLLET and EPOLLONESHOT */
+  bool armed;                      /* pfd is set up with the driver */
+  bool ready;                      /* The node is on the ready list */
+};
+
 struct epoll_head
 {
+  dq_entry_t link;                 /* Link in g_epoll_list */
   int size;
-  int occupied;
   int crefs;
-  sem_t sem;
-  struct file fp;
-  struct inode in;
-  FAR epoll_data_t *data;
-  FAR struct pollfd *poll;
+  sem_t sem;                       /* Protects the node lists */
+  sem_t waitsem;                   /* Posted when a node becomes ready */
+  dq_queue_t setup;                /* The registered nodes */
+  dq_queue_t free;                 /* The unused nodes */
+
+  /* The ready list is also changed by the drivers, possibly from interrupt
+   * handlers, so it is protected by a critical section.
+   */
+
+  FAR struct epoll_node *rdhead;
+  FAR struct epoll_node *rdtail;
 };
 
 /****************************************************************************
@@ -83,6 +125,11 @@ static const struct file_operations g_epoll_ops =
 #endif
 };
 
+/* All epoll instances, protected by g_epoll_sem */
+
+static dq_queue_t g_epoll_list;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
 static struct inode g_epoll_inode =
 {
   NULL,                   /* i_parent */
@@ -101,6 +148,7 @@ static struct inode g_epoll_inode =
 
 static FAR struct epoll_head *epoll_head_from_fd(int fd)
 {
+  FAR struct epoll_head *eph;
   FAR struct file *filep;
   int ret;
 
@@ -117,11 +165,360 @@ static FAR struct epoll_head *epoll_head_from_fd(int fd)
 
   if (!filep->f_inode || filep->f_inode->u.i_ops != &g_epoll_ops)
     {
+      fs_putfilep(filep);
       set_errno(EBADF);
       return NULL;
     }
 
-  return (FAR struct epoll_head *)filep->f_priv;
+  eph = (FAR struct epoll_head *)filep->f_priv;
+  fs_putfilep(filep);
+  return eph;
+}
+
+/****************************************************************************
+ * Name: epoll_enqueue
+ *
+ * Description:
+ *   Append a node to the ready list unless it is already there.
+ *   Interrupts must be disabled.
+ *
+ ****************************************************************************/
+
+static void epoll_enqueue(FAR struct epoll_head *eph,
+                          FAR struct epoll_node *epn)
+{
+  if (!epn->ready)
+    {
+      epn->ready  = true;
+      epn->rdnext = NULL;
+
+      if (eph->rdtail != NULL)
+        {
+          eph->rdtail->rdnext = epn;
+        }
+      else
+        {
+          eph->rdhead = epn;
+        }
+
+      eph->rdtail = epn;
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a node from the ready list if it is there.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR struct epoll_head *eph,
+                          FAR struct epoll_node *epn)
+{
+  FAR struct epoll_node *prev = NULL;
+  FAR struct epoll_node *curr;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (epn->ready)
+    {
+      for (curr = eph->rdhead; curr != NULL && curr != epn;
+           curr = curr->rdnext)
+        {
+          prev = curr;
+        }
+
+      if (curr != NULL)
+        {
+          if (prev != NULL)
+            {
+              prev->rdnext = epn->rdnext;
+            }
+          else
+            {
+              eph->rdhead = epn->rdnext;
+            }
+
+          if (eph->rdtail == epn)
+            {
+              eph->rdtail = prev;
+            }
+        }
+
+      epn->ready = false;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_callback
+ *
+ * Description:
+ *   Called by poll_notify() when the driver reports events on a registered
+ *   node.  This may run in an interrupt handler.
+ *
+ ****************************************************************************/
+
+static void epoll_callback(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node *epn = container_of(fds, struct epoll_node, pfd);
+  FAR struct epoll_head *eph = epn->eph;
+  irqstate_t flags;
+  int semcount;
+
+  flags = enter_critical_section();
+  epoll_enqueue(eph, epn);
+
+  nxsem_get_value(&eph->waitsem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&eph->waitsem);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Set up the pollfd of a node with its driver.  If the requested events
+ *   are already pending, the driver reports them right away and the node
+ *   is queued.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_node *epn)
+{
+  int ret;
+
+  epn->pfd.revents = 0;
+  ret = file_poll(epn->filep, &epn->pfd, true);
+  epn->armed = ret >= 0;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_teardown
+ *
+ * Description:
+ *   Detach the pollfd of a node from its driver and drop any pending
+ *   report.
+ *
+ ****************************************************************************/
+
+static void epoll_teardown(FAR struct epoll_node *epn)
+{
+  if (epn->armed)
+    {
+      file_poll(epn->filep, &epn->pfd, false);
+      epn->armed = false;
+    }
+
+  epoll_unready(epn->eph, epn);
+  epn->pfd.revents = 0;
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Return the node registered for a file descriptor and the file it
+ *   refers to, or NULL.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_node *epoll_find(FAR struct epoll_head *eph, int fd,
+                                         FAR struct file *filep)
+{
+  FAR struct epoll_node *epn;
+
+  for (epn = (FAR struct epoll_node *)dq_peek(&eph->setup);
+       epn != NULL;
+       epn = (FAR struct epoll_node *)dq_next(&epn->node))
+    {
+      if (epn->pfd.fd == fd && epn->filep == filep)
+        {
+          return epn;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_drain
+ *
+ * Description:
+ *   Move up to maxevents ready nodes into the event array and return their
+ *   number.  Only the ready nodes are visited, except when the caller was
+ *   woken up with an empty ready list: some drivers still post the
+ *   semaphore directly instead of calling poll_notify(), so the registered
+ *   nodes are then scanned for reported events.
+ *
+ ****************************************************************************/
+
+static int epoll_drain(FAR struct epoll_head *eph,
+                       FAR struct epoll_event *evs, int maxevents,
+                       bool scan)
+{
+  FAR struct epoll_node *list;
+  FAR struct epoll_node *epn;
+  irqstate_t flags;
+  int n = 0;
+
+  flags = enter_critical_section();
+  if (eph->rdhead == NULL && scan)
+    {
+      for (epn = (FAR struct epoll_node *)dq_peek(&eph->setup);
+           epn != NULL;
+           epn = (FAR struct epoll_node *)dq_next(&epn->node))
+        {
+          if (epn->armed && epn->pfd.revents != 0)
+            {
+              epoll_enqueue(eph, epn);
+            }
+        }
+    }
+
+  list        = eph->rdhead;
+  eph->rdhead = NULL;
+  eph->rdtail = NULL;
+  leave_critical_section(flags);
+
+  while (list != NULL && n < maxevents)
+    {
+      epn  = list;
+      list = epn->rdnext;
+
+      flags = enter_critical_section();
+      epn->ready = false;
+      leave_critical_section(flags);
+
+      if (epn->pfd.revents == 0)
+        {
+          continue;
+        }
+
+      evs[n].events = epn->pfd.revents;
+      evs[n].data   = epn->data;
+      n++;
+
+      if ((epn->mode & EPOLLONESHOT) != 0)
+        {
+          /* Disabled until the next EPOLL_CTL_MOD */
+
+          epoll_teardown(epn);
+        }
+      else
+        {
+          /* Re-arm the node, some drivers only report once per setup.  The
+           * reported events are dropped before, not after the setup: a
+           * node that is still ready, or that gets a new event while it is
+           * set up again, is queued again by the setup and must stay
+           * queued.  This also holds for an edge-triggered node, where
+           * losing an edge would be worse than reporting it twice.
+           */
+
+          epoll_teardown(epn);
+          epoll_setup(epn);
+        }
+    }
+
+  if (list != NULL)
+    {
+      /* Out of room, put the rest back at the head of the ready list */
+
+      for (epn = list; epn->rdnext != NULL; epn = epn->rdnext)
+        {
+        }
+
+      flags = enter_critical_section();
+      epn->rdnext = eph->rdhead;
+      if (eph->rdhead == NULL)
+        {
+          eph->rdtail = epn;
+        }
+
+      eph->rdhead = list;
+      leave_critical_section(flags);
+    }
+
+  return n;
+}
+
+/****************************************************************************
+ * Name: epoll_do_wait
+ *
+ * Description:
+ *   Wait until events are reported or the timeout (in milliseconds, or
+ *   negative for none) expires.  Returns the number of events or a negated
+ *   errno value.
+ *
+ ****************************************************************************/
+
+static int epoll_do_wait(FAR struct epoll_head *eph,
+                         FAR struct epoll_event *evs, int maxevents,
+                         int timeout)
+{
+  clock_t start = clock_systime_ticks();
+  clock_t delay = 0;
+  clock_t elapsed;
+  bool woken = false;
+  int ret;
+
+  if (timeout > 0)
+    {
+      delay = MSEC2TICK(timeout);
+      if (delay == 0)
+        {
+          delay = 1;
+        }
+    }
+
+  for (; ; )
+    {
+      ret = nxsem_wait(&eph->sem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = epoll_drain(eph, evs, maxevents, woken);
+      nxsem_post(&eph->sem);
+
+      if (ret > 0 || timeout == 0)
+        {
+          return ret;
+        }
+
+      if (timeout < 0)
+        {
+          ret = nxsem_wait(&eph->waitsem);
+        }
+      else
+        {
+          elapsed = clock_systime_ticks() - start;
+          ret = elapsed < delay ?
+                nxsem_tickwait(&eph->waitsem, delay - elapsed) :
+                -ETIMEDOUT;
+        }
+
+      if (ret == -ETIMEDOUT)
+        {
+          /* Collect whatever came in at the last moment */
+
+          timeout = 0;
+        }
+      else if (ret < 0)
+        {
+          return ret;
+        }
+
+      woken = true;
+    }
 }
 
 static int epoll_do_open(FAR struct file *filep)
@@ -143,6 +540,7 @@ static int epoll_do_open(FAR struct file *filep)
 static int epoll_do_close(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_priv;
+  FAR struct epoll_node *epn;
   int ret;
 
   ret = nxsem_wait(&eph->sem);
@@ -155,6 +553,24 @@ static int epoll_do_close(FAR struct file *filep)
   nxsem_post(&eph->sem);
   if (eph->crefs <= 0)
     {
+      /* Once off the list, epoll_fileclose() no longer visits the
+       * instance.
+       */
+
+      nxsem_wait_uninterruptible(&g_epoll_sem);
+      dq_rem(&eph->link, &g_epoll_list);
+      nxsem_post(&g_epoll_sem);
+
+      /* Detach all nodes from their drivers before freeing them */
+
+      while ((epn = (FAR struct epoll_node *)dq_remfirst(&eph->setup))
+             != NULL)
+        {
+          epoll_teardown(epn);
+        }
+
+      nxsem_destroy(&eph->waitsem);
+      nxsem_destroy(&eph->sem);
       kmm_free(eph);
     }
 
@@ -170,13 +586,19 @@ static int epoll_do_poll(FAR struct file *filep,
 static int epoll_do_create(int size, int flags)
 {
   FAR struct epoll_head *eph;
-  int reserve = size + 1;
+  FAR struct epoll_node *epn;
   int fd;
+  int i;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return -1;
+    }
 
   eph = (FAR struct epoll_head *)
         kmm_zalloc(sizeof(struct epoll_head) +
-                   sizeof(epoll_data_t) * reserve +
-                   sizeof(struct pollfd) * reserve);
+                   sizeof(struct epoll_node) * size);
   if (eph == NULL)
     {
       set_errno(ENOMEM);
@@ -185,23 +607,23 @@ static int epoll_do_create(int size, int flags)
 
   nxsem_init(&eph->sem, 0, 0);
   nxsem_set_protocol(&eph->sem, SEM_PRIO_NONE);
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_set_protocol(&eph->waitsem, SEM_PRIO_NONE);
   eph->size = size;
-  eph->data = (FAR epoll_data_t *)(eph + 1);
-  eph->poll = (FAR struct pollfd *)(eph->data + reserve);
-
-  INODE_SET_DRIVER(&eph->in);
-  eph->in.u.i_ops = &g_epoll_ops;
-  eph->fp.f_inode = &eph->in;
-  eph->in.i_private = eph;
 
-  eph->poll[0].ptr = &eph->fp;
-  eph->poll[0].events = POLLIN | POLLFILE;
+  epn = (FAR struct epoll_node *)(eph + 1);
+  for (i = 0; i < size; i++)
+    {
+      epn[i].eph = eph;
+      dq_addlast(&epn[i].node, &eph->free);
+    }
 
   /* Alloc the file descriptor */
 
   fd = files_allocate(&g_epoll_inode, flags, 0, eph, 0);
   if (fd < 0)
     {
+      nxsem_destroy(&eph->waitsem);
       nxsem_destroy(&eph->sem);
       kmm_free(eph);
       set_errno(-fd);
@@ -209,6 +631,11 @@ static int epoll_do_create(int size, int flags)
     }
 
   inode_addref(&g_epoll_inode);
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_addlast(&eph->link, &g_epoll_list);
+  nxsem_post(&g_epoll_sem);
+
   nxsem_post(&eph->sem);
   return fd;
 }
@@ -217,6 +644,61 @@ static int epoll_do_create(int size, int flags)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: epoll_fileclose
+ *
+ * Description:
+ *   Remove a file that is being closed from the interest list of every
+ *   epoll instance, so that no node refers to it or to its descriptor
+ *   afterwards.
+ *
+ * Input Parameters:
+ *   filep - The file being closed
+ *
+ ****************************************************************************/
+
+void epoll_fileclose(FAR struct file *filep)
+{
+  FAR struct epoll_head *eph;
+  FAR struct epoll_node *epn;
+  FAR struct epoll_node *next;
+
+  /* Most systems have no epoll instance at all, do not take the
+   * semaphore on every close for them.
+   */
+
+  if (dq_empty(&g_epoll_list))
+    {
+      return;
+    }
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+
+  for (eph = (FAR struct epoll_head *)dq_peek(&g_epoll_list);
+       eph != NULL;
+       eph = (FAR struct epoll_head *)dq_next(&eph->link))
+    {
+      nxsem_wait_uninterruptible(&eph->sem);
+
+      for (epn = (FAR struct epoll_node *)dq_peek(&eph->setup);
+           epn != NULL;
+           epn = next)
+        {
+          next = (FAR struct epoll_node *)dq_next(&epn->node);
+          if (epn->filep == filep)
+            {
+              epoll_teardown(epn);
+              dq_rem(&epn->node, &eph->setup);
+              dq_addlast(&epn->node, &eph->free);
+            }
+        }
+
+      nxsem_post(&eph->sem);
+    }
+
+  nxsem_post(&g_epoll_sem);
+}
+
 /****************************************************************************
  * Name: epoll_create
  *
@@ -269,6 +751,9 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a file descriptor of the interest list.  The
+ *   file stays registered with its driver until it is removed, the file is
+ *   closed or the epoll instance is closed.
  *
  * Input Parameters:
  *
@@ -279,7 +764,9 @@ void epoll_close(int epfd)
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 {
   FAR struct epoll_head *eph;
-  int i;
+  FAR struct epoll_node *epn;
+  FAR struct file *filep;
+  int ret;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -287,88 +774,112 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
       return -1;
     }
 
+  /* A node is only found for the file that the descriptor refers to now,
+   * not for an earlier file that had the same descriptor.  The reference
+   * is only held during the call.
+   */
+
+  ret = fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return -1;
+    }
+
+  ret = nxsem_wait(&eph->sem);
+  if (ret < 0)
+    {
+      fs_putfilep(filep);
+      set_errno(-ret);
+      return -1;
+    }
+
+  epn = epoll_find(eph, fd, filep);
+
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08" PRIx32 "\n",
-              epfd, eph->occupied, fd, ev->events);
-        if (eph->occupied >= eph->size)
+        finfo("%08x CTL ADD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+        if (epn != NULL)
           {
-            set_errno(ENOMEM);
-            return -1;
+            ret = -EEXIST;
+            break;
           }
 
-        for (i = 1; i <= eph->occupied; i++)
+        epn = (FAR struct epoll_node *)dq_remfirst(&eph->free);
+        if (epn == NULL)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                set_errno(EEXIST);
-                return -1;
-              }
+            ret = -ENOMEM;
+            break;
           }
 
-        eph->data[++eph->occupied]      = ev->data;
-        eph->poll[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->poll[eph->occupied].fd     = fd;
+        memset(&epn->pfd, 0, sizeof(struct pollfd));
+        epn->pfd.fd     = fd;
+        epn->pfd.events = (ev->events & ~EPOLL_MODEMASK) |
+                          POLLERR | POLLHUP;
+        epn->pfd.sem    = &eph->waitsem;
+        epn->pfd.cb     = epoll_callback;
+        epn->filep      = filep;
+        epn->data       = ev->data;
+        epn->mode       = ev->events & EPOLL_MODEMASK;
+
+        ret = epoll_setup(epn);
+        if (ret < 0)
+          {
+            dq_addlast(&epn->node, &eph->free);
+            break;
+          }
 
+        dq_addlast(&epn->node, &eph->setup);
         break;
 
       case EPOLL_CTL_DEL:
-        for (i = 1; i <= eph->occupied; i++)
-          {
-            if (eph->poll[i].fd == fd)
-              {
-                if (i != eph->occupied)
-                  {
-                    memmove(&eph->data[i], &eph->data[i + 1],
-                            sizeof(epoll_data_t) * (eph->occupied - i));
-                    memmove(&eph->poll[i], &eph->poll[i + 1],
-                            sizeof(struct pollfd) * (eph->occupied - i));
-                  }
-
-                break;
-              }
-          }
-
-        if (i > eph->occupied)
+        if (epn == NULL)
           {
-            set_errno(ENOENT);
-            return -1;
+            ret = -ENOENT;
+            break;
           }
 
-        eph->occupied--;
+        epoll_teardown(epn);
+        dq_rem(&epn->node, &eph->setup);
+        dq_addlast(&epn->node, &eph->free);
         break;
 
       case EPOLL_CTL_MOD:
-        finfo("%08x CTL MOD(%d): fd=%d ev=%08" PRIx32 "\n",
-              epfd, eph->occupied, fd, ev->events);
-        for (i = 1; i <= eph->occupied; i++)
+        finfo("%08x CTL MOD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+        if (epn == NULL)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                eph->data[i]        = ev->data;
-                eph->poll[i].events = ev->events | POLLERR | POLLHUP;
-                break;
-              }
-          }
-
-        if (i > eph->occupied)
-          {
-            set_errno(ENOENT);
-            return -1;
+            ret = -ENOENT;
+            break;
           }
 
+        epoll_teardown(epn);
+        epn->pfd.events = (ev->events & ~EPOLL_MODEMASK) |
+                          POLLERR | POLLHUP;
+        epn->data       = ev->data;
+        epn->mode       = ev->events & EPOLL_MODEMASK;
+        ret = epoll_setup(epn);
         break;
 
       default:
-        set_errno(EINVAL);
-        return -1;
+        ret = -EINVAL;
+        break;
     }
 
-  if (eph->poll[0].sem)
+  nxsem_post(&eph->sem);
+
+  /* Released without eph->sem, this may close the file and then remove it
+   * from the epoll instances.
+   */
+
+  fs_putfilep(filep);
+
+  if (ret < 0)
     {
-      eph->poll[0].revents |= eph->poll[0].events;
-      nxsem_post(eph->poll[0].sem);
+      set_errno(-ret);
+      return -1;
     }
 
   return 0;
@@ -376,18 +887,19 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 
 /****************************************************************************
  * Name: epoll_pwait
+ *
+ * Description:
+ *   Wait for events on the interest list.  Only the descriptors that
+ *   reported events since the last call are visited.
+ *
  ****************************************************************************/
 
 int epoll_pwait(int epfd, FAR struct epoll_event *evs,
                 int maxevents, int timeout, FAR const sigset_t *sigmask)
 {
   FAR struct epoll_head *eph;
-  struct timespec expire;
-  struct timespec curr;
-  struct timespec diff;
-  int counter;
-  int rc;
-  int i;
+  sigset_t oldmask;
+  int ret;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -395,61 +907,31 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
       return -1;
     }
 
-  if (timeout >= 0)
+  if (evs == NULL || maxevents <= 0)
     {
-      expire.tv_sec  = timeout / 1000;
-      expire.tv_nsec = timeout % 1000 * 1000;
-
-      clock_systime_timespec(&curr);
-      clock_timespec_add(&curr, &expire, &expire);
+      set_errno(EINVAL);
+      return -1;
     }
 
-again:
-  if (timeout < 0)
+  if (sigmask != NULL)
     {
-      rc = ppoll(eph->poll, eph->occupied + 1, NULL, sigmask);
-    }
-  else
-    {
-      clock_systime_timespec(&curr);
-      clock_timespec_subtract(&expire, &curr, &diff);
-
-      rc = ppoll(eph->poll, eph->occupied + 1, &diff, sigmask);
+      nxsig_procmask(SIG_SETMASK, sigmask, &oldmask);
     }
 
-  if (rc <= 0)
-    {
-      return rc;
-    }
-  else if (eph->poll[0].revents != 0)
-    {
-      if (--rc == 0)
-        {
-          goto again;
-        }
-    }
+  ret = epoll_do_wait(eph, evs, maxevents, timeout);
 
-  if (rc > maxevents)
+  if (sigmask != NULL)
     {
-      rc = maxevents;
+      nxsig_procmask(SIG_SETMASK, &oldmask, NULL);
     }
 
-  /* Iterate over non NULL event fds */
-
-  for (i = 0, counter = 1; i < rc && counter <= eph->occupied; counter++)
+  if (ret < 0)
     {
-      if (eph->poll[counter].revents != 0)
-        {
-          evs[i].data     = eph->data[counter];
-          evs[i++].events = eph->poll[counter].revents;
-          if (eph->poll[counter].events & EPOLLONESHOT)
-            {
-              eph->poll[counter].events = 0; /* Disable oneshot internally */
-            }
-        }
+      set_errno(-ret);
+      return -1;
     }
 
-  return i;
+  return ret;
 }
 
 /****************************************************************************
@@ -250,6 +250,7 @@ static int nx_vfcntl(int fd, int cmd, va_list ap)
        */
 
       ret = file_vfcntl(filep, cmd, ap);
+      fs_putfilep(filep);
     }
 
   return ret;
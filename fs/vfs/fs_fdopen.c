@@ -77,7 +77,7 @@ static inline int fs_checkfd(FAR struct tcb_s *tcb, int fd, int oflags)
     {
       /* No inode -- descriptor does not correspond to an open file */
 
-      return -ENOENT;
+      ret = -ENOENT;
     }
 
   /* Make sure that the inode supports the requested access.  In
@@ -86,16 +86,17 @@ static inline int fs_checkfd(FAR struct tcb_s *tcb, int fd, int oflags)
    * already been created.
    */
 
-  if (inode_checkflags(inode, oflags) != OK)
+  else if (inode_checkflags(inode, oflags) != OK)
     {
       /* Cannot support the requested access */
 
-      return -EACCES;
+      ret = -EACCES;
     }
 
   /* Looks good to me */
 
-  return OK;
+  fs_putfilep(filep);
+  return ret;
 }
 
 /****************************************************************************
@@ -262,6 +262,7 @@ int fstat(int fd, FAR struct stat *buf)
   /* Perform the fstat operation */
 
   ret = file_fstat(filep, buf);
+  fs_putfilep(filep);
 
   /* Check if the fstat operation was successful */
 
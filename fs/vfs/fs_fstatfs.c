@@ -118,6 +118,8 @@ int fstatfs(int fd, FAR struct statfs *buf)
       ret            = OK;
     }
 
+  fs_putfilep(filep);
+
   /* Check if the fstat operation was successful */
 
   if (ret >= 0)
@@ -148,7 +148,9 @@ static int nx_vioctl(int fd, int req, va_list ap)
 
   /* Let file_vioctl() do the real work. */
 
-  return file_vioctl(filep, req, ap);
+  ret = file_vioctl(filep, req, ap);
+  fs_putfilep(filep);
+  return ret;
 }
 
 /****************************************************************************
@@ -137,7 +137,9 @@ off_t nx_seek(int fd, off_t offset, int whence)
 
   /* Then let file_seek do the real work */
 
-  return file_seek(filep, offset, whence);
+  ret = file_seek(filep, offset, whence);
+  fs_putfilep(filep);
+  return ret;
 }
 
 /****************************************************************************
@@ -86,7 +86,9 @@ static int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup)
 
   /* Let file_poll() do the rest */
 
-  return file_poll(filep, fds, setup);
+  ret = file_poll(filep, fds, setup);
+  fs_putfilep(filep);
+  return ret;
 }
 
 /****************************************************************************
@@ -120,6 +122,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
       fds[i].events |= POLLERR | POLLHUP;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
@@ -331,7 +334,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
 
@@ -341,7 +344,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   else
     {
       fds->revents |= (POLLERR | POLLHUP);
-      nxsem_post(fds->sem);
+      poll_notify(fds);
 
       ret = OK;
     }
@@ -349,6 +352,37 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   return ret;
 }
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Wake up the waiter of a pollfd whose revents have been updated.  One
+ *   pending post is enough to wake poll(), so the semaphore count is not
+ *   raised any further.
+ *
+ * Input Parameters:
+ *   fds - The pollfd that has events to report
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds)
+{
+  int semcount;
+
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+  else if (fds->sem != NULL)
+    {
+      nxsem_get_value(fds->sem, &semcount);
+      if (semcount < 1)
+        {
+          nxsem_post(fds->sem);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: nx_poll
  *
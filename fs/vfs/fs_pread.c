@@ -143,6 +143,7 @@ ssize_t pread(int fd, FAR void *buf, size_t nbytes, off_t offset)
   /* Let file_pread do the real work */
 
   ret = file_pread(filep, buf, nbytes, offset);
+  fs_putfilep(filep);
   if (ret < 0)
     {
       goto errout;
@@ -335,10 +335,12 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
   ret = fs_getfilep(infd, &infile);
   if (ret < 0)
     {
-      goto errout;
+      goto errout_with_outfile;
     }
 
   ret = file_sendfile(outfile, infile, offset, count);
+  fs_putfilep(infile);
+  fs_putfilep(outfile);
   if (ret < 0)
     {
       goto errout;
@@ -346,6 +348,9 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 
   return ret;
 
+errout_with_outfile:
+  fs_putfilep(outfile);
+
 errout:
   set_errno(-ret);
   return ERROR;
@@ -190,7 +190,7 @@ static void timerfd_pollnotify(FAR struct timerfd_priv_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -652,7 +652,7 @@ int timerfd_settime(int fd, int flags,
   if (!filep->f_inode || filep->f_inode->u.i_ops != &g_timerfd_fops)
     {
       ret = -EINVAL;
-      goto errout;
+      goto errout_with_filep;
     }
 
   dev = (FAR struct timerfd_priv_s *)filep->f_inode->i_private;
@@ -696,6 +696,7 @@ int timerfd_settime(int fd, int flags,
   if (new_value->it_value.tv_sec <= 0 && new_value->it_value.tv_nsec <= 0)
     {
       spin_unlock_irqrestore(NULL, intflags);
+      fs_putfilep(filep);
       return OK;
     }
 
@@ -754,13 +755,17 @@ int timerfd_settime(int fd, int flags,
       if (ret < 0)
         {
           spin_unlock_irqrestore(&dev->lock, intflags);
-          goto errout;
+          goto errout_with_filep;
         }
     }
 
   spin_unlock_irqrestore(&dev->lock, intflags);
+  fs_putfilep(filep);
   return OK;
 
+errout_with_filep:
+  fs_putfilep(filep);
+
 errout:
   set_errno(-ret);
   return ERROR;
@@ -793,6 +798,7 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 
   if (!filep->f_inode || filep->f_inode->u.i_ops != &g_timerfd_fops)
     {
+      fs_putfilep(filep);
       ret = -EINVAL;
       goto errout;
     }
@@ -807,6 +813,7 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 
   clock_ticks2time(ticks, &curr_value->it_value);
   clock_ticks2time(dev->delay, &curr_value->it_interval);
+  fs_putfilep(filep);
   return OK;
 
 errout:
@@ -189,6 +189,7 @@ int ftruncate(int fd, off_t length)
   /* Perform the truncate operation */
 
   ret = file_truncate(filep, length);
+  fs_putfilep(filep);
   if (ret >= 0)
     {
       return 0;
@@ -136,6 +136,7 @@ ssize_t nx_write(int fd, FAR const void *buf, size_t nbytes)
        */
 
       ret = file_write(filep, buf, nbytes);
+      fs_putfilep(filep);
     }
 
   return ret;
@@ -37,6 +37,7 @@
 
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -412,12 +413,18 @@ struct inode
  * the file descriptor to the file state and to a set of inode operations.
  */
 
+struct filelist;
 struct file
 {
   int               f_oflags;   /* Open mode flags */
   off_t             f_pos;      /* File position */
   FAR struct inode *f_inode;    /* Driver or file system interface */
   FAR void         *f_priv;     /* Per file driver private data */
+  int16_t           f_refs;     /* References taken with fs_getfilep() */
+  bool              f_closed;   /* Closed, the last reference releases it */
+  bool              f_alloc;    /* Allocated by dup2(), see f_dup */
+  FAR struct file  *f_dup;      /* Installed by dup2() while in use */
+  FAR struct filelist *f_list;  /* The list that f_refs belong to */
 };
 
 /* This defines a two layer array of files indexed by the file descriptor.
@@ -430,6 +437,7 @@ struct file
 struct filelist
 {
   sem_t             fl_sem;     /* Manage access to the file list */
+  spinlock_t        fl_lock;    /* Protects lookups and file references */
   uint8_t           fl_rows;    /* The number of rows of fl_files array */
   FAR struct file **fl_files;   /* The pointer of two layer file descriptors array */
 };
@@ -892,6 +900,10 @@ int nx_open(FAR const char *path, int oflags, ...);
  *   file.  NOTE that this function will currently fail if it is provided
  *   with a socket descriptor.
  *
+ *   A reference to the file is taken, which must be released with
+ *   fs_putfilep().  If the file descriptor is closed in the meantime, the
+ *   file is closed when the last reference is released.
+ *
  * Input Parameters:
  *   fd    - The file descriptor
  *   filep - The location to return the struct file instance
@@ -904,6 +916,23 @@ int nx_open(FAR const char *path, int oflags, ...);
 
 int fs_getfilep(int fd, FAR struct file **filep);
 
+/****************************************************************************
+ * Name: fs_putfilep
+ *
+ * Description:
+ *   Release a reference to a file taken with fs_getfilep().
+ *
+ * Input Parameters:
+ *   filep - The file returned by fs_getfilep()
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned if
+ *   the file had been closed and closing it failed.
+ *
+ ****************************************************************************/
+
+int fs_putfilep(FAR struct file *filep);
+
 /****************************************************************************
  * Name: file_close
  *
@@ -1353,6 +1382,23 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
 int nx_poll(FAR struct pollfd *fds, unsigned int nfds, int timeout);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Wake up the waiter of a pollfd whose revents have been updated.  This
+ *   calls the pollfd callback if there is one, as set up by epoll, or
+ *   posts the pollfd semaphore otherwise.  Drivers should use this rather
+ *   than posting fds->sem themselves so that epoll can tell which
+ *   descriptor became ready.  It may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   fds - The pollfd that has events to report
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds);
+
 /****************************************************************************
  * Name: file_fstat
  *
@@ -26,6 +26,8 @@
  * For multiple writer and one reader there is only a need to lock the
  * writer. And vice versa for only one writer and multiple reader there is
  * only a need to lock the reader.
+ * struct circbuf_mpmc_s can be used by multiple readers and multiple
+ * writers without locking.
  */
 
 /****************************************************************************
@@ -50,6 +52,21 @@ struct circbuf_s
   bool      external; /* The flag for external buffer */
 };
 
+#ifdef CONFIG_MM_CIRCBUF_MPMC
+/* This structure describes a circular buffer shared by multiple readers
+ * and multiple writers.  circ.head and circ.tail are the positions up to
+ * which the data has been completely written and read; head and tail are
+ * the positions reserved by the writers and readers in progress.
+ */
+
+struct circbuf_mpmc_s
+{
+  struct circbuf_s circ; /* The completed part of the buffer */
+  size_t           head; /* The head reserved by the writers */
+  size_t           tail; /* The tail reserved by the readers */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -337,6 +354,163 @@ ssize_t circbuf_write(FAR struct circbuf_s *circ,
 ssize_t circbuf_overwrite(FAR struct circbuf_s *circ,
                            FAR const void *src, size_t bytes);
 
+/****************************************************************************
+ * Name: circbuf_get_writeptr
+ *
+ * Description:
+ *   Get the address where the next data can be written in place, and the
+ *   number of contiguous bytes that can be written there.  The data is
+ *   added to the buffer by circbuf_writecommit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of bytes that can be written.
+ *
+ * Returned Value:
+ *   The address where to write the data.
+ ****************************************************************************/
+
+FAR void *circbuf_get_writeptr(FAR struct circbuf_s *circ,
+                               FAR size_t *size);
+
+/****************************************************************************
+ * Name: circbuf_writecommit
+ *
+ * Description:
+ *   Add the data written in place at the address returned by
+ *   circbuf_get_writeptr() to the circular buffer.
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ        - Address of the circular buffer to be used.
+ *   writtensize - Number of bytes written, no more than returned by
+ *                 circbuf_get_writeptr().
+ ****************************************************************************/
+
+void circbuf_writecommit(FAR struct circbuf_s *circ, size_t writtensize);
+
+/****************************************************************************
+ * Name: circbuf_get_readptr
+ *
+ * Description:
+ *   Get the address of the oldest data in the buffer, and the number of
+ *   contiguous bytes that can be read there.  The data is removed from the
+ *   buffer by circbuf_readcommit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of bytes that can be read.
+ *
+ * Returned Value:
+ *   The address of the data.
+ ****************************************************************************/
+
+FAR void *circbuf_get_readptr(FAR struct circbuf_s *circ, FAR size_t *size);
+
+/****************************************************************************
+ * Name: circbuf_readcommit
+ *
+ * Description:
+ *   Remove the data read in place at the address returned by
+ *   circbuf_get_readptr() from the circular buffer.
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ     - Address of the circular buffer to be used.
+ *   readsize - Number of bytes read, no more than returned by
+ *              circbuf_get_readptr().
+ ****************************************************************************/
+
+void circbuf_readcommit(FAR struct circbuf_s *circ, size_t readsize);
+
+#ifdef CONFIG_MM_CIRCBUF_MPMC
+/****************************************************************************
+ * Name: circbuf_mpmc_init
+ *
+ * Description:
+ *   Initialize a circular buffer for multiple readers and writers.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ *   base  - A pointer to circular buffer's internal buffer, or NULL to
+ *           allocate a buffer of the given size.
+ *   bytes - The size of the internal buffer.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int circbuf_mpmc_init(FAR struct circbuf_mpmc_s *mpmc,
+                      FAR void *base, size_t bytes);
+
+/****************************************************************************
+ * Name: circbuf_mpmc_uninit
+ *
+ * Description:
+ *   Free the circular buffer.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ ****************************************************************************/
+
+void circbuf_mpmc_uninit(FAR struct circbuf_mpmc_s *mpmc);
+
+/****************************************************************************
+ * Name: circbuf_mpmc_read
+ *
+ * Description:
+ *   Get data from the circular buffer.  Any number of readers and writers
+ *   may use the buffer concurrently.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ *   dst   - Address where to store the data.
+ *   bytes - Number of bytes to get.
+ *
+ * Returned Value:
+ *   The bytes of get data is returned if the read data is successful;
+ *   A negated errno value is returned on any failure.
+ ****************************************************************************/
+
+ssize_t circbuf_mpmc_read(FAR struct circbuf_mpmc_s *mpmc,
+                          FAR void *dst, size_t bytes);
+
+/****************************************************************************
+ * Name: circbuf_mpmc_write
+ *
+ * Description:
+ *   Write data to the circular buffer.  Any number of readers and writers
+ *   may use the buffer concurrently.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ *   src   - The data to be added.
+ *   bytes - Number of bytes to be added.
+ *
+ * Returned Value:
+ *   The bytes of get data is returned if the write data is successful;
+ *   A negated errno value is returned on any failure.
+ ****************************************************************************/
+
+ssize_t circbuf_mpmc_write(FAR struct circbuf_mpmc_s *mpmc,
+                           FAR const void *src, size_t bytes);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
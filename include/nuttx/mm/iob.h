@@ -70,10 +70,52 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* Besides the pool of CONFIG_IOB_BUFSIZE byte buffers, there may be pools of
+ * medium and large buffers.  These are only used when a size is given to
+ * the allocation.
+ */
+
+#ifndef CONFIG_IOB_MEDIUM_NBUFFERS
+#  define CONFIG_IOB_MEDIUM_NBUFFERS 0
+#endif
+
+#ifndef CONFIG_IOB_LARGE_NBUFFERS
+#  define CONFIG_IOB_LARGE_NBUFFERS 0
+#endif
+
+#if CONFIG_IOB_MEDIUM_NBUFFERS > 0 || CONFIG_IOB_LARGE_NBUFFERS > 0
+#  define IOB_HAVE_CLASSES 1
+#endif
+
+#if CONFIG_IOB_MEDIUM_NBUFFERS > 0 && \
+    CONFIG_IOB_MEDIUM_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_MEDIUM_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0 && \
+    CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#endif
+
+#if CONFIG_IOB_MEDIUM_NBUFFERS > 0 && CONFIG_IOB_LARGE_NBUFFERS > 0 && \
+    CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_MEDIUM_BUFSIZE
+#  error CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_MEDIUM_BUFSIZE
+#endif
+
+#ifndef CONFIG_IOB_HEAP_NBUFFERS
+#  define CONFIG_IOB_HEAP_NBUFFERS 0
+#endif
+
 /* IOB helpers */
 
+#ifdef IOB_HAVE_CLASSES
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -99,16 +141,23 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#if CONFIG_IOB_BUFSIZE < 256 && !defined(IOB_HAVE_CLASSES)
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
   uint16_t io_len;      /* Length of the data in the entry */
   uint16_t io_offset;   /* Data begins at this offset */
+#endif
+#ifdef IOB_HAVE_CLASSES
+  uint16_t io_bufsize;  /* Size of io_data[], see IOB_BUFSIZE() */
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
+#ifdef IOB_HAVE_CLASSES
+  FAR uint8_t *io_data;
+#else
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
+#endif
 };
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -188,6 +237,9 @@ enum iob_user_e
 #ifdef CONFIG_NET_IPFORWARD
   IOBUSER_NET_IPFORWARD,
 #endif
+#ifdef CONFIG_NETDEV_IOB_RX
+  IOBUSER_NET_NETDEV_RX,
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   IOBUSER_WIRELESS_RAD802154,
 #endif
@@ -219,6 +271,16 @@ struct iob_userstats_s
   int totalproduced;
 };
 
+/* The state of one pool of I/O buffers of the same size */
+
+struct iob_classstats_s
+{
+  unsigned int bufsize;   /* Payload size of each buffer */
+  unsigned int ntotal;    /* Number of buffers, including those on the heap */
+  unsigned int nfree;     /* Number of free buffers */
+  unsigned int nheap;     /* Number of buffers allocated from the heap */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -272,6 +334,35 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid);
 
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer for about len bytes of data.  This is the
+ *   smallest medium or large I/O buffer that holds len bytes, else the
+ *   largest one available.  If len fits into a normal I/O buffer, or if
+ *   there are no larger ones available, this is the same as iob_alloc().
+ *
+ *   The medium and large buffers are never waited for and are not subject
+ *   to throttling.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(bool throttled, unsigned int len,
+                                 enum iob_user_e consumerid);
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Try to allocate an I/O buffer for about len bytes of data as
+ *   iob_alloc_size() does, but without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_size(bool throttled, unsigned int len,
+                                    enum iob_user_e consumerid);
+
 /****************************************************************************
  * Name: iob_navail
  *
@@ -645,5 +736,53 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
 FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid);
 #endif
 
+/****************************************************************************
+ * Name: iob_reassign
+ *
+ * Description:
+ *   Hand an I/O buffer chain over from one user to another.  For the IOB
+ *   statistics, the buffers are freed by the producer and allocated by the
+ *   consumer.
+ *
+ * Input Parameters:
+ *   iob        - The I/O buffer chain
+ *   producerid - id representing the user the chain was allocated for
+ *   consumerid - id representing the user that will free the chain
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_reassign(FAR struct iob_s *iob, enum iob_user_e producerid,
+                  enum iob_user_e consumerid);
+#else
+#  define iob_reassign(iob, producerid, consumerid)
+#endif
+
+/****************************************************************************
+ * Name: iob_getclassstats
+ *
+ * Description:
+ *   Return the state of one pool of I/O buffers.  The pool of normal I/O
+ *   buffers comes first, followed by the medium and large ones if they are
+ *   configured.
+ *
+ * Input Parameters:
+ *   index - The index of the pool, starting from zero
+ *   stats - The location to return the state of the pool
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no pool with that index.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+int iob_getclassstats(int index, FAR struct iob_classstats_s *stats);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __INCLUDE_NUTTX_MM_IOB_H */
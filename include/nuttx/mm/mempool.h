@@ -44,6 +44,16 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+/* The per-CPU stack of free blocks in front of the pool free list */
+
+struct mempool_magazine_s
+{
+  size_t    nblks;                                 /* Number of blocks */
+  FAR void *blks[CONFIG_MM_MEMPOOL_MAGAZINE_SIZE]; /* The free blocks */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -61,6 +71,9 @@ struct mempool_s
   size_t     nused;      /* The number of used block in mempool */
   spinlock_t lock;       /* The protect lock to mempool */
   sem_t      wait;       /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  struct mempool_magazine_s mag[CONFIG_SMP_NCPUS]; /* Per-CPU free blocks */
+#endif
 };
 
 struct mempoolinfo_s
@@ -71,6 +84,9 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  unsigned long ncached[CONFIG_SMP_NCPUS]; /* Free blocks per CPU magazine */
+#endif
 };
 
 /****************************************************************************
@@ -98,6 +98,20 @@
 
 struct mm_heap_s; /* Forward reference */
 
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+/* Statistics of the per-CPU small chunk caches in front of a heap */
+
+struct mm_cacheinfo_s
+{
+  unsigned long hits;    /* Allocations served from a CPU cache */
+  unsigned long misses;  /* Allocations that found the CPU cache empty */
+  unsigned long refills; /* Batches moved from the heap into a CPU cache */
+  unsigned long drains;  /* Batches moved from a CPU cache into the heap */
+  size_t ncached;        /* Chunks currently parked in the CPU caches */
+  size_t cached;         /* Bytes currently parked in the CPU caches */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -303,6 +317,13 @@ int mm_mallinfo_task(FAR struct mm_heap_s *heap,
                      FAR struct mallinfo_task *info);
 #endif
 
+/* Functions contained in mm_cpucache.c ************************************/
+
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_cacheinfo_s *info);
+#endif
+
 /* Functions contained in kmm_mallinfo.c ************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
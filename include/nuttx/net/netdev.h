@@ -52,6 +52,7 @@
 
 #include <sys/ioctl.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <queue.h>
 
 #include <net/if.h>
@@ -153,6 +154,55 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Checksum and segmentation offload.
+ *
+ * d_offload holds the NETDEV_OFFLOAD_* capabilities of the device.  They
+ * are set by the driver before the device is registered.
+ *
+ * d_pktflags holds the NETDEV_PKT_* state of the packet in d_buf:
+ *
+ *   NETDEV_PKT_TXCSUM    - Set by the network in an outgoing packet: the
+ *                          IPv4 header checksum and the TCP or UDP checksum
+ *                          are zero and must be filled in by the device.
+ *   NETDEV_PKT_TSO       - Set by the network in an outgoing TCP packet: the
+ *                          payload is larger than the MSS and must be sent
+ *                          as segments of d_tsosize bytes.  Implies
+ *                          NETDEV_PKT_TXCSUM.
+ *   NETDEV_PKT_RXCSUM_OK - Set by the driver in a received packet if the
+ *                          device has verified the IPv4 header checksum and
+ *                          the TCP or UDP checksum.
+ *
+ * A driver that advertises any offload must set d_pktflags for each packet
+ * that it passes to the network and clear it after each packet that it
+ * sends.  Drivers that cannot do all of it in hardware may use
+ * netdev_offload_txcsum() and netdev_offload_tso().
+ */
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define NETDEV_OFFLOAD_TXCSUM (1 << 0) /* Fills in TX checksums */
+#  define NETDEV_OFFLOAD_RXCSUM (1 << 1) /* Verifies RX checksums */
+#  define NETDEV_OFFLOAD_TSO    (1 << 2) /* Splits large TCP segments */
+
+#  define NETDEV_PKT_TXCSUM     (1 << 0) /* Checksums left to the device */
+#  define NETDEV_PKT_TSO        (1 << 1) /* Segmentation left to the device */
+#  define NETDEV_PKT_RXCSUM_OK  (1 << 2) /* Checksums verified */
+
+#  define NETDEV_TXCSUM_OFFLOADED(d) \
+     (((d)->d_pktflags & NETDEV_PKT_TXCSUM) != 0)
+#  define NETDEV_RXCSUM_VERIFIED(d) \
+     (((d)->d_pktflags & NETDEV_PKT_RXCSUM_OK) != 0)
+
+/* The largest packet that the network may put into d_buf */
+
+#  define NETDEV_MAXPKTSIZE(d) \
+     (((d)->d_offload & NETDEV_OFFLOAD_TSO) != 0 ? \
+      (d)->d_tsomax : NETDEV_PKTSIZE(d))
+#else
+#  define NETDEV_TXCSUM_OFFLOADED(d) (false)
+#  define NETDEV_RXCSUM_VERIFIED(d)  (false)
+#  define NETDEV_MAXPKTSIZE(d)       NETDEV_PKTSIZE(d)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -256,6 +306,15 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Checksum and segmentation offload, see NETDEV_OFFLOAD_* above */
+
+  uint8_t  d_offload;           /* Offload capabilities of the device */
+  uint8_t  d_pktflags;          /* Offload state of the packet in d_buf */
+  uint16_t d_tsosize;           /* Segment payload size with NETDEV_PKT_TSO */
+  uint16_t d_tsomax;            /* Maximum packet size with TSO */
+#endif
+
   /* Link layer address */
 
   union
@@ -305,6 +364,18 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* If the driver receives into I/O buffers, d_iob is the I/O buffer that
+   * holds d_buf (see netdev_iob_prepare()).  The network may take this
+   * buffer over to queue the received payload without copying it.  It then
+   * leaves a new I/O buffer in d_iob, with d_buf pointing into it and
+   * holding the same headers, so the driver must always re-read both
+   * fields after ipv4_input() or ipv6_input() returns.
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -344,6 +415,12 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+  /* The raw checksum of the d_sndlen bytes at d_appdata if they were summed
+   * while they were copied there, zero if unknown.
+   */
+
+  uint16_t d_sndsum;
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -617,6 +694,97 @@ int netdev_ifdown(FAR struct net_driver_s *dev);
 int netdev_carrier_on(FAR struct net_driver_s *dev);
 int netdev_carrier_off(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device owns an I/O buffer large enough to hold one
+ *   packet and point d_buf at its start.  A driver that supports zero-copy
+ *   receive calls this before it copies or DMAs the next frame into d_buf.
+ *
+ * Input Parameters:
+ *   dev       - The device driver structure
+ *   throttled - An indication of the I/O buffer may be throttled
+ *
+ * Returned Value:
+ *   OK on success; -EMSGSIZE if a packet does not fit into an I/O buffer or
+ *   -ENOMEM if no I/O buffer is available.  In either case d_buf is not
+ *   modified and the driver should fall back to its own packet buffer.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Release the I/O buffer owned by the device, e.g. when it is brought
+ *   down.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+void netdev_iob_release(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_offload_txcsum
+ *
+ * Description:
+ *   Fill in the checksums of the outgoing packet in d_buf if they have been
+ *   left to the device (NETDEV_PKT_TXCSUM).  This is the software fallback
+ *   for devices that cannot compute them.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+void netdev_offload_txcsum(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_offload_tso
+ *
+ * Description:
+ *   Send the outgoing packet in d_buf with xmit.  If its segmentation has
+ *   been left to the device (NETDEV_PKT_TSO), the packet is split into
+ *   segments in place and xmit is called once for each segment, with d_buf
+ *   and d_len describing that segment.  The checksums of the segments are
+ *   left to the device if it has NETDEV_OFFLOAD_TXCSUM and are computed
+ *   here otherwise.
+ *
+ *   xmit must be done with d_buf when it returns.  d_buf and d_len are
+ *   restored and d_pktflags is cleared before returning.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure
+ *   xmit - The function that sends one packet
+ *
+ * Returned Value:
+ *   The value returned by the last call to xmit.  Segmentation stops early
+ *   if xmit returns a negated errno value.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+int netdev_offload_tso(FAR struct net_driver_s *dev,
+                       devif_poll_callback_t xmit);
+#endif
+
 /****************************************************************************
  * Name: net_ioctl_arglen
  *
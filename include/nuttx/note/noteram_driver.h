@@ -50,6 +50,9 @@
  *                          noteram_get_taskname_s
  *                Result:   If -ESRCH, the corresponding task name doesn't
  *                          exist.
+ * NOTERAM_GETOVERRUN
+ *              - Get the number of notes lost before they were read
+ *                Argument: A writable pointer to unsigned int
  */
 
 #ifdef CONFIG_DRIVER_NOTERAM
@@ -59,6 +62,7 @@
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
 #define NOTERAM_GETTASKNAME     _NOTERAMIOC(0x04)
 #endif
+#define NOTERAM_GETOVERRUN      _NOTERAMIOC(0x05)
 #endif
 
 /* Overwrite mode definitions */
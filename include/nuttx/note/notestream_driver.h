@@ -0,0 +1,92 @@
+/****************************************************************************
+ * include/nuttx/note/notestream_driver.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NOTE_NOTESTREAM_DRIVER_H
+#define __INCLUDE_NUTTX_NOTE_NOTESTREAM_DRIVER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The stream starts with struct notestream_header_s, which describes the
+ * layout of the notes that follow it.  The notes are the note structures
+ * of sched_note.h, back to back, each starting with its length.  All
+ * multi-byte values are little endian.
+ */
+
+#define NOTESTREAM_MAGIC        "NXNS"
+#define NOTESTREAM_VERSION      1
+
+#define NOTESTREAM_FLAG_SMP     (1 << 0) /* Notes have nc_cpu */
+#define NOTESTREAM_FLAG_HIRES   (1 << 1) /* Notes have seconds and nsecs */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct notestream_header_s
+{
+  uint8_t nsh_magic[4];          /* NOTESTREAM_MAGIC */
+  uint8_t nsh_version;           /* NOTESTREAM_VERSION */
+  uint8_t nsh_flags;             /* See NOTESTREAM_FLAG_* */
+  uint8_t nsh_pidsize;           /* sizeof(pid_t) */
+  uint8_t nsh_ptrsize;           /* sizeof(uintptr_t) */
+  uint8_t nsh_timesize[2];       /* sizeof(time_t) and sizeof(long) with
+                                  * NOTESTREAM_FLAG_HIRES, sizeof(clock_t)
+                                  * and zero otherwise */
+  uint8_t nsh_usecpertick[4];    /* Length of a clock tick in microseconds */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#if defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT)
+
+/****************************************************************************
+ * Name: notestream_initialize
+ *
+ * Description:
+ *   Start the thread that streams the notes to
+ *   CONFIG_DRIVER_NOTESTREAM_PATH.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero on success. A negated errno value is returned on a failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVER_NOTESTREAM
+int notestream_initialize(void);
+#endif
+
+#endif /* defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT) */
+
+#endif /* __INCLUDE_NUTTX_NOTE_NOTESTREAM_DRIVER_H */
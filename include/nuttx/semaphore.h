@@ -51,6 +51,28 @@
     {(c)}                               /* semcount, flags */
 #endif /* CONFIG_PRIORITY_INHERITANCE */
 
+/* With CONFIG_SEM_FASTPATH, the semaphore count is changed outside of the
+ * critical section by the uncontended paths of nxsem_wait(),
+ * nxsem_trywait() and nxsem_post(), so every other change of the count
+ * must be atomic as well.  This includes the code outside of sched/ that
+ * adjusts the count of a counting semaphore directly, like the IOB pool.
+ * nxsem_count_dec() returns the count before the decrement and
+ * nxsem_count_inc() the count after the increment.
+ */
+
+#ifdef CONFIG_SEM_FASTPATH
+#  define nxsem_count_dec(s) \
+     __atomic_fetch_sub(&(s)->semcount, 1, __ATOMIC_ACQUIRE)
+#  define nxsem_count_inc(s) \
+     __atomic_add_fetch(&(s)->semcount, 1, __ATOMIC_RELEASE)
+#  define nxsem_count_set(s,c) \
+     __atomic_store_n(&(s)->semcount, (c), __ATOMIC_RELEASE)
+#else
+#  define nxsem_count_dec(s)   ((s)->semcount--)
+#  define nxsem_count_inc(s)   (++(s)->semcount)
+#  define nxsem_count_set(s,c) ((s)->semcount = (c))
+#endif
+
 /* Most internal nxsem_* interfaces are not available in the user space in
  * PROTECTED and KERNEL builds.  In that context, the application semaphore
  * interfaces must be used.  The differences between the two sets of
@@ -484,6 +484,21 @@ void uart_recvchars_dma(FAR uart_dev_t *dev);
 void uart_recvchars_done(FAR uart_dev_t *dev);
 #endif
 
+/****************************************************************************
+ * Name: uart_recvchars_idle
+ *
+ * Description:
+ *  Hand the bytes received so far by an RX DMA transfer to the readers and
+ *  start a new transfer into the rest of the RX circular buffer.  Called
+ *  by the lower half on an RX idle-line or timeout event, after stopping
+ *  the transfer in progress.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_idle(FAR uart_dev_t *dev, size_t nbytes);
+#endif
+
 /****************************************************************************
  * Name: uart_reset_sem
  *
@@ -256,8 +256,29 @@ struct work_s
   } u;
   worker_t  worker;         /* Work callback */
   FAR void *arg;            /* Callback argument */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  uint32_t  ready;          /* Time (usec) the work became ready to run */
+#endif
 };
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+/* Statistics of one kernel worker thread, as returned by work_stats().
+ * Times are in microseconds.
+ */
+
+struct work_stats_s
+{
+  pid_t    pid;             /* The task ID of the worker thread */
+  int      cpu;             /* CPU the worker is bound to, or -1 */
+  uint32_t nrun;            /* Number of work items run */
+  uint32_t nstolen;         /* Number of those taken from another CPU */
+  uint32_t maxwait;         /* Longest queue-to-start time */
+  uint64_t totalwait;       /* Sum of the queue-to-start times */
+  uint32_t maxrun;          /* Longest run time */
+  uint64_t totalrun;        /* Sum of the run times */
+};
+#endif
+
 /* This is an enumeration of the various events that may be
  * notified via work_notifier_signal().
  */
@@ -404,6 +425,29 @@ int work_cancel(int qid, FAR struct work_s *work);
 
 void work_foreach(int qid, work_foreach_t handler, FAR void *arg);
 
+/****************************************************************************
+ * Name: work_stats
+ *
+ * Description:
+ *   Return the statistics of one worker thread of a kernel work queue.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID (must be HPWORK or LPWORK)
+ *   wndx  - The index of the worker thread in the queue
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure:
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *   -ENOENT - There is no such worker thread
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_stats(int qid, int wndx, FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: work_available
  *
@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,6 +52,38 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 {
   FAR const unsigned char *p = (FAR const unsigned char *)s;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  uintptr_t mask = LIBC_WORDREPEAT(c);
+  uintptr_t word;
+
+  /* Align, then look for a word that holds the byte.  The xor turns the
+   * matching bytes into zero bytes.
+   */
+
+  while (n > 0 && LIBC_WORDOFFSET(p) != 0)
+    {
+      if (*p == (unsigned char)c)
+        {
+          return (FAR void *)p;
+        }
+
+      p++;
+      n--;
+    }
+
+  while (n >= LIBC_WORDSIZE)
+    {
+      word = *(FAR const uintptr_t *)p ^ mask;
+      if (LIBC_WORDHASZERO(word))
+        {
+          break;
+        }
+
+      p += LIBC_WORDSIZE;
+      n -= LIBC_WORDSIZE;
+    }
+#endif
+
   while (n--)
     {
       if (*p == (unsigned char)c)
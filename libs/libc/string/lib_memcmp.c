@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -38,6 +41,36 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  /* Skip the leading equal words, the bytes of the first different word
+   * are compared below.
+   */
+
+  if (n >= 2 * LIBC_WORDSIZE &&
+      LIBC_WORDOFFSET(p1) == LIBC_WORDOFFSET(p2))
+    {
+      while (LIBC_WORDOFFSET(p1) != 0)
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      while (n >= LIBC_WORDSIZE &&
+             *(FAR uintptr_t *)p1 == *(FAR uintptr_t *)p2)
+        {
+          p1 += LIBC_WORDSIZE;
+          p2 += LIBC_WORDSIZE;
+          n  -= LIBC_WORDSIZE;
+        }
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
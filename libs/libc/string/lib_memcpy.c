@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -41,6 +44,47 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  /* Copy whole words if both pointers can be word aligned together */
+
+  if (n >= 2 * LIBC_WORDSIZE &&
+      LIBC_WORDOFFSET(pout) == LIBC_WORDOFFSET(pin))
+    {
+      FAR uintptr_t *wout;
+      FAR uintptr_t *win;
+
+      while (LIBC_WORDOFFSET(pout) != 0)
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR uintptr_t *)pout;
+      win  = (FAR uintptr_t *)pin;
+
+      while (n >= 4 * LIBC_WORDSIZE)
+        {
+          wout[0] = win[0];
+          wout[1] = win[1];
+          wout[2] = win[2];
+          wout[3] = win[3];
+          wout   += 4;
+          win    += 4;
+          n      -= 4 * LIBC_WORDSIZE;
+        }
+
+      while (n >= LIBC_WORDSIZE)
+        {
+          *wout++ = *win++;
+          n      -= LIBC_WORDSIZE;
+        }
+
+      pout = (FAR unsigned char *)wout;
+      pin  = (FAR unsigned char *)win;
+    }
+#endif
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
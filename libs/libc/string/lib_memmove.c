@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -43,6 +46,30 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest;
       s   = (FAR char *) src;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+      /* Copying forward word by word is safe as long as the destination is
+       * below the source.
+       */
+
+      if (count >= 2 * LIBC_WORDSIZE &&
+          LIBC_WORDOFFSET(tmp) == LIBC_WORDOFFSET(s))
+        {
+          while (LIBC_WORDOFFSET(tmp) != 0)
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          while (count >= LIBC_WORDSIZE)
+            {
+              *(FAR uintptr_t *)tmp = *(FAR uintptr_t *)s;
+              tmp   += LIBC_WORDSIZE;
+              s     += LIBC_WORDSIZE;
+              count -= LIBC_WORDSIZE;
+            }
+        }
+#endif
+
       while (count--)
         {
           *tmp++ = *s++;
@@ -53,6 +80,28 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest + count;
       s   = (FAR char *) src + count;
 
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+      /* The same backwards, from the end of the buffers */
+
+      if (count >= 2 * LIBC_WORDSIZE &&
+          LIBC_WORDOFFSET(tmp) == LIBC_WORDOFFSET(s))
+        {
+          while (LIBC_WORDOFFSET(tmp) != 0)
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          while (count >= LIBC_WORDSIZE)
+            {
+              tmp   -= LIBC_WORDSIZE;
+              s     -= LIBC_WORDSIZE;
+              count -= LIBC_WORDSIZE;
+              *(FAR uintptr_t *)tmp = *(FAR uintptr_t *)s;
+            }
+        }
+#endif
+
       while (count--)
         {
           *--tmp = *--s;
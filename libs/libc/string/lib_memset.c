@@ -30,6 +30,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -51,7 +53,43 @@
 no_builtin("memset")
 FAR void *memset(FAR void *s, int c, size_t n)
 {
-#ifdef CONFIG_MEMSET_OPTSPEED
+#if defined(CONFIG_LIBC_STRING_OPTIMIZE)
+  /* Fill whole native words once the destination is aligned */
+
+  FAR unsigned char *p = (FAR unsigned char *)s;
+  uintptr_t val = LIBC_WORDREPEAT(c);
+  FAR uintptr_t *w;
+
+  if (n >= 2 * LIBC_WORDSIZE)
+    {
+      while (LIBC_WORDOFFSET(p) != 0)
+        {
+          *p++ = c;
+          n--;
+        }
+
+      w = (FAR uintptr_t *)p;
+      while (n >= 4 * LIBC_WORDSIZE)
+        {
+          w[0] = val;
+          w[1] = val;
+          w[2] = val;
+          w[3] = val;
+          w   += 4;
+          n   -= 4 * LIBC_WORDSIZE;
+        }
+
+      while (n >= LIBC_WORDSIZE)
+        {
+          *w++ = val;
+          n   -= LIBC_WORDSIZE;
+        }
+
+      p = (FAR unsigned char *)w;
+    }
+
+  while (n-- > 0) *p++ = c;
+#elif defined(CONFIG_MEMSET_OPTSPEED)
   /* This version is optimized for speed (you could do better
    * still by exploiting processor caching or memory burst
    * knowledge.)
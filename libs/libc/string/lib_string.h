@@ -0,0 +1,63 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Helpers for the word-at-a-time string functions.  A word is the native
+ * pointer-sized integer.
+ */
+
+#define LIBC_WORDSIZE       sizeof(uintptr_t)
+#define LIBC_WORDMASK       (LIBC_WORDSIZE - 1)
+
+/* The offset of an address within its word */
+
+#define LIBC_WORDOFFSET(p)  ((uintptr_t)(p) & LIBC_WORDMASK)
+
+/* A word with every byte set to 0x01, 0x80 or to the byte c */
+
+#define LIBC_WORDONES       ((uintptr_t)-1 / 0xff)
+#define LIBC_WORDHIGHS      (LIBC_WORDONES * 0x80)
+#define LIBC_WORDREPEAT(c)  (LIBC_WORDONES * (uint8_t)(c))
+
+/* Non-zero if any byte of the word x is zero.  The exact value is not
+ * meaningful, only whether it is zero.
+ */
+
+#define LIBC_WORDHASZERO(x) \
+  (((x) - LIBC_WORDONES) & ~(x) & LIBC_WORDHIGHS)
+
+#endif /* CONFIG_LIBC_STRING_OPTIMIZE */
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -35,7 +38,29 @@
 size_t strlen(const char *s)
 {
   const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+
+#ifdef CONFIG_LIBC_STRING_OPTIMIZE
+  FAR const uintptr_t *ws;
+
+  /* Test a word at a time once aligned.  An aligned word never crosses a
+   * page, so reading past the terminator is harmless.
+   */
+
+  for (sc = s; LIBC_WORDOFFSET(sc) != 0; ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  for (ws = (FAR const uintptr_t *)sc; !LIBC_WORDHASZERO(*ws); ws++);
+  sc = (const char *)ws;
+#else
+  sc = s;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
@@ -37,9 +37,18 @@
 #include <nuttx/mm/circbuf.h>
 
 /****************************************************************************
- * Private Types
+ * Pre-processor Definitions
  ****************************************************************************/
 
+/* The writer publishes the data that it has copied in by advancing the
+ * head and the reader gives back the space that it has copied out of by
+ * advancing the tail, so each side must load the index of the other one
+ * with acquire semantics.
+ */
+
+#define circbuf_load(p)    __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define circbuf_store(p,v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -209,7 +218,7 @@ size_t circbuf_size(FAR struct circbuf_s *circ)
 size_t circbuf_used(FAR struct circbuf_s *circ)
 {
   DEBUGASSERT(circ);
-  return circ->head - circ->tail;
+  return circbuf_load(&circ->head) - circbuf_load(&circ->tail);
 }
 
 /****************************************************************************
@@ -379,7 +388,7 @@ ssize_t circbuf_read(FAR struct circbuf_s *circ,
   DEBUGASSERT(dst || !bytes);
 
   bytes = circbuf_peek(circ, dst, bytes);
-  circ->tail += bytes;
+  circbuf_store(&circ->tail, circ->tail + bytes);
 
   return bytes;
 }
@@ -416,7 +425,7 @@ ssize_t circbuf_skip(FAR struct circbuf_s *circ, size_t bytes)
       bytes = len;
     }
 
-  circ->tail += bytes;
+  circbuf_store(&circ->tail, circ->tail + bytes);
 
   return bytes;
 }
@@ -470,7 +479,7 @@ ssize_t circbuf_write(FAR struct circbuf_s *circ,
 
   memcpy(circ->base + off, src, space);
   memcpy(circ->base, src + space, bytes - space);
-  circ->head += bytes;
+  circbuf_store(&circ->head, circ->head + bytes);
 
   return bytes;
 }
@@ -533,8 +542,149 @@ ssize_t circbuf_overwrite(FAR struct circbuf_s *circ,
 
   memcpy(circ->base + off, src, space);
   memcpy(circ->base, src + space, bytes - space);
-  circ->head += bytes;
-  circ->tail += overwrite;
+  circbuf_store(&circ->head, circ->head + bytes);
+  circbuf_store(&circ->tail, circ->tail + overwrite);
 
   return overwrite;
 }
+
+/****************************************************************************
+ * Name: circbuf_get_writeptr
+ *
+ * Description:
+ *   Get the address where the next data can be written in place, and the
+ *   number of contiguous bytes that can be written there.  The data is
+ *   added to the buffer by circbuf_writecommit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of bytes that can be written.
+ *
+ * Returned Value:
+ *   The address where to write the data.
+ ****************************************************************************/
+
+FAR void *circbuf_get_writeptr(FAR struct circbuf_s *circ,
+                               FAR size_t *size)
+{
+  size_t space;
+  size_t off;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(size);
+
+  if (!circ->size)
+    {
+      *size = 0;
+      return circ->base;
+    }
+
+  space = circbuf_space(circ);
+  off   = circ->head % circ->size;
+  *size = circ->size - off;
+  if (*size > space)
+    {
+      *size = space;
+    }
+
+  return circ->base + off;
+}
+
+/****************************************************************************
+ * Name: circbuf_writecommit
+ *
+ * Description:
+ *   Add the data written in place at the address returned by
+ *   circbuf_get_writeptr() to the circular buffer.
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ        - Address of the circular buffer to be used.
+ *   writtensize - Number of bytes written, no more than returned by
+ *                 circbuf_get_writeptr().
+ ****************************************************************************/
+
+void circbuf_writecommit(FAR struct circbuf_s *circ, size_t writtensize)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(writtensize <= circbuf_space(circ));
+
+  circbuf_store(&circ->head, circ->head + writtensize);
+}
+
+/****************************************************************************
+ * Name: circbuf_get_readptr
+ *
+ * Description:
+ *   Get the address of the oldest data in the buffer, and the number of
+ *   contiguous bytes that can be read there.  The data is removed from the
+ *   buffer by circbuf_readcommit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of bytes that can be read.
+ *
+ * Returned Value:
+ *   The address of the data.
+ ****************************************************************************/
+
+FAR void *circbuf_get_readptr(FAR struct circbuf_s *circ, FAR size_t *size)
+{
+  size_t used;
+  size_t off;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(size);
+
+  if (!circ->size)
+    {
+      *size = 0;
+      return circ->base;
+    }
+
+  used  = circbuf_used(circ);
+  off   = circ->tail % circ->size;
+  *size = circ->size - off;
+  if (*size > used)
+    {
+      *size = used;
+    }
+
+  return circ->base + off;
+}
+
+/****************************************************************************
+ * Name: circbuf_readcommit
+ *
+ * Description:
+ *   Remove the data read in place at the address returned by
+ *   circbuf_get_readptr() from the circular buffer.
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ     - Address of the circular buffer to be used.
+ *   readsize - Number of bytes read, no more than returned by
+ *              circbuf_get_readptr().
+ ****************************************************************************/
+
+void circbuf_readcommit(FAR struct circbuf_s *circ, size_t readsize)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(readsize <= circbuf_used(circ));
+
+  circbuf_store(&circ->tail, circ->tail + readsize);
+}
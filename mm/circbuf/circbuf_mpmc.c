@@ -0,0 +1,275 @@
+/****************************************************************************
+ * mm/circbuf/circbuf_mpmc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <string.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/circbuf.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: circbuf_mpmc_reserve
+ *
+ * Description:
+ *   Reserve up to 'bytes' bytes after the position in 'reserve'.  The
+ *   number of bytes available is limit - (*reserve - *start): the free
+ *   space for the writers (the size of the buffer and the completed tail)
+ *   or the data for the readers (zero and the completed head).
+ *
+ * Returned Value:
+ *   The number of bytes reserved.  The reservation starts at '*pos'.
+ *
+ ****************************************************************************/
+
+static size_t circbuf_mpmc_reserve(FAR size_t *reserve,
+                                   FAR const size_t *start, size_t limit,
+                                   size_t bytes, FAR size_t *pos)
+{
+  size_t avail;
+
+  *pos = __atomic_load_n(reserve, __ATOMIC_RELAXED);
+  do
+    {
+      avail = limit - (*pos - __atomic_load_n(start, __ATOMIC_ACQUIRE));
+      if (bytes > avail)
+        {
+          bytes = avail;
+        }
+
+      if (bytes == 0)
+        {
+          break;
+        }
+    }
+  while (!__atomic_compare_exchange_n(reserve, pos, *pos + bytes, false,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+  return bytes;
+}
+
+/****************************************************************************
+ * Name: circbuf_mpmc_commit
+ *
+ * Description:
+ *   Complete a reservation.  The reservations are completed in the order
+ *   in which they were made, so wait for the earlier ones first.
+ *
+ ****************************************************************************/
+
+static void circbuf_mpmc_commit(FAR size_t *done, size_t pos, size_t bytes)
+{
+  while (__atomic_load_n(done, __ATOMIC_RELAXED) != pos)
+    {
+      /* Another CPU is still copying an earlier reservation */
+    }
+
+  __atomic_store_n(done, pos + bytes, __ATOMIC_RELEASE);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: circbuf_mpmc_init
+ *
+ * Description:
+ *   Initialize a circular buffer for multiple readers and writers.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ *   base  - A pointer to circular buffer's internal buffer, or NULL to
+ *           allocate a buffer of the given size.
+ *   bytes - The size of the internal buffer.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int circbuf_mpmc_init(FAR struct circbuf_mpmc_s *mpmc,
+                      FAR void *base, size_t bytes)
+{
+  DEBUGASSERT(mpmc);
+
+  mpmc->head = 0;
+  mpmc->tail = 0;
+  return circbuf_init(&mpmc->circ, base, bytes);
+}
+
+/****************************************************************************
+ * Name: circbuf_mpmc_uninit
+ *
+ * Description:
+ *   Free the circular buffer.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ ****************************************************************************/
+
+void circbuf_mpmc_uninit(FAR struct circbuf_mpmc_s *mpmc)
+{
+  DEBUGASSERT(mpmc);
+
+  circbuf_uninit(&mpmc->circ);
+  mpmc->head = 0;
+  mpmc->tail = 0;
+}
+
+/****************************************************************************
+ * Name: circbuf_mpmc_read
+ *
+ * Description:
+ *   Get data from the circular buffer.  Any number of readers and writers
+ *   may use the buffer concurrently.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ *   dst   - Address where to store the data.
+ *   bytes - Number of bytes to get.
+ *
+ * Returned Value:
+ *   The bytes of get data is returned if the read data is successful;
+ *   A negated errno value is returned on any failure.
+ ****************************************************************************/
+
+ssize_t circbuf_mpmc_read(FAR struct circbuf_mpmc_s *mpmc,
+                          FAR void *dst, size_t bytes)
+{
+  FAR struct circbuf_s *circ = &mpmc->circ;
+  irqstate_t flags;
+  size_t pos;
+  size_t off;
+  size_t len;
+
+  DEBUGASSERT(mpmc);
+  DEBUGASSERT(dst || !bytes);
+
+  if (!circ->size)
+    {
+      return 0;
+    }
+
+  /* A reader interrupted between its reservation and its commit would
+   * stall the readers behind it, so neither may be interrupted on this
+   * CPU.
+   */
+
+  flags = up_irq_save();
+
+  /* The readers reserve the data between the completed head and their
+   * reserved tail.
+   */
+
+  bytes = circbuf_mpmc_reserve(&mpmc->tail, &circ->head, 0, bytes, &pos);
+  if (bytes > 0)
+    {
+      off = pos % circ->size;
+      len = circ->size - off;
+      if (bytes < len)
+        {
+          len = bytes;
+        }
+
+      memcpy(dst, circ->base + off, len);
+      memcpy(dst + len, circ->base, bytes - len);
+
+      circbuf_mpmc_commit(&circ->tail, pos, bytes);
+    }
+
+  up_irq_restore(flags);
+  return bytes;
+}
+
+/****************************************************************************
+ * Name: circbuf_mpmc_write
+ *
+ * Description:
+ *   Write data to the circular buffer.  Any number of readers and writers
+ *   may use the buffer concurrently.
+ *
+ * Input Parameters:
+ *   mpmc  - Address of the circular buffer to be used.
+ *   src   - The data to be added.
+ *   bytes - Number of bytes to be added.
+ *
+ * Returned Value:
+ *   The bytes of get data is returned if the write data is successful;
+ *   A negated errno value is returned on any failure.
+ ****************************************************************************/
+
+ssize_t circbuf_mpmc_write(FAR struct circbuf_mpmc_s *mpmc,
+                           FAR const void *src, size_t bytes)
+{
+  FAR struct circbuf_s *circ = &mpmc->circ;
+  irqstate_t flags;
+  size_t pos;
+  size_t off;
+  size_t len;
+
+  DEBUGASSERT(mpmc);
+  DEBUGASSERT(src || !bytes);
+
+  if (!circ->size)
+    {
+      return 0;
+    }
+
+  /* A writer interrupted between its reservation and its commit would
+   * stall the writers behind it, so neither may be interrupted on this
+   * CPU.
+   */
+
+  flags = up_irq_save();
+
+  /* The writers reserve the space between their reserved head and the
+   * completed tail.
+   */
+
+  bytes = circbuf_mpmc_reserve(&mpmc->head, &circ->tail, circ->size,
+                               bytes, &pos);
+  if (bytes > 0)
+    {
+      off = pos % circ->size;
+      len = circ->size - off;
+      if (bytes < len)
+        {
+          len = bytes;
+        }
+
+      memcpy(circ->base + off, src, len);
+      memcpy(circ->base, src + len, bytes - len);
+
+      circbuf_mpmc_commit(&circ->head, pos, bytes);
+    }
+
+  up_irq_restore(flags);
+  return bytes;
+}
@@ -48,6 +48,39 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* The number of pools of medium and large I/O buffers */
+
+#ifdef IOB_HAVE_CLASSES
+#  define IOB_NCLASSES          ((CONFIG_IOB_MEDIUM_NBUFFERS > 0) + \
+                                 (CONFIG_IOB_LARGE_NBUFFERS > 0))
+#endif
+
+/* The number of normal I/O buffers, including those allocated from the
+ * heap
+ */
+
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
+#  define IOB_NTOTAL            (CONFIG_IOB_NBUFFERS + g_iob_nheap)
+#else
+#  define IOB_NTOTAL            CONFIG_IOB_NBUFFERS
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+/* A pool of medium or large I/O buffers */
+
+struct iob_class_s
+{
+  FAR struct iob_s *freelist;   /* The free buffers of this pool */
+  uint16_t bufsize;             /* Payload size of each buffer */
+  uint16_t nbuffers;            /* Number of buffers in the pool */
+  uint16_t nfree;               /* Number of free buffers */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -70,6 +103,18 @@ extern FAR struct iob_qentry_s *g_iob_freeqlist;
 extern FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
+#ifdef IOB_HAVE_CLASSES
+/* The pools of medium and large I/O buffers, in increasing size */
+
+extern struct iob_class_s g_iob_classes[IOB_NCLASSES];
+#endif
+
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
+/* The number of normal I/O buffers allocated from the heap */
+
+extern int g_iob_nheap;
+#endif
+
 /* Counting semaphores that tracks the number of free IOBs/qentries */
 
 extern sem_t g_iob_sem;       /* Counts free I/O buffers */
@@ -30,10 +30,23 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of a normal I/O buffer allocated from the heap */
+
+#ifdef IOB_HAVE_CLASSES
+#  define IOB_HEAPSIZE (sizeof(struct iob_s) + CONFIG_IOB_BUFSIZE)
+#else
+#  define IOB_HEAPSIZE sizeof(struct iob_s)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -84,6 +97,242 @@ static FAR struct iob_s *iob_alloc_committed(enum iob_user_e consumerid)
   return iob;
 }
 
+/****************************************************************************
+ * Name: iob_tryalloc_pool
+ *
+ * Description:
+ *   Try to allocate an I/O buffer by taking the buffer at the head of the
+ *   free list without waiting for a buffer to become free and without
+ *   growing the pool.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_tryalloc_pool(bool throttled,
+                                           enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int count;
+#if CONFIG_IOB_THROTTLE > 0
+  FAR sem_t *sem;
+#endif
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* Select the semaphore count to check. */
+
+  sem = (throttled ? &g_throttle_sem : &g_iob_sem);
+#endif
+
+  /* We don't know what context we are called from so we use extreme measures
+   * to protect the free list:  We disable interrupts very briefly.
+   */
+
+  flags = enter_critical_section();
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* If there are free I/O buffers for this allocation */
+
+  if (sem->semcount > 0 ||
+      (throttled && g_iob_sem.semcount - CONFIG_IOB_THROTTLE > 0))
+#endif
+    {
+      /* Take the I/O buffer from the head of the free list */
+
+      iob = g_iob_freelist;
+      if (iob != NULL)
+        {
+          /* Remove the I/O buffer from the free list and decrement the
+           * counting semaphore(s) that tracks the number of available
+           * IOBs.
+           */
+
+          g_iob_freelist = iob->io_flink;
+
+          /* Take a semaphore count.  Note that we cannot do this in
+           * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
+           * because this function may be called from an interrupt
+           * handler. Fortunately we know at at least one free buffer
+           * so a simple decrement is all that is needed.  It must be
+           * atomic, the uncontended semaphore paths do not take the
+           * critical section.
+           */
+
+          count = nxsem_count_dec(&g_iob_sem);
+          DEBUGASSERT(count > 0);
+          UNUSED(count);
+
+#if CONFIG_IOB_THROTTLE > 0
+          /* The throttle semaphore is a little more complicated because
+           * it can be negative!  Decrementing is still safe, however.
+           *
+           * Note: usually g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE.
+           * But it can be smaller than that if there are blocking threads.
+           */
+
+          nxsem_count_dec(&g_throttle_sem);
+#endif
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+          iob_stats_onalloc(consumerid);
+#endif
+
+          leave_critical_section(flags);
+
+          /* Put the I/O buffer in a known state */
+
+          iob->io_flink  = NULL; /* Not in a chain */
+          iob->io_len    = 0;    /* Length of the data in the entry */
+          iob->io_offset = 0;    /* Offset to the beginning of data */
+          iob->io_pktlen = 0;    /* Total length of the packet */
+          return iob;
+        }
+    }
+
+  leave_critical_section(flags);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: iob_heapalloc
+ *
+ * Description:
+ *   Grow the pool of normal I/O buffers by allocating a buffer from the
+ *   heap, unless the pool still has free buffers for this caller or the
+ *   limit has been reached.  The buffer joins the pool when it is freed
+ *   and is never returned to the heap.  This must not be called from
+ *   interrupt handlers or in a critical section.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
+static FAR struct iob_s *iob_heapalloc(bool throttled,
+                                       enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int limit = CONFIG_IOB_HEAP_NBUFFERS;
+  int reserve = 0;
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* As in the pool, the last CONFIG_IOB_THROTTLE buffers are reserved for
+   * the unthrottled allocations.  A throttled caller cannot use them, so
+   * the pool grows for it while no more than those are free.
+   */
+
+  if (throttled)
+    {
+      limit  -= CONFIG_IOB_THROTTLE;
+      reserve = CONFIG_IOB_THROTTLE;
+    }
+#endif
+
+  if (g_iob_sem.semcount > reserve || g_iob_nheap >= limit)
+    {
+      return NULL;
+    }
+
+  iob = (FAR struct iob_s *)kmm_malloc(IOB_HEAPSIZE);
+  if (iob == NULL)
+    {
+      return NULL;
+    }
+
+  /* Check again, a buffer may have been freed or someone else may have
+   * grown the pool while we were allocating.
+   */
+
+  flags = enter_critical_section();
+  if (g_iob_sem.semcount > reserve || g_iob_nheap >= limit)
+    {
+      leave_critical_section(flags);
+      kmm_free(iob);
+      return NULL;
+    }
+
+  g_iob_nheap++;
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onalloc(consumerid);
+#endif
+
+  leave_critical_section(flags);
+
+  iobinfo("Allocated I/O buffer %d from the heap\n", g_iob_nheap);
+
+#ifdef IOB_HAVE_CLASSES
+  iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+  iob->io_data    = (FAR uint8_t *)(iob + 1);
+#endif
+
+  iob->io_flink  = NULL; /* Not in a chain */
+  iob->io_len    = 0;    /* Length of the data in the entry */
+  iob->io_offset = 0;    /* Offset to the beginning of data */
+  iob->io_pktlen = 0;    /* Total length of the packet */
+  return iob;
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_class
+ *
+ * Description:
+ *   Try to allocate a medium or large I/O buffer for len bytes: the
+ *   smallest free one that holds len bytes, else the largest free one.
+ *
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+static FAR struct iob_s *iob_tryalloc_class(unsigned int len,
+                                            enum iob_user_e consumerid)
+{
+  FAR struct iob_class_s *pool = NULL;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < IOB_NCLASSES; i++)
+    {
+      if (g_iob_classes[i].nfree > 0)
+        {
+          pool = &g_iob_classes[i];
+          if (pool->bufsize >= len)
+            {
+              break;
+            }
+        }
+    }
+
+  if (pool == NULL)
+    {
+      leave_critical_section(flags);
+      return NULL;
+    }
+
+  iob            = pool->freelist;
+  pool->freelist = iob->io_flink;
+  pool->nfree--;
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onalloc(consumerid);
+#endif
+
+  leave_critical_section(flags);
+
+  /* Put the I/O buffer in a known state */
+
+  iob->io_flink  = NULL; /* Not in a chain */
+  iob->io_len    = 0;    /* Length of the data in the entry */
+  iob->io_offset = 0;    /* Offset to the beginning of data */
+  iob->io_pktlen = 0;    /* Total length of the packet */
+  return iob;
+}
+#endif
+
 /****************************************************************************
  * Name: iob_allocwait
  *
@@ -121,9 +370,25 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout,
    * decremented atomically.
    */
 
-  iob = iob_tryalloc(throttled, consumerid);
+  iob = iob_tryalloc_pool(throttled, consumerid);
   while (ret == OK && iob == NULL)
     {
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
+      /* Try to grow the pool before waiting.  The heap cannot be used in
+       * the critical section.  A buffer freed in the meantime is not
+       * missed, it is counted by the semaphore.
+       */
+
+      leave_critical_section(flags);
+      iob = iob_heapalloc(throttled, consumerid);
+      flags = enter_critical_section();
+
+      if (iob != NULL)
+        {
+          break;
+        }
+#endif
+
       /* If not successful, then the semaphore count was less than or equal
        * to zero (meaning that there are no free buffers).  We need to wait
        * for an I/O buffer to be released and placed in the committed
@@ -155,7 +420,7 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout,
                */
 
               nxsem_post(sem);
-              iob = iob_tryalloc(throttled, consumerid);
+              iob = iob_tryalloc_pool(throttled, consumerid);
             }
 
           /* REVISIT: I think this logic should be moved inside of
@@ -168,11 +433,11 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout,
             {
               if (throttled)
                 {
-                  g_iob_sem.semcount--;
+                  nxsem_count_dec(&g_iob_sem);
                 }
               else
                 {
-                  g_throttle_sem.semcount--;
+                  nxsem_count_dec(&g_throttle_sem);
                 }
             }
 #endif
@@ -238,87 +503,82 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid)
  *
  * Description:
  *   Try to allocate an I/O buffer by taking the buffer at the head of the
- *   free list without waiting for a buffer to become free.
+ *   free list without waiting for a buffer to become free.  The pool is
+ *   grown from the heap if it is exhausted.
  *
  ****************************************************************************/
 
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
 {
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
   FAR struct iob_s *iob;
-  irqstate_t flags;
-#if CONFIG_IOB_THROTTLE > 0
-  FAR sem_t *sem;
-#endif
 
-#if CONFIG_IOB_THROTTLE > 0
-  /* Select the semaphore count to check. */
+  iob = iob_tryalloc_pool(throttled, consumerid);
+  if (iob == NULL && !up_interrupt_context())
+    {
+      /* The pool is exhausted, try to grow it */
 
-  sem = (throttled ? &g_throttle_sem : &g_iob_sem);
-#endif
+      iob = iob_heapalloc(throttled, consumerid);
+    }
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the free list:  We disable interrupts very briefly.
-   */
+  return iob;
+#else
+  return iob_tryalloc_pool(throttled, consumerid);
+#endif
+}
 
-  flags = enter_critical_section();
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer for about len bytes of data, using a medium or
+ *   large I/O buffer if len does not fit into a normal one.
+ *
+ ****************************************************************************/
 
-#if CONFIG_IOB_THROTTLE > 0
-  /* If there are free I/O buffers for this allocation */
+FAR struct iob_s *iob_alloc_size(bool throttled, unsigned int len,
+                                 enum iob_user_e consumerid)
+{
+#ifdef IOB_HAVE_CLASSES
+  FAR struct iob_s *iob;
 
-  if (sem->semcount > 0 ||
-      (throttled && g_iob_sem.semcount - CONFIG_IOB_THROTTLE > 0))
-#endif
+  if (len > CONFIG_IOB_BUFSIZE)
     {
-      /* Take the I/O buffer from the head of the free list */
-
-      iob = g_iob_freelist;
+      iob = iob_tryalloc_class(len, consumerid);
       if (iob != NULL)
         {
-          /* Remove the I/O buffer from the free list and decrement the
-           * counting semaphore(s) that tracks the number of available
-           * IOBs.
-           */
-
-          g_iob_freelist = iob->io_flink;
-
-          /* Take a semaphore count.  Note that we cannot do this in
-           * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-           * because this function may be called from an interrupt
-           * handler. Fortunately we know at at least one free buffer
-           * so a simple decrement is all that is needed.
-           */
-
-          g_iob_sem.semcount--;
-          DEBUGASSERT(g_iob_sem.semcount >= 0);
-
-#if CONFIG_IOB_THROTTLE > 0
-          /* The throttle semaphore is a little more complicated because
-           * it can be negative!  Decrementing is still safe, however.
-           *
-           * Note: usually g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE.
-           * But it can be smaller than that if there are blocking threads.
-           */
-
-          g_throttle_sem.semcount--;
+          return iob;
+        }
+    }
 #endif
 
-#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
-    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
-          iob_stats_onalloc(consumerid);
-#endif
+  return iob_alloc(throttled, consumerid);
+}
 
-          leave_critical_section(flags);
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Try to allocate an I/O buffer for about len bytes of data, using a
+ *   medium or large I/O buffer if len does not fit into a normal one.
+ *
+ ****************************************************************************/
 
-          /* Put the I/O buffer in a known state */
+FAR struct iob_s *iob_tryalloc_size(bool throttled, unsigned int len,
+                                    enum iob_user_e consumerid)
+{
+#ifdef IOB_HAVE_CLASSES
+  FAR struct iob_s *iob;
 
-          iob->io_flink  = NULL; /* Not in a chain */
-          iob->io_len    = 0;    /* Length of the data in the entry */
-          iob->io_offset = 0;    /* Offset to the beginning of data */
-          iob->io_pktlen = 0;    /* Total length of the packet */
+  if (len > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_class(len, consumerid);
+      if (iob != NULL)
+        {
           return iob;
         }
     }
+#endif
 
-  leave_critical_section(flags);
-  return NULL;
+  return iob_tryalloc(throttled, consumerid);
 }
@@ -194,6 +194,7 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
 {
   FAR struct iob_qentry_s *iobq;
   irqstate_t flags;
+  int count;
 
   /* We don't know what context we are called from so we use extreme measures
    * to protect the free list:  We disable interrupts very briefly.
@@ -214,11 +215,13 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
        * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
        * because this function may be called from an interrupt
        * handler. Fortunately we know at at least one free buffer
-       * so a simple decrement is all that is needed.
+       * so a simple decrement is all that is needed.  It must be atomic,
+       * the uncontended semaphore paths do not take the critical section.
        */
 
-      g_qentry_sem.semcount--;
-      DEBUGASSERT(g_qentry_sem.semcount >= 0);
+      count = nxsem_count_dec(&g_qentry_sem);
+      DEBUGASSERT(count > 0);
+      UNUSED(count);
 
       /* Put the I/O buffer in a known state */
 
@@ -58,6 +58,47 @@
 
 #define IOB_MASK      (IOB_DIVIDER - 1)
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_free_class
+ *
+ * Description:
+ *   Return a medium or large I/O buffer to its pool.
+ *
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+static void iob_free_class(FAR struct iob_s *iob,
+                           enum iob_user_e producerid)
+{
+  FAR struct iob_class_s *pool = g_iob_classes;
+  irqstate_t flags;
+
+  while (pool->bufsize != iob->io_bufsize)
+    {
+      pool++;
+      DEBUGASSERT(pool < &g_iob_classes[IOB_NCLASSES]);
+    }
+
+  flags = enter_critical_section();
+
+  iob->io_flink  = pool->freelist;
+  pool->freelist = iob;
+  pool->nfree++;
+  DEBUGASSERT(pool->nfree <= pool->nbuffers);
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onfree(producerid);
+#endif
+
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -113,6 +154,16 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
               next, next->io_pktlen, next->io_len);
     }
 
+#ifdef IOB_HAVE_CLASSES
+  /* Medium and large I/O buffers go back to their own pool */
+
+  if (iob->io_bufsize != CONFIG_IOB_BUFSIZE)
+    {
+      iob_free_class(iob, producerid);
+      return next;
+    }
+#endif
+
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
@@ -145,7 +196,7 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
    */
 
   nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+  DEBUGASSERT(g_iob_sem.semcount <= IOB_NTOTAL);
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
@@ -155,7 +206,7 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 #if CONFIG_IOB_THROTTLE > 0
   nxsem_post(&g_throttle_sem);
   DEBUGASSERT(g_throttle_sem.semcount <=
-              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+              (IOB_NTOTAL - CONFIG_IOB_THROTTLE));
 #endif
 
 #ifdef CONFIG_IOB_NOTIFIER
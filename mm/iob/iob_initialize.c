@@ -24,12 +24,21 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <stdbool.h>
 
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The payload of the I/O buffers is kept word aligned */
+
+#define IOB_NWORDS(s) (((s) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t))
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -37,10 +46,28 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+#ifdef IOB_HAVE_CLASSES
+static uintptr_t           g_iob_data[CONFIG_IOB_NBUFFERS]
+                                     [IOB_NWORDS(CONFIG_IOB_BUFSIZE)];
+#endif
 #if CONFIG_IOB_NCHAINS > 0
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
 
+/* The pools of medium and large I/O buffers */
+
+#if CONFIG_IOB_MEDIUM_NBUFFERS > 0
+static struct iob_s        g_iob_medium_pool[CONFIG_IOB_MEDIUM_NBUFFERS];
+static uintptr_t           g_iob_medium_data[CONFIG_IOB_MEDIUM_NBUFFERS]
+                                     [IOB_NWORDS(CONFIG_IOB_MEDIUM_BUFSIZE)];
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static struct iob_s        g_iob_large_pool[CONFIG_IOB_LARGE_NBUFFERS];
+static uintptr_t           g_iob_large_data[CONFIG_IOB_LARGE_NBUFFERS]
+                                     [IOB_NWORDS(CONFIG_IOB_LARGE_BUFSIZE)];
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -63,6 +90,30 @@ FAR struct iob_qentry_s *g_iob_freeqlist;
 FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
+#ifdef IOB_HAVE_CLASSES
+/* The pools of medium and large I/O buffers, in increasing size */
+
+struct iob_class_s g_iob_classes[IOB_NCLASSES] =
+{
+#if CONFIG_IOB_MEDIUM_NBUFFERS > 0
+  {
+    NULL, CONFIG_IOB_MEDIUM_BUFSIZE, CONFIG_IOB_MEDIUM_NBUFFERS, 0
+  },
+#endif
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  {
+    NULL, CONFIG_IOB_LARGE_BUFSIZE, CONFIG_IOB_LARGE_NBUFFERS, 0
+  },
+#endif
+};
+#endif
+
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
+/* The number of normal I/O buffers allocated from the heap */
+
+int g_iob_nheap;
+#endif
+
 /* Counting semaphores that tracks the number of free IOBs/qentries */
 
 sem_t g_iob_sem = SEM_INITIALIZER(CONFIG_IOB_NBUFFERS);
@@ -80,6 +131,40 @@ sem_t g_throttle_sem = SEM_INITIALIZER(CONFIG_IOB_NBUFFERS -
 sem_t g_qentry_sem = SEM_INITIALIZER(CONFIG_IOB_NCHAINS);
 #endif
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_initclass
+ *
+ * Description:
+ *   Add the buffers of a pool of medium or large I/O buffers to its free
+ *   list.
+ *
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+static void iob_initclass(FAR struct iob_class_s *pool,
+                          FAR struct iob_s *iobs, FAR uintptr_t *data)
+{
+  int i;
+
+  for (i = 0; i < pool->nbuffers; i++)
+    {
+      FAR struct iob_s *iob = &iobs[i];
+
+      iob->io_bufsize = pool->bufsize;
+      iob->io_data    = (FAR uint8_t *)&data[i * IOB_NWORDS(pool->bufsize)];
+
+      iob->io_flink   = pool->freelist;
+      pool->freelist  = iob;
+    }
+
+  pool->nfree = pool->nbuffers;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -102,12 +187,31 @@ void iob_initialize(void)
     {
       FAR struct iob_s *iob = &g_iob_pool[i];
 
+#ifdef IOB_HAVE_CLASSES
+      iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+      iob->io_data    = (FAR uint8_t *)g_iob_data[i];
+#endif
+
       /* Add the pre-allocate I/O buffer to the head of the free list */
 
       iob->io_flink  = g_iob_freelist;
       g_iob_freelist = iob;
     }
 
+#ifdef IOB_HAVE_CLASSES
+  /* Then the medium and large I/O buffers */
+
+  i = 0;
+#if CONFIG_IOB_MEDIUM_NBUFFERS > 0
+  iob_initclass(&g_iob_classes[i++], g_iob_medium_pool,
+                &g_iob_medium_data[0][0]);
+#endif
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  iob_initclass(&g_iob_classes[i++], g_iob_large_pool,
+                &g_iob_large_data[0][0]);
+#endif
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
       /* Add each I/O buffer chain queue container to the free list */
 
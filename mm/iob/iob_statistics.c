@@ -28,10 +28,14 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/mm/iob.h>
 
+#include "iob.h"
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
 
@@ -95,6 +99,40 @@ void iob_stats_onfree(enum iob_user_e producerid)
   g_iobuserstats[IOBUSER_GLOBAL].totalproduced++;
 }
 
+/****************************************************************************
+ * Name: iob_reassign
+ *
+ * Description:
+ *   Hand an I/O buffer chain over from one user to another.  For the IOB
+ *   statistics, the buffers are freed by the producer and allocated by the
+ *   consumer.
+ *
+ * Input Parameters:
+ *   iob        - The I/O buffer chain
+ *   producerid - id representing the user the chain was allocated for
+ *   consumerid - id representing the user that will free the chain
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_reassign(FAR struct iob_s *iob, enum iob_user_e producerid,
+                  enum iob_user_e consumerid)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  for (; iob != NULL; iob = iob->io_flink)
+    {
+      iob_stats_onfree(producerid);
+      iob_stats_onalloc(consumerid);
+    }
+
+  leave_critical_section(flags);
+}
+
 /****************************************************************************
  * Name: iob_getuserstats
  *
@@ -116,5 +154,52 @@ FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid)
   return &g_iobuserstats[userid];
 }
 
+/****************************************************************************
+ * Name: iob_getclassstats
+ *
+ * Description:
+ *   Return the state of one pool of I/O buffers.  The pool of normal I/O
+ *   buffers comes first, followed by the medium and large ones.
+ *
+ * Input Parameters:
+ *   index - The index of the pool, starting from zero
+ *   stats - The location to return the state of the pool
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no pool with that index.
+ *
+ ****************************************************************************/
+
+int iob_getclassstats(int index, FAR struct iob_classstats_s *stats)
+{
+  if (index == 0)
+    {
+      stats->bufsize = CONFIG_IOB_BUFSIZE;
+      stats->ntotal  = IOB_NTOTAL;
+      stats->nfree   = iob_navail(false);
+#if CONFIG_IOB_HEAP_NBUFFERS > 0
+      stats->nheap   = g_iob_nheap;
+#else
+      stats->nheap   = 0;
+#endif
+      return OK;
+    }
+
+#ifdef IOB_HAVE_CLASSES
+  if (index <= IOB_NCLASSES)
+    {
+      FAR struct iob_class_s *pool = &g_iob_classes[index - 1];
+
+      stats->bufsize = pool->bufsize;
+      stats->ntotal  = pool->nbuffers;
+      stats->nfree   = pool->nfree;
+      stats->nheap   = 0;
+      return OK;
+    }
+#endif
+
+  return -ENOENT;
+}
+
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
         * !CONFIG_FS_PROCFS_EXCLUDE_IOBINFO */
@@ -23,10 +23,20 @@
  ****************************************************************************/
 
 #include <stdbool.h>
+#include <string.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/mempool.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of blocks exchanged between a magazine and the pool */
+
+#define MEMPOOL_MAGAZINE_BATCH (CONFIG_MM_MEMPOOL_MAGAZINE_SIZE / 2)
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -41,6 +51,150 @@ static inline void mempool_add_list(FAR sq_queue_t *list, FAR void *base,
     }
 }
 
+static inline bool mempool_is_iblk(FAR struct mempool_s *pool,
+                                   FAR void *blk)
+{
+  FAR char *base;
+
+  /* The interrupt blocks are always at the start of the first expand
+   * block, which never changes after mempool_init().
+   */
+
+  base = (FAR char *)(sq_peek(&pool->elist) + 1);
+  return pool->ninterrupt && (FAR char *)blk >= base &&
+         (FAR char *)blk < base + pool->ninterrupt * pool->bsize;
+}
+
+static void mempool_notify(FAR struct mempool_s *pool)
+{
+  if (pool->nexpand == 0)
+    {
+      int semcount;
+
+      nxsem_get_value(&pool->wait, &semcount);
+      if (semcount < 1)
+        {
+          nxsem_post(&pool->wait);
+        }
+    }
+}
+
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+
+/****************************************************************************
+ * Name: mempool_magazine_pop
+ *
+ * Description:
+ *   Take a block from the magazine of the current CPU, refilling half of
+ *   the magazine from the pool free list if it is empty.  Blocks cached in
+ *   a magazine are accounted in nused.
+ *
+ ****************************************************************************/
+
+static FAR void *mempool_magazine_pop(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_magazine_s *mag;
+  FAR void *blk = NULL;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  mag   = &pool->mag[up_cpu_index()];
+
+  if (mag->nblks == 0)
+    {
+      irqstate_t lflags = spin_lock_irqsave(&pool->lock);
+
+      while (mag->nblks < MEMPOOL_MAGAZINE_BATCH)
+        {
+          FAR sq_entry_t *entry = sq_remfirst(&pool->list);
+
+          if (entry == NULL)
+            {
+              break;
+            }
+
+          mag->blks[mag->nblks++] = entry;
+        }
+
+      pool->nused += mag->nblks;
+      spin_unlock_irqrestore(&pool->lock, lflags);
+    }
+
+  if (mag->nblks > 0)
+    {
+      blk = mag->blks[--mag->nblks];
+    }
+
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_magazine_push
+ *
+ * Description:
+ *   Put a block into the magazine of the current CPU, returning half of
+ *   the magazine to the pool free list if it is full.  Interrupt blocks
+ *   and blocks that a thread is waiting for bypass the magazine.
+ *
+ * Returned Value:
+ *   true if the block was consumed; false if the caller must free it to
+ *   the pool.
+ *
+ ****************************************************************************/
+
+static bool mempool_magazine_push(FAR struct mempool_s *pool, FAR void *blk)
+{
+  FAR struct mempool_magazine_s *mag;
+  bool drained = false;
+  irqstate_t flags;
+
+  if (mempool_is_iblk(pool, blk))
+    {
+      return false;
+    }
+
+  if (pool->nexpand == 0)
+    {
+      int semcount;
+
+      nxsem_get_value(&pool->wait, &semcount);
+      if (semcount < 0)
+        {
+          return false;
+        }
+    }
+
+  flags = up_irq_save();
+  mag   = &pool->mag[up_cpu_index()];
+
+  if (mag->nblks == CONFIG_MM_MEMPOOL_MAGAZINE_SIZE)
+    {
+      irqstate_t lflags = spin_lock_irqsave(&pool->lock);
+
+      while (mag->nblks > CONFIG_MM_MEMPOOL_MAGAZINE_SIZE -
+                          MEMPOOL_MAGAZINE_BATCH)
+        {
+          sq_addfirst(mag->blks[--mag->nblks], &pool->list);
+        }
+
+      pool->nused -= MEMPOOL_MAGAZINE_BATCH;
+      spin_unlock_irqrestore(&pool->lock, lflags);
+      drained = true;
+    }
+
+  mag->blks[mag->nblks++] = blk;
+  up_irq_restore(flags);
+
+  if (drained)
+    {
+      mempool_notify(pool);
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -80,6 +234,9 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name,
 
   pool->nused = 0;
   pool->bsize = bsize;
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  memset(pool->mag, 0, sizeof(pool->mag));
+#endif
   pool->nexpand = nexpand;
   pool->ninterrupt = ninterrupt;
   sq_init(&pool->list);
@@ -138,6 +295,14 @@ FAR void *mempool_alloc(FAR struct mempool_s *pool)
       return NULL;
     }
 
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  blk = mempool_magazine_pop(pool);
+  if (blk != NULL)
+    {
+      return blk;
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = sq_remfirst(&pool->list);
@@ -200,17 +365,21 @@ out_with_lock:
 void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 {
   irqstate_t flags;
-  FAR char *base;
 
   if (blk == NULL || pool == NULL)
     {
       return;
     }
 
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  if (mempool_magazine_push(pool, blk))
+    {
+      return;
+    }
+#endif
+
   flags = spin_lock_irqsave(&pool->lock);
-  base = (FAR char *)(sq_peek(&pool->elist) + 1);
-  if (pool->ninterrupt && (FAR char *)blk >= base &&
-      (FAR char *)blk < base + pool->ninterrupt * pool->bsize)
+  if (mempool_is_iblk(pool, blk))
     {
       sq_addfirst(blk, &pool->ilist);
     }
@@ -221,16 +390,7 @@ void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 
   pool->nused--;
   spin_unlock_irqrestore(&pool->lock, flags);
-  if (pool->nexpand == 0)
-    {
-      int semcount;
-
-      nxsem_get_value(&pool->wait, &semcount);
-      if (semcount < 1)
-        {
-          nxsem_post(&pool->wait);
-        }
-    }
+  mempool_notify(pool);
 }
 
 /****************************************************************************
@@ -250,6 +410,9 @@ void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   irqstate_t flags;
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  int i;
+#endif
 
   if (pool == NULL || info == NULL)
     {
@@ -262,6 +425,15 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
   info->aordblks = pool->nused;
   info->arena = (pool->nused + info->ordblks + info->iordblks) * pool->bsize;
   spin_unlock_irqrestore(&pool->lock, flags);
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      /* Blocks in the magazines are free but accounted in nused */
+
+      info->ncached[i] = pool->mag[i].nblks;
+      info->aordblks  -= info->ncached[i];
+    }
+#endif
   info->sizeblks = pool->bsize;
   if (pool->nexpand == 0)
     {
@@ -291,13 +463,24 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 int mempool_deinit(FAR struct mempool_s *pool)
 {
   FAR sq_entry_t *blk;
+  size_t ncached = 0;
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  int i;
+#endif
 
   if (pool == NULL)
     {
       return -EINVAL;
     }
 
-  if (pool->nused != 0)
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      ncached += pool->mag[i].nblks;
+    }
+#endif
+
+  if (pool->nused != ncached)
     {
       return -EBUSY;
     }
@@ -165,6 +165,35 @@ static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
           copysize   = procfs_memcpy(procfile->line, linesize, buffer,
                                      buflen, &offset);
           totalsize += copysize;
+
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+          /* Followed by the free blocks cached in each CPU magazine */
+
+          if (totalsize < buflen)
+            {
+              int cpu;
+
+              buffer    += copysize;
+              buflen    -= copysize;
+
+              linesize   = procfs_snprintf(procfile->line,
+                                           MEMPOOLINFO_LINELEN,
+                                           "%12s:", "percpu");
+              for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+                {
+                  linesize += procfs_snprintf(procfile->line + linesize,
+                                              MEMPOOLINFO_LINELEN - linesize,
+                                              " %lu", minfo.ncached[cpu]);
+                }
+
+              linesize  += procfs_snprintf(procfile->line + linesize,
+                                           MEMPOOLINFO_LINELEN - linesize,
+                                           "\n");
+              copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                         buflen, &offset);
+              totalsize += copysize;
+            }
+#endif
         }
     }
 
@@ -156,6 +156,38 @@
 
 #define SIZEOF_MM_FREENODE sizeof(struct mm_freenode_s)
 
+/* Two-level segregated fit free lists.  The first level splits the chunk
+ * sizes into power of two ranges, the second level splits each range into
+ * MM_TLSF_SLCOUNT equal classes.  All chunks smaller than
+ * MM_TLSF_SMALLBLOCK share first level 0, one class per granule.
+ */
+
+#ifdef CONFIG_MM_HEAP_TLSF
+#  define MM_TLSF_SLI        CONFIG_MM_HEAP_TLSF_SLI
+#  define MM_TLSF_SLCOUNT    (1 << MM_TLSF_SLI)
+#  define MM_TLSF_FLSHIFT    (MM_TLSF_SLI + MM_MIN_SHIFT)
+#  define MM_TLSF_SMALLBLOCK (1 << MM_TLSF_FLSHIFT)
+#  ifdef CONFIG_MM_SMALL
+#    define MM_TLSF_SIZEBITS 16
+#  else
+#    define MM_TLSF_SIZEBITS 32
+#  endif
+#  define MM_TLSF_FLCOUNT    (MM_TLSF_SIZEBITS - MM_TLSF_FLSHIFT + 1)
+#endif
+
+/* Per-CPU chunk cache geometry.  Small chunks are binned by their exact
+ * (granule aligned) chunk size, so bin N holds chunks of size
+ * (N + 1) * MM_MIN_CHUNK.
+ */
+
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+#  define MM_CPUCACHE_MAXCHUNK \
+     MM_ALIGN_UP(CONFIG_MM_HEAP_CPUCACHE_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#  define MM_CPUCACHE_NBINS  (MM_CPUCACHE_MAXCHUNK >> MM_MIN_SHIFT)
+#  define MM_CPUCACHE_NDX(s) (((s) >> MM_MIN_SHIFT) - 1)
+#  define MM_CPUCACHE_BATCH  ((CONFIG_MM_HEAP_CPUCACHE_NBLOCKS + 1) / 2)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -212,6 +244,38 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+/* A chunk parked in a per-CPU cache.  The chunk stays marked as allocated
+ * in the heap; the link lives in the (unused) user payload.
+ */
+
+struct mm_cachenode_s
+{
+  FAR struct mm_cachenode_s *flink;
+};
+
+/* One size class of a per-CPU cache */
+
+struct mm_cachebin_s
+{
+  FAR struct mm_cachenode_s *head;          /* Cached chunks of this size */
+  unsigned int count;                       /* Number of cached chunks */
+};
+
+/* The front-end cache of one CPU.  It is only ever accessed by its own CPU
+ * with local interrupts disabled, so no lock is needed.
+ */
+
+struct mm_cpucache_s
+{
+  struct mm_cachebin_s bins[MM_CPUCACHE_NBINS];
+  unsigned long hits;                       /* Allocations served locally */
+  unsigned long misses;                     /* Allocations that missed */
+  unsigned long refills;                    /* Batches taken from the heap */
+  unsigned long drains;                     /* Batches returned to the heap */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -235,12 +299,23 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_HEAP_TLSF
+  /* Free nodes are kept in unordered, doubly linked lists, one per size
+   * class.  The bitmaps record which classes are non-empty so that a
+   * fitting class is found with a couple of bit scans.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_TLSF_FLCOUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_TLSF_FLCOUNT][MM_TLSF_SLCOUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
 
   /* Free delay list, for some situations where we can't do free
    * immdiately.
@@ -248,6 +323,12 @@ struct mm_heap_s
 
   FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+  /* Per-CPU caches of small chunks that are served without the semaphore */
+
+  struct mm_cpucache_s mm_cpucache[CONFIG_SMP_NCPUS];
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
   struct procfs_meminfo_entry_s mm_procfs;
 #endif
@@ -269,19 +350,43 @@ void mm_semuninitialize(FAR struct mm_heap_s *heap);
 bool mm_takesemaphore(FAR struct mm_heap_s *heap);
 void mm_givesemaphore(FAR struct mm_heap_s *heap);
 
+/* Functions contained in mm_malloc.c ***************************************/
+
+FAR struct mm_allocnode_s *mm_allocchunk(FAR struct mm_heap_s *heap,
+                                         size_t alignsize);
+
+/* Functions contained in mm_free.c *****************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap,
+                  FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_cpucache.c *************************************/
+
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+FAR struct mm_allocnode_s *mm_cpucache_alloc(FAR struct mm_heap_s *heap,
+                                             size_t alignsize);
+bool mm_cpucache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+#endif
+
 /* Functions contained in mm_shrinkchunk.c **********************************/
 
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c *******************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
 
 /* Functions contained in mm_size2ndx.c *************************************/
 
+#ifndef CONFIG_MM_HEAP_TLSF
 int mm_size2ndx(size_t size);
+#endif
 
 /* Functions contained in mm_foreach.c **************************************/
 
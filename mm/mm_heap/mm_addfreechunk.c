@@ -77,3 +77,72 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap,
       next->blink = node;
     }
 }
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from the nodes list.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  /* There must be a predecessor, but there may not be a successor node */
+
+  DEBUGASSERT(node->blink);
+  node->blink->flink = node->flink;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find the smallest free chunk of at least size bytes.  The chunk is not
+ *   removed from the nodes list.  It is assumed that the caller holds the
+ *   mm semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  int ndx;
+
+  /* Get the location in the node list to start the search. Special case
+   * really big allocations
+   */
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      ndx = MM_NNODES - 1;
+    }
+  else
+    {
+      /* Convert the request size into a nodelist index */
+
+      ndx = mm_size2ndx(size);
+    }
+
+  /* Search for a large enough chunk in the list of nodes. This list is
+   * ordered by size, but will have occasional zero sized nodes as we visit
+   * other mm_nodelist[] entries.  Since the list is ordered, the first
+   * node found is the best fitting chunk available.
+   */
+
+  for (node = heap->mm_nodelist[ndx].flink;
+       node && node->size < size;
+       node = node->flink)
+    {
+      DEBUGASSERT(node->blink->flink == node);
+    }
+
+  return node;
+}
@@ -49,6 +49,12 @@ static void checkcorruption_handler(FAR struct mm_allocnode_s *node,
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       assert(node->size >= SIZEOF_MM_FREENODE);
+#ifdef CONFIG_MM_HEAP_TLSF
+      assert(fnode->blink == NULL ||
+             fnode->blink->flink == fnode);
+      assert(fnode->flink == NULL ||
+             fnode->flink->blink == fnode);
+#else
       assert(fnode->blink->flink == fnode);
       assert(fnode->blink->size <= fnode->size);
       assert(fnode->flink == NULL ||
@@ -56,6 +62,7 @@ static void checkcorruption_handler(FAR struct mm_allocnode_s *node,
       assert(fnode->flink == NULL ||
              fnode->flink->size == 0 ||
              fnode->flink->size >= fnode->size);
+#endif
     }
 }
 
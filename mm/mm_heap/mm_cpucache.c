@@ -0,0 +1,370 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cpucache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+#include "kasan/kasan.h"
+
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cachenode2chunk
+ *
+ * Description:
+ *   Map a cached payload back to its allocated chunk header.
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_allocnode_s *
+mm_cachenode2chunk(FAR struct mm_cachenode_s *cnode)
+{
+  return (FAR struct mm_allocnode_s *)
+         ((FAR char *)cnode - SIZEOF_MM_ALLOCNODE);
+}
+
+/****************************************************************************
+ * Name: mm_cachebin_splice
+ *
+ * Description:
+ *   Add a list of cached chunks to the head of a bin.  Local interrupts
+ *   must be disabled.
+ *
+ ****************************************************************************/
+
+static void mm_cachebin_splice(FAR struct mm_cachebin_s *bin,
+                               FAR struct mm_cachenode_s *head,
+                               FAR struct mm_cachenode_s *tail,
+                               unsigned int count)
+{
+  tail->flink = bin->head;
+  bin->head   = head;
+  bin->count += count;
+}
+
+/****************************************************************************
+ * Name: mm_cachebin_detach
+ *
+ * Description:
+ *   Remove up to count chunks from the head of a bin and return them as a
+ *   NULL terminated list.  Local interrupts must be disabled.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_cachenode_s *
+mm_cachebin_detach(FAR struct mm_cachebin_s *bin, unsigned int count)
+{
+  FAR struct mm_cachenode_s *head = bin->head;
+  FAR struct mm_cachenode_s *tail = head;
+  unsigned int n;
+
+  DEBUGASSERT(head != NULL && count > 0 && count <= bin->count);
+
+  for (n = 1; n < count; n++)
+    {
+      tail = tail->flink;
+    }
+
+  bin->head   = tail->flink;
+  bin->count -= count;
+  tail->flink = NULL;
+
+  return head;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cpucache_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly alignsize bytes from the current CPU's cache.
+ *   If the cache is empty it is refilled with a batch of chunks taken from
+ *   the heap under a single hold of the heap semaphore.
+ *
+ * Input Parameters:
+ *   heap      - The heap to allocate from
+ *   alignsize - Chunk size including the allocation header
+ *
+ * Returned Value:
+ *   The allocated chunk, or NULL if the request is not cacheable or no
+ *   chunk could be obtained; the caller then falls back to the heap.
+ *
+ ****************************************************************************/
+
+FAR struct mm_allocnode_s *mm_cpucache_alloc(FAR struct mm_heap_s *heap,
+                                             size_t alignsize)
+{
+  FAR struct mm_cpucache_s *cache;
+  FAR struct mm_cachebin_s *bin;
+  FAR struct mm_cachenode_s *cnode;
+  FAR struct mm_cachenode_s *head = NULL;
+  FAR struct mm_cachenode_s *tail = NULL;
+  FAR struct mm_allocnode_s *ret = NULL;
+  unsigned int count = 0;
+  irqstate_t flags;
+  int ndx;
+
+  if (alignsize > MM_CPUCACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx = MM_CPUCACHE_NDX(alignsize);
+
+  /* Fast path: pop from this CPU's bin with only local interrupts
+   * disabled.
+   */
+
+  flags = up_irq_save();
+  cache = &heap->mm_cpucache[up_cpu_index()];
+  bin   = &cache->bins[ndx];
+
+  cnode = bin->head;
+  if (cnode != NULL)
+    {
+      bin->head = cnode->flink;
+      bin->count--;
+      cache->hits++;
+      up_irq_restore(flags);
+
+      return mm_cachenode2chunk(cnode);
+    }
+
+  cache->misses++;
+  up_irq_restore(flags);
+
+  /* Slow path: refill a whole batch while holding the heap semaphore
+   * once.  The first chunk satisfies this request, the rest are cached.
+   */
+
+  if (mm_takesemaphore(heap) == false)
+    {
+      return NULL;
+    }
+
+  ret = mm_allocchunk(heap, alignsize);
+  if (ret != NULL)
+    {
+      while (++count < MM_CPUCACHE_BATCH)
+        {
+          FAR struct mm_allocnode_s *node = mm_allocchunk(heap, alignsize);
+
+          if (node == NULL)
+            {
+              break;
+            }
+
+          /* Chunk sizes are granule multiples, so a split never leaves a
+           * carried remainder and the chunk size is exact.
+           */
+
+          DEBUGASSERT(node->size == alignsize);
+
+          cnode = (FAR struct mm_cachenode_s *)
+                  ((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+          cnode->flink = head;
+          head = cnode;
+          if (tail == NULL)
+            {
+              tail = cnode;
+            }
+        }
+    }
+
+  mm_givesemaphore(heap);
+
+  if (head != NULL)
+    {
+      /* We may have migrated while waiting for the semaphore, so look up
+       * the current CPU's cache again.
+       */
+
+      flags = up_irq_save();
+      cache = &heap->mm_cpucache[up_cpu_index()];
+      mm_cachebin_splice(&cache->bins[ndx], head, tail, count - 1);
+      cache->refills++;
+      up_irq_restore(flags);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_free
+ *
+ * Description:
+ *   Park a small chunk in the current CPU's cache.  When a bin grows past
+ *   CONFIG_MM_HEAP_CPUCACHE_NBLOCKS, half of it is returned to the heap
+ *   under a single hold of the heap semaphore.
+ *
+ * Input Parameters:
+ *   heap - The heap that owns the memory
+ *   mem  - The user memory to release
+ *
+ * Returned Value:
+ *   true if the chunk was consumed by the cache; false if the caller must
+ *   free it through the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cpucache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cpucache_s *cache;
+  FAR struct mm_cachebin_s *bin;
+  FAR struct mm_cachenode_s *cnode = mem;
+  FAR struct mm_cachenode_s *drain = NULL;
+  irqstate_t flags;
+  int ndx;
+
+  node = mm_cachenode2chunk(cnode);
+  if (node->size > MM_CPUCACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  /* Sanity check against frees of foreign or already free memory */
+
+  DEBUGASSERT(mm_heapmember(heap, mem));
+  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
+
+  ndx = MM_CPUCACHE_NDX(node->size);
+
+  /* Poison before publishing the chunk, a nested allocation on this CPU
+   * may reuse it as soon as it is linked.
+   */
+
+  kasan_poison(mem, node->size - SIZEOF_MM_ALLOCNODE);
+
+  flags = up_irq_save();
+  cache = &heap->mm_cpucache[up_cpu_index()];
+  bin   = &cache->bins[ndx];
+
+  cnode->flink = bin->head;
+  bin->head    = cnode;
+  bin->count++;
+
+  if (bin->count > CONFIG_MM_HEAP_CPUCACHE_NBLOCKS)
+    {
+      drain = mm_cachebin_detach(bin, MM_CPUCACHE_BATCH);
+    }
+
+  up_irq_restore(flags);
+
+  if (drain == NULL)
+    {
+      return true;
+    }
+
+  /* Return the batch to the heap.  If the semaphore can't be taken in this
+   * context, simply keep the chunks cached for a later drain.
+   */
+
+  if (mm_takesemaphore(heap))
+    {
+      while (drain != NULL)
+        {
+          cnode = drain;
+          drain = drain->flink;
+          mm_freechunk(heap, (FAR struct mm_freenode_s *)
+                             mm_cachenode2chunk(cnode));
+        }
+
+      mm_givesemaphore(heap);
+
+      flags = up_irq_save();
+      heap->mm_cpucache[up_cpu_index()].drains++;
+      up_irq_restore(flags);
+    }
+  else
+    {
+      FAR struct mm_cachenode_s *tail = drain;
+
+      while (tail->flink != NULL)
+        {
+          tail = tail->flink;
+        }
+
+      flags = up_irq_save();
+      cache = &heap->mm_cpucache[up_cpu_index()];
+      mm_cachebin_splice(&cache->bins[ndx], drain, tail, MM_CPUCACHE_BATCH);
+      up_irq_restore(flags);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Return the accumulated per-CPU cache statistics of a heap.  Chunks held
+ *   in the caches are still reported as used by mm_mallinfo().
+ *
+ ****************************************************************************/
+
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_cacheinfo_s *info)
+{
+  int cpu;
+  int ndx;
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mm_cpucache_s *cache = &heap->mm_cpucache[cpu];
+
+      info->hits    += cache->hits;
+      info->misses  += cache->misses;
+      info->refills += cache->refills;
+      info->drains  += cache->drains;
+
+      for (ndx = 0; ndx < MM_CPUCACHE_NBINS; ndx++)
+        {
+          info->ncached += cache->bins[ndx].count;
+          info->cached  += (size_t)cache->bins[ndx].count *
+                           ((ndx + 1) << MM_MIN_SHIFT);
+        }
+    }
+}
+
+#endif /* CONFIG_MM_HEAP_CPUCACHE */
@@ -59,49 +59,19 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_free
+ * Name: mm_freechunk
  *
  * Description:
- *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   Mark an allocated chunk free, merge it with the adjacent free chunks
+ *   and put the result back into the free list.  The caller must hold the
+ *   heap semaphore.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 {
-  FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
   FAR struct mm_freenode_s *next;
-  int ret;
-
-  UNUSED(ret);
-  minfo("Freeing %p\n", mem);
-
-  /* Protect against attempts to free a NULL reference */
-
-  if (!mem)
-    {
-      return;
-    }
-
-  if (mm_takesemaphore(heap) == false)
-    {
-      /* Meet -ESRCH return, which means we are in situations
-       * during context switching(See mm_takesemaphore() & getpid()).
-       * Then add to the delay list.
-       */
-
-      mm_add_delaylist(heap, mem);
-      return;
-    }
-
-  kasan_poison(mem, mm_malloc_size(mem));
-
-  DEBUGASSERT(mm_heapmember(heap, mem));
-
-  /* Map the memory chunk into a free node */
-
-  node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
 
   /* Sanity check against double-frees */
 
@@ -125,16 +95,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       andbeyond = (FAR struct mm_allocnode_s *)
                     ((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -152,16 +115,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -173,6 +129,56 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+  /* Small chunks are parked in this CPU's cache if there is room */
+
+  if (mm_cpucache_free(heap, mem))
+    {
+      return;
+    }
+#endif
+
+  if (mm_takesemaphore(heap) == false)
+    {
+      /* Meet -ESRCH return, which means we are in situations
+       * during context switching(See mm_takesemaphore() & getpid()).
+       * Then add to the delay list.
+       */
+
+      mm_add_delaylist(heap, mem);
+      return;
+    }
+
+  kasan_poison(mem, mm_malloc_size(mem));
+
+  DEBUGASSERT(mm_heapmember(heap, mem));
+
+  /* Map the memory chunk into a free node and release it */
+
+  mm_freechunk(heap, (FAR struct mm_freenode_s *)
+                     ((FAR char *)mem - SIZEOF_MM_ALLOCNODE));
 
   mm_givesemaphore(heap);
 }
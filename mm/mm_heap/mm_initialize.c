@@ -179,7 +179,9 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 {
   FAR struct mm_heap_s *heap;
   uintptr_t             heap_adj;
+#ifndef CONFIG_MM_HEAP_TLSF
   int                   i;
+#endif
 
   minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
 
@@ -202,6 +204,7 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 
   memset(heap, 0, sizeof(struct mm_heap_s));
 
+#ifndef CONFIG_MM_HEAP_TLSF
   /* Initialize the node array */
 
   for (i = 1; i < MM_NNODES; i++)
@@ -209,6 +212,7 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
       heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
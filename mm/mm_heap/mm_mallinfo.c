@@ -58,6 +58,12 @@ static void mallinfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+#ifdef CONFIG_MM_HEAP_TLSF
+      DEBUGASSERT(fnode->blink == NULL ||
+                  fnode->blink->flink == fnode);
+      DEBUGASSERT(fnode->flink == NULL ||
+                  fnode->flink->blink == fnode);
+#else
       DEBUGASSERT(fnode->blink->flink == fnode);
       DEBUGASSERT(fnode->blink->size <= fnode->size);
       DEBUGASSERT(fnode->flink == NULL ||
@@ -65,6 +71,7 @@ static void mallinfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       DEBUGASSERT(fnode->flink == NULL ||
                   fnode->flink->size == 0 ||
                   fnode->flink->size >= fnode->size);
+#endif
 
       info->ordblks++;
       info->fordblks += node->size;
@@ -92,84 +92,31 @@ void mm_dump_handler(FAR struct tcb_s *tcb, FAR void *arg)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
+ *  Find the smallest free chunk that holds alignsize bytes, remove it from
+ *  the free list, split off the unused remainder and mark it allocated.
+ *  The caller must hold the heap semaphore.
  *
- *  8-byte alignment of the allocated data is assured.
+ * Input Parameters:
+ *   heap      - The heap to allocate from
+ *   alignsize - Chunk size including the allocation header, already
+ *               aligned to MM_MIN_CHUNK
+ *
+ * Returned Value:
+ *   The allocated chunk, or NULL if no free chunk is large enough.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+FAR struct mm_allocnode_s *mm_allocchunk(FAR struct mm_heap_s *heap,
+                                         size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
-  FAR void *ret = NULL;
-  int ndx;
-
-  /* Free the delay list first */
-
-  mm_free_delaylist(heap);
-
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
-   */
-
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  if (alignsize < size)
-    {
-      /* There must have been an integer overflow */
 
-      return NULL;
-    }
-
-  DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
-  DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  DEBUGVERIFY(mm_takesemaphore(heap));
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
-
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES - 1;
-    }
-  else
-    {
-      /* Convert the request size into a nodelist index */
+  /* Find the best fitting free chunk */
 
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-    }
-
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
-   */
+  node = mm_findfreechunk(heap, alignsize);
 
   if (node)
     {
@@ -177,16 +124,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -229,11 +169,82 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       /* Handle the case of an exact size match */
 
       node->preceding |= MM_ALLOC_BIT;
+    }
+
+  return (FAR struct mm_allocnode_s *)node;
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_allocnode_s *node;
+  size_t alignsize;
+  FAR void *ret = NULL;
+
+  /* Free the delay list first */
+
+  mm_free_delaylist(heap);
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  if (alignsize < size)
+    {
+      /* There must have been an integer overflow */
+
+      return NULL;
+    }
+
+  DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
+  DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
+
+#ifdef CONFIG_MM_HEAP_CPUCACHE
+  /* Small requests are served from this CPU's cache without touching the
+   * heap semaphore.
+   */
+
+  node = mm_cpucache_alloc(heap, alignsize);
+  if (node != NULL)
+    {
       ret = (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
+  else
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the
+       * nodelist.
+       */
+
+      DEBUGVERIFY(mm_takesemaphore(heap));
+
+      node = mm_allocchunk(heap, alignsize);
+      if (node != NULL)
+        {
+          ret = (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+        }
 
-  DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
-  mm_givesemaphore(heap);
+      DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
+      mm_givesemaphore(heap);
+    }
 
   if (ret)
     {
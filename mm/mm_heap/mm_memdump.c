@@ -104,6 +104,12 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+#ifdef CONFIG_MM_HEAP_TLSF
+      DEBUGASSERT(fnode->blink == NULL ||
+                  fnode->blink->flink == fnode);
+      DEBUGASSERT(fnode->flink == NULL ||
+                  fnode->flink->blink == fnode);
+#else
       DEBUGASSERT(fnode->blink->flink == fnode);
       DEBUGASSERT(fnode->blink->size <= fnode->size);
       DEBUGASSERT(fnode->flink == NULL ||
@@ -111,6 +117,7 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       DEBUGASSERT(fnode->flink == NULL ||
                   fnode->flink->size == 0 ||
                   fnode->flink->size >= fnode->size);
+#endif
 
       if (info->pid <= -2)
         {
@@ -223,16 +223,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           FAR struct mm_allocnode_s *newnode;
 
-          /* Remove the previous node.  There must be a predecessor, but
-           * there may not be a successor node.
-           */
+          /* Remove the previous node from the free list */
 
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          mm_delfreechunk(heap, prev);
 
           /* Extend the node into the previous free chunk */
 
@@ -291,16 +284,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
           andbeyond = (FAR struct mm_allocnode_s *)
                       ((FAR char *)next + nextsize);
 
-          /* Remove the next node.  There must be a predecessor, but there
-           * may not be a successor node.
-           */
+          /* Remove the next node from the free list */
 
-          DEBUGASSERT(next->blink);
-          next->blink->flink = next->flink;
-          if (next->flink)
-            {
-              next->flink->blink = next->blink;
-            }
+          mm_delfreechunk(heap, next);
 
           /* Extend the node into the next chunk */
 
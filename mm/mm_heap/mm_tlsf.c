@@ -0,0 +1,221 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <strings.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+#ifdef CONFIG_MM_HEAP_TLSF
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_mapping
+ *
+ * Description:
+ *   Convert a chunk size into its first and second level class indices.
+ *
+ ****************************************************************************/
+
+static inline void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  if (size < MM_TLSF_SMALLBLOCK)
+    {
+      /* Small chunks are mapped linearly, one class per granule */
+
+      *fl = 0;
+      *sl = size >> MM_MIN_SHIFT;
+    }
+  else
+    {
+      int msb = flsl((long)size) - 1;
+
+      *fl = msb - MM_TLSF_FLSHIFT + 1;
+      *sl = (size >> (msb - MM_TLSF_SLI)) ^ MM_TLSF_SLCOUNT;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of its size class list.  It is assumed
+ *   that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *head;
+  int fl;
+  int sl;
+
+  DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) == 0);
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  head        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = head;
+  if (head)
+    {
+      head->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_flbitmap        |= (uint32_t)1 << fl;
+  heap->mm_slbitmap[fl]    |= (uint32_t)1 << sl;
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its size class list.  The chunk size must not
+ *   have been changed since it was added.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      int fl;
+      int sl;
+
+      /* This is the head of the list, update the list and the bitmaps */
+
+      mm_tlsf_mapping(node->size, &fl, &sl);
+      DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+
+      heap->mm_freelist[fl][sl] = node->flink;
+      if (node->flink == NULL)
+        {
+          heap->mm_slbitmap[fl] &= ~((uint32_t)1 << sl);
+          if (heap->mm_slbitmap[fl] == 0)
+            {
+              heap->mm_flbitmap &= ~((uint32_t)1 << fl);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least size bytes in constant time.  The size is
+ *   rounded up to the next class boundary so that the head of any non-empty
+ *   class found is guaranteed to fit.  The chunk is not removed from its
+ *   list.  It is assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  size_t round = 0;
+  uint32_t map;
+  int fl = MM_TLSF_FLCOUNT;
+  int sl;
+
+  if (size > MMSIZE_MAX)
+    {
+      return NULL;
+    }
+
+  if (size >= MM_TLSF_SMALLBLOCK)
+    {
+      round = ((size_t)1 << (flsl((long)size) - 1 - MM_TLSF_SLI)) - 1;
+    }
+
+  /* The rounded size would wrap around with a 32-bit size_t if it does
+   * not fit in a chunk size.  No class is guaranteed to fit then.
+   */
+
+  if (size <= MMSIZE_MAX - round)
+    {
+      mm_tlsf_mapping(size + round, &fl, &sl);
+    }
+
+  if (fl < MM_TLSF_FLCOUNT)
+    {
+      /* Look for a non-empty class at or above (fl, sl) */
+
+      map = heap->mm_slbitmap[fl] & (~(uint32_t)0 << sl);
+      if (map == 0)
+        {
+          map = heap->mm_flbitmap & (~(uint32_t)0 << (fl + 1));
+          if (map != 0)
+            {
+              fl  = ffs(map) - 1;
+              map = heap->mm_slbitmap[fl];
+            }
+        }
+
+      if (map != 0)
+        {
+          sl   = ffs(map) - 1;
+          node = heap->mm_freelist[fl][sl];
+
+          DEBUGASSERT(node != NULL && node->size >= size);
+          return node;
+        }
+    }
+
+  /* No class is guaranteed to fit.  As in TLSF, the class of the request
+   * itself is not searched, that would take a walk of its free list.  The
+   * request fails even if that class holds a large enough chunk; the
+   * memory given up is less than one second level step of the size.
+   */
+
+  return NULL;
+}
+
+#endif /* CONFIG_MM_HEAP_TLSF */
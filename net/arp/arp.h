@@ -145,10 +145,30 @@ struct arp_notify_s
 };
 #endif
 
+#ifdef CONFIG_NET_ARP
+/* ARP table counters */
+
+struct arp_stats_s
+{
+  uint32_t hits;                       /* Lookups that found a mapping */
+  uint32_t misses;                     /* Lookups that did not */
+  uint32_t evicted;                    /* Valid mappings replaced when full */
+  uint32_t expired;                    /* Mappings removed by the aging */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_ARP
+/* The ARP table counters.  The network should be locked when accessing
+ * them.
+ */
+
+extern struct arp_stats_s g_arpstats;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -351,12 +371,16 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr);
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
+ * Returned Value:
+ *   Zero (OK) if the association was removed; -ENOENT if it was not in the
+ *   ARP table.
+ *
  * Assumptions
  *   The network is locked to assure exclusive access to the ARP table.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr);
+int arp_delete(in_addr_t ipaddr);
 
 /****************************************************************************
  * Name: arp_cleanup
@@ -449,6 +473,26 @@ unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
 #  define arp_snapshot(s,n) (0)
 #endif
 
+/****************************************************************************
+ * Name: arp_get
+ *
+ * Description:
+ *   Return a copy of one slot of the ARP table.
+ *
+ * Input Parameters:
+ *   index - The slot of the ARP table, 0 .. CONFIG_NET_ARPTAB_SIZE - 1
+ *   entry - Location to return the ARP table entry
+ *
+ * Returned Value:
+ *   Zero (OK) if the slot holds a valid mapping; -ENOENT if it does not.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table
+ *
+ ****************************************************************************/
+
+int arp_get(unsigned int index, FAR struct arp_entry_s *entry);
+
 /****************************************************************************
  * Name: arp_dump
  *
@@ -481,11 +525,12 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_wait(n,t) (0)
 #  define arp_notify(i)
 #  define arp_find(i,e) (-ENOSYS)
-#  define arp_delete(i)
+#  define arp_delete(i) (-ENOSYS)
 #  define arp_cleanup(d)
 #  define arp_update(d,i,m);
 #  define arp_hdr_update(d,i,m);
 #  define arp_snapshot(s,n) (0)
+#  define arp_get(i,e) (-ENOSYS)
 #  define arp_dump(arp)
 
 #endif /* CONFIG_NET_ARP */
@@ -104,6 +104,12 @@ void arp_format(FAR struct net_driver_s *dev, in_addr_t ipaddr)
 
   eth->type        = HTONS(ETHTYPE_ARP);
   dev->d_len       = sizeof(struct arp_hdr_s) + ETH_HDRLEN;
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The IP packet that this may replace had offload requests */
+
+  dev->d_pktflags  = 0;
+#endif
 }
 
 #endif /* CONFIG_NET_ARP */
@@ -49,12 +49,16 @@
 #include <sys/ioctl.h>
 #include <stdint.h>
 #include <string.h>
+#include <queue.h>
+#include <errno.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <netinet/in.h>
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -72,6 +76,12 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+#if (CONFIG_NET_ARP_HASHSIZE & (CONFIG_NET_ARP_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_ARP_HASHSIZE must be a power of two
+#endif
+
+#define ARP_HASHMASK    (CONFIG_NET_ARP_HASHSIZE - 1)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,13 +92,49 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One slot of the ARP table.  Slots in use are linked into a hash chain and
+ * into the age list; free slots are linked into the free list through
+ * te_hnext.
+ */
+
+struct arp_tabent_s
+{
+  dq_entry_t                  te_node;  /* Age list link, oldest first */
+  FAR struct arp_tabent_s    *te_hnext; /* Next slot in the hash chain */
+  struct arp_entry_s          te_entry; /* The address mapping */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 /* The table of known address mappings */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct arp_tabent_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+
+/* The hash chains, the slots in use ordered by the time of their last
+ * update and the slots that have been released.  g_arpnused counts the
+ * slots that have ever been used, the others are free too.
+ */
+
+static FAR struct arp_tabent_s *g_arphash[CONFIG_NET_ARP_HASHSIZE];
+static dq_queue_t g_arpage;
+static FAR struct arp_tabent_s *g_arpfree;
+static unsigned int g_arpnused;
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+/* Removes the expired mappings */
+
+static struct work_s g_arpwork;
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The ARP table counters */
+
+struct arp_stats_s g_arpstats;
 
 /****************************************************************************
  * Private Functions
@@ -141,34 +187,176 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_hash
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return the hash chain of an IP address.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static inline FAR struct arp_tabent_s **arp_hash(in_addr_t ipaddr)
 {
-  if (e1->at_ipaddr == 0)
+  uint32_t hash = (uint32_t)ipaddr;
+
+  /* Fold all bytes of the address into the lower half, then spread the
+   * lower half over the upper half that the bucket is taken from.
+   */
+
+  hash ^= hash >> 16;
+  hash  = (hash * 0x9e3779b1) >> 16;
+  return &g_arphash[hash & ARP_HASHMASK];
+}
+
+/****************************************************************************
+ * Name: arp_findentry
+ *
+ * Description:
+ *   Find the slot of the ARP table holding the mapping of an IP address,
+ *   whatever its age.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_tabent_s *arp_findentry(in_addr_t ipaddr)
+{
+  FAR struct arp_tabent_s *tabent;
+
+  for (tabent = *arp_hash(ipaddr); tabent != NULL; tabent = tabent->te_hnext)
     {
-      return e1;
+      if (net_ipv4addr_cmp(ipaddr, tabent->te_entry.at_ipaddr))
+        {
+          break;
+        }
     }
-  else if (e2->at_ipaddr == 0)
+
+  return tabent;
+}
+
+/****************************************************************************
+ * Name: arp_unhash
+ *
+ * Description:
+ *   Remove a slot in use from its hash chain and from the age list.
+ *
+ ****************************************************************************/
+
+static void arp_unhash(FAR struct arp_tabent_s *tabent)
+{
+  FAR struct arp_tabent_s **link;
+
+  for (link = arp_hash(tabent->te_entry.at_ipaddr); *link != NULL;
+       link = &(*link)->te_hnext)
+    {
+      if (*link == tabent)
+        {
+          *link = tabent->te_hnext;
+          break;
+        }
+    }
+
+  dq_rem(&tabent->te_node, &g_arpage);
+}
+
+/****************************************************************************
+ * Name: arp_release
+ *
+ * Description:
+ *   Return a slot in use to the free list.
+ *
+ ****************************************************************************/
+
+static void arp_release(FAR struct arp_tabent_s *tabent)
+{
+  arp_unhash(tabent);
+  memset(&tabent->te_entry, 0, sizeof(struct arp_entry_s));
+
+  tabent->te_hnext = g_arpfree;
+  g_arpfree        = tabent;
+}
+
+/****************************************************************************
+ * Name: arp_allocentry
+ *
+ * Description:
+ *   Allocate a slot for a new mapping.  If the table is full, the mapping
+ *   that has not been updated for the longest time is replaced.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_tabent_s *arp_allocentry(void)
+{
+  FAR struct arp_tabent_s *tabent;
+
+  if (g_arpfree != NULL)
     {
-      return e2;
+      tabent    = g_arpfree;
+      g_arpfree = tabent->te_hnext;
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+  else if (g_arpnused < CONFIG_NET_ARPTAB_SIZE)
     {
-      return e1;
+      tabent = &g_arptable[g_arpnused++];
     }
   else
     {
-      return e2;
+      tabent = (FAR struct arp_tabent_s *)dq_peek(&g_arpage);
+      DEBUGASSERT(tabent != NULL);
+
+      arp_unhash(tabent);
+      g_arpstats.evicted++;
+    }
+
+  return tabent;
+}
+
+/****************************************************************************
+ * Name: arp_age_schedule and arp_age_work
+ *
+ * Description:
+ *   The mappings expire in the order of the age list.  Schedule the work
+ *   to run when the oldest mapping expires, then remove all expired
+ *   mappings from the head of the list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+static void arp_age_work(FAR void *arg);
+
+static void arp_age_schedule(clock_t now)
+{
+  FAR struct arp_tabent_s *tabent;
+  clock_t elapsed;
+
+  tabent = (FAR struct arp_tabent_s *)dq_peek(&g_arpage);
+  if (tabent != NULL && work_available(&g_arpwork))
+    {
+      elapsed = now - tabent->te_entry.at_time;
+      work_queue(LPWORK, &g_arpwork, arp_age_work, NULL,
+                 elapsed < ARP_MAXAGE_TICK ?
+                 ARP_MAXAGE_TICK + 1 - elapsed : 1);
     }
 }
 
+static void arp_age_work(FAR void *arg)
+{
+  FAR struct arp_tabent_s *tabent;
+  clock_t now;
+
+  net_lock();
+
+  now = clock_systime_ticks();
+  while ((tabent = (FAR struct arp_tabent_s *)dq_peek(&g_arpage)) != NULL &&
+         now - tabent->te_entry.at_time > ARP_MAXAGE_TICK)
+    {
+      arp_release(tabent);
+      g_arpstats.expired++;
+    }
+
+  arp_age_schedule(now);
+  net_unlock();
+}
+#else
+#  define arp_age_schedule(n)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -197,44 +385,42 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_tabent_s *tabent;
+  FAR struct arp_tabent_s **bucket;
+  clock_t now = clock_systime_ticks();
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Try to find an entry to update.  If none is found, the IP -> MAC
+   * address mapping is inserted in the ARP table.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabent = arp_findentry(ipaddr);
+  if (tabent != NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
+      /* An old entry found, it becomes the most recently updated one */
 
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
+      dq_rem(&tabent->te_node, &g_arpage);
+    }
+  else
+    {
+      tabent = arp_allocentry();
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      bucket           = arp_hash(ipaddr);
+      tabent->te_hnext = *bucket;
+      *bucket          = tabent;
     }
 
-  /* Now, tabptr is the ARP table entry which we will fill with the new
+  /* Now, tabent is the ARP table entry which we will fill with the new
    * information.
    */
 
-  tabptr->at_ipaddr = ipaddr;
-  memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
-  tabptr->at_time = clock_systime_ticks();
+  tabent->te_entry.at_ipaddr = ipaddr;
+  memcpy(tabent->te_entry.at_ethaddr.ether_addr_octet, ethaddr,
+         ETHER_ADDR_LEN);
+  tabent->te_entry.at_dev    = dev;
+  tabent->te_entry.at_time   = now;
+
+  dq_addlast(&tabent->te_node, &g_arpage);
+  arp_age_schedule(now);
   return OK;
 }
 
@@ -286,19 +472,17 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
 
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  FAR struct arp_tabent_s *tabent;
 
-  /* Check if the IPv4 address is already in the ARP table. */
+  /* Check if the IPv4 address is already in the ARP table.  The aging may
+   * not have removed an expired entry yet.
+   */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabent = arp_findentry(ipaddr);
+  if (tabent != NULL &&
+      clock_systime_ticks() - tabent->te_entry.at_time <= ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      return &tabent->te_entry;
     }
 
   /* Not found */
@@ -348,6 +532,7 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
        * address mapping is available for the IP address.
        */
 
+      g_arpstats.hits++;
       return OK;
     }
 
@@ -366,6 +551,7 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
   /* Not found */
 
+  g_arpstats.misses++;
   return -ENOENT;
 }
 
@@ -378,24 +564,29 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
+ * Returned Value:
+ *   Zero (OK) if the association was removed; -ENOENT if it was not in the
+ *   ARP table.
+ *
  * Assumptions
  *   The network is locked to assure exclusive access to the ARP table.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr)
+int arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_tabent_s *tabent;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
-  if (tabptr != NULL)
+  tabent = arp_findentry(ipaddr);
+  if (tabent == NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
-
-      tabptr->at_ipaddr = 0;
+      return -ENOENT;
     }
+
+  arp_release(tabent);
+  return OK;
 }
 
 /****************************************************************************
@@ -414,13 +605,14 @@ void arp_delete(in_addr_t ipaddr)
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
-  int i;
+  unsigned int i;
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  for (i = 0; i < g_arpnused; ++i)
     {
-      if (dev == g_arptable[i].at_dev)
+      if (g_arptable[i].te_entry.at_ipaddr != 0 &&
+          g_arptable[i].te_entry.at_dev == dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_release(&g_arptable[i]);
         }
     }
 }
@@ -449,22 +641,17 @@ void arp_cleanup(FAR struct net_driver_s *dev)
 unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
                           unsigned int nentries)
 {
-  FAR struct arp_entry_s *tabptr;
-  clock_t now;
   unsigned int ncopied;
-  int i;
+  unsigned int i;
 
   /* Copy all non-empty, non-expired entries in the ARP table. */
 
-  for (i = 0, now = clock_systime_ticks(), ncopied = 0;
+  for (i = 0, ncopied = 0;
        nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
        i++)
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      if (arp_get(i, &snapshot[ncopied]) >= 0)
         {
-          memcpy(&snapshot[ncopied], tabptr, sizeof(struct arp_entry_s));
           ncopied++;
         }
     }
@@ -475,5 +662,43 @@ unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
 }
 #endif
 
+/****************************************************************************
+ * Name: arp_get
+ *
+ * Description:
+ *   Return a copy of one slot of the ARP table.
+ *
+ * Input Parameters:
+ *   index - The slot of the ARP table, 0 .. CONFIG_NET_ARPTAB_SIZE - 1
+ *   entry - Location to return the ARP table entry
+ *
+ * Returned Value:
+ *   Zero (OK) if the slot holds a valid mapping; -ENOENT if it does not.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table
+ *
+ ****************************************************************************/
+
+int arp_get(unsigned int index, FAR struct arp_entry_s *entry)
+{
+  FAR struct arp_entry_s *tabptr;
+
+  if (index >= g_arpnused)
+    {
+      return -ENOENT;
+    }
+
+  tabptr = &g_arptable[index].te_entry;
+  if (tabptr->at_ipaddr == 0 ||
+      clock_systime_ticks() - tabptr->at_time > ARP_MAXAGE_TICK)
+    {
+      return -ENOENT;
+    }
+
+  memcpy(entry, tabptr, sizeof(struct arp_entry_s));
+  return OK;
+}
+
 #endif /* CONFIG_NET_ARP */
 #endif /* CONFIG_NET */
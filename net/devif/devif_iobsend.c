@@ -31,6 +31,8 @@
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 
+#include "utils/utils.h"
+
 #ifdef CONFIG_MM_IOB
 
 /****************************************************************************
@@ -55,16 +57,18 @@
 void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                     unsigned int len, unsigned int offset)
 {
-  if (dev == NULL || len == 0 || len >= NETDEV_PKTSIZE(dev))
+  if (dev == NULL || len == 0 || len >= NETDEV_MAXPKTSIZE(dev))
     {
       nerr("devif_iob_send error, %p, send len: %u, pkt len: %u\n",
-                                          dev, len, NETDEV_PKTSIZE(dev));
+                                          dev, len, NETDEV_MAXPKTSIZE(dev));
       return;
     }
 
-  /* Copy the data from the I/O buffer chain to the device buffer */
+  /* Copy the data from the I/O buffer chain to the device buffer, summing
+   * it for the checksum of the TCP or UDP segment at the same time.
+   */
 
-  iob_copyout(dev->d_appdata, iob, len, offset);
+  dev->d_sndsum = chksum_iob_copyout(0, dev->d_appdata, iob, len, offset);
   dev->d_sndlen = len;
 
 #ifdef CONFIG_NET_TCP_WRBUFFER_DUMP
@@ -105,6 +105,14 @@ int devif_loopback(FAR struct net_driver_s *dev)
        pkt_input(dev);
 #endif
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+      /* The packet never left the host.  Whatever checksums were left to
+       * the device need not be checked.
+       */
+
+      dev->d_pktflags = NETDEV_PKT_RXCSUM_OK;
+#endif
+
       /* We only accept IP packets of the configured type */
 
 #ifdef CONFIG_NET_IPv4
@@ -142,5 +150,9 @@ int devif_loopback(FAR struct net_driver_s *dev)
     }
   while (dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  dev->d_pktflags = 0;
+#endif
+
   return 1;
 }
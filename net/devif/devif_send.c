@@ -48,6 +48,7 @@
 #include <nuttx/net/netdev.h>
 
 #include "devif/devif.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Public Functions
@@ -69,6 +70,10 @@ void devif_send(struct net_driver_s *dev, const void *buf, int len)
 {
   DEBUGASSERT(dev != NULL && len > 0 && len < NETDEV_PKTSIZE(dev));
 
-  memcpy(dev->d_appdata, buf, len);
+  /* Sum the data while copying it, for the checksum of the TCP or UDP
+   * segment that it will be sent in.
+   */
+
+  dev->d_sndsum = chksum_copy(0, dev->d_appdata, buf, len);
   dev->d_sndlen = len;
 }
@@ -151,6 +151,10 @@ int ipv4_input(FAR struct net_driver_s *dev)
   g_netstats.ipv4.recv++;
 #endif
 
+  /* Nothing of the received packet has been summed yet */
+
+  dev->d_sndsum = 0;
+
   /* Start of IP input header processing code.
    *
    * Check validity of the IP header.
@@ -331,9 +335,9 @@ int ipv4_input(FAR struct net_driver_s *dev)
     }
 #endif
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM_VERIFIED(dev) && ipv4_chksum(dev) != 0xffff)
     {
-      /* Compute and check the IP header checksum. */
+      /* Compute and check the IP header checksum, unless the device did. */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.ipv4.drop++;
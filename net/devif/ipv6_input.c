@@ -235,6 +235,10 @@ int ipv6_input(FAR struct net_driver_s *dev)
   g_netstats.ipv6.recv++;
 #endif
 
+  /* Nothing of the received packet has been summed yet */
+
+  dev->d_sndsum = 0;
+
   /* Start of IP input header processing code.
    *
    * Check validity of the IP header.
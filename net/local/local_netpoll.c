@@ -136,7 +136,7 @@ void local_event_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -289,7 +289,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(fds);
   return OK;
 #endif
 }
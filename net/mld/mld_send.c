@@ -173,6 +173,7 @@ void mld_send(FAR struct net_driver_s *dev, FAR struct mld_group_s *group,
    */
 
   dev->d_sndlen  = RASIZE + mldsize;
+  dev->d_sndsum  = 0;
 
   /* Set up the IPv6 header */
 
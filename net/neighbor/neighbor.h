@@ -27,9 +27,11 @@
  ****************************************************************************/
 
 #include <stdint.h>
+#include <queue.h>
 
 #include <net/ethernet.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -37,15 +39,67 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_NET_IPv6_NCONF_HASHSIZE & \
+     (CONFIG_NET_IPv6_NCONF_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_IPv6_NCONF_HASHSIZE must be a power of two
+#endif
+
+#define NEIGHBOR_MAXAGE_TICK SEC2TICK(CONFIG_NET_IPv6_NCONF_MAXAGE)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One slot of the Neighbor table.  Slots in use are linked into a hash
+ * chain and into the age list; free slots are linked into the free list
+ * through nt_hnext.
+ */
+
+struct neighbor_tabent_s
+{
+  dq_entry_t                     nt_node;  /* Age list link, oldest first */
+  FAR struct neighbor_tabent_s  *nt_hnext; /* Next slot in the hash chain */
+  struct neighbor_entry_s        nt_entry; /* The address mapping */
+};
+
+/* Neighbor table counters */
+
+struct neighbor_stats_s
+{
+  uint32_t hits;                  /* Lookups that found a mapping */
+  uint32_t misses;                /* Lookups that did not */
+  uint32_t evicted;               /* Valid mappings replaced when full */
+  uint32_t expired;               /* Mappings removed by the aging */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
 /* This is the Neighbor table.  The network should be locked when accessing
- * this table.
+ * this table or any of the data below.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern struct neighbor_tabent_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The hash chains, the slots in use ordered by the time of their last
+ * update and the slots that have been released.  g_neighbor_nused counts
+ * the slots that have ever been used, the others are free too.
+ */
+
+extern FAR struct neighbor_tabent_s *
+  g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+extern dq_queue_t g_neighbor_age;
+extern FAR struct neighbor_tabent_s *g_neighbor_free;
+extern unsigned int g_neighbor_nused;
+
+/* The Neighbor table counters */
+
+extern struct neighbor_stats_s g_neighbor_stats;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -64,12 +118,67 @@ struct net_driver_s; /* Forward reference */
  *   ipaddr - The IPv6 address to use in the lookup;
  *
  * Returned Value:
- *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
- *   returned if there is no matching entry in the Neighbor Table.
+ *   The Neighbor Table slot corresponding to the IPv6 address;  NULL is
+ *   returned if there is no matching entry in the Neighbor Table or if it
+ *   has expired.
  *
  ****************************************************************************/
 
-FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
+FAR struct neighbor_tabent_s *
+neighbor_findentry(const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain of an IPv6 address.  This interface is internal
+ *   to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address
+ *
+ * Returned Value:
+ *   The head of the hash chain.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_tabent_s **neighbor_hash(const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_allocentry
+ *
+ * Description:
+ *   Allocate a slot of the Neighbor Table for a new mapping.  If the table
+ *   is full, the mapping that has not been updated for the longest time is
+ *   replaced.  This interface is internal to the neighbor implementation.
+ *
+ * Returned Value:
+ *   The slot, which is not linked into any list.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_tabent_s *neighbor_allocentry(void);
+
+/****************************************************************************
+ * Name: neighbor_age_schedule
+ *
+ * Description:
+ *   Make sure that the mappings in the age list are removed when they
+ *   expire.  This interface is internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   now - The current time in clock ticks
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+void neighbor_age_schedule(clock_t now);
+#else
+#  define neighbor_age_schedule(n)
+#endif
 
 /****************************************************************************
  * Name: neighbor_add
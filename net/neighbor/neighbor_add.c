@@ -26,6 +26,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <queue.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -62,53 +63,56 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  FAR struct neighbor_tabent_s *tabent;
+  FAR struct neighbor_tabent_s **bucket;
+  FAR struct neighbor_entry_s *neighbor;
+  clock_t now = clock_systime_ticks();
   uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
+  /* Find the matching entry.  If there is none, use a free entry or the
+   * oldest used entry.
    */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  lltype = dev->d_lltype;
+  bucket = neighbor_hash(ipaddr);
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (tabent = *bucket; tabent != NULL; tabent = tabent->nt_hnext)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      if (tabent->nt_entry.ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(tabent->nt_entry.ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
           break;
         }
+    }
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
-        {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
-        }
+  if (tabent != NULL)
+    {
+      /* The entry becomes the most recently updated one */
+
+      dq_rem(&tabent->nt_node, &g_neighbor_age);
+    }
+  else
+    {
+      tabent           = neighbor_allocentry();
+      tabent->nt_hnext = *bucket;
+      *bucket          = tabent;
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  neighbor          = &tabent->nt_entry;
+  neighbor->ne_time = now;
+  net_ipv6addr_copy(neighbor->ne_ipaddr, ipaddr);
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  neighbor->ne_addr.na_lltype = lltype;
+  neighbor->ne_addr.na_llsize = netdev_lladdrsize(dev);
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  memcpy(&neighbor->ne_addr.u, addr, neighbor->ne_addr.na_llsize);
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  dq_addlast(&tabent->nt_node, &g_neighbor_age);
+  neighbor_age_schedule(now);
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", neighbor);
 }
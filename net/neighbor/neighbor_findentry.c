@@ -27,6 +27,8 @@
 #include <string.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -44,23 +46,29 @@
  *   ipaddr - The IPv6 address to use in the lookup;
  *
  * Returned Value:
- *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
- *   returned if there is no matching entry in the Neighbor Table.
+ *   The Neighbor Table slot corresponding to the IPv6 address;  NULL is
+ *   returned if there is no matching entry in the Neighbor Table or if it
+ *   has expired.
  *
  ****************************************************************************/
 
-FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
+FAR struct neighbor_tabent_s *
+neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_tabent_s *tabent;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (tabent = *neighbor_hash(ipaddr); tabent != NULL;
+       tabent = tabent->nt_hnext)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &tabent->nt_entry;
+
+      /* The aging may not have removed an expired entry yet */
 
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
+      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr) &&
+          clock_systime_ticks() - neighbor->ne_time <= NEIGHBOR_MAXAGE_TICK)
         {
           neighbor_dumpentry("Entry found", neighbor);
-          return neighbor;
+          return tabent;
         }
     }
 
@@ -34,7 +34,20 @@
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+struct neighbor_tabent_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The hash chains, the slots in use ordered by the time of their last
+ * update and the slots that have been released.
+ */
+
+FAR struct neighbor_tabent_s *g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+dq_queue_t g_neighbor_age;
+FAR struct neighbor_tabent_s *g_neighbor_free;
+unsigned int g_neighbor_nused;
+
+/* The Neighbor table counters */
+
+struct neighbor_stats_s g_neighbor_stats;
 
 /****************************************************************************
  * Public Functions
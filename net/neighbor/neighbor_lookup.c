@@ -113,13 +113,13 @@ static int neighbor_match(FAR struct net_driver_s *dev, FAR void *arg)
 int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
                     FAR struct neighbor_addr_s *laddr)
 {
-  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_tabent_s *tabent;
   struct neighbor_table_info_s info;
 
   /* Check if the IPv6 address is already in the neighbor table. */
 
-  neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  tabent = neighbor_findentry(ipaddr);
+  if (tabent != NULL)
     {
       /* Yes.. return the link layer address if the caller has provided a
        * non-NULL address in 'laddr'.
@@ -127,13 +127,14 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
 
       if (laddr != NULL)
         {
-          memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
+          memcpy(laddr, &tabent->nt_entry.ne_addr, sizeof(*laddr));
         }
 
       /* Return success in any case meaning that a valid link layer
        * address mapping is available for the IPv6 address.
        */
 
+      g_neighbor_stats.hits++;
       return OK;
     }
 
@@ -152,5 +153,6 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
 
   /* Not found */
 
+  g_neighbor_stats.misses++;
   return -ENOENT;
 }
@@ -0,0 +1,227 @@
+/****************************************************************************
+ * net/neighbor/neighbor_table.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+
+#include "neighbor/neighbor.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NEIGHBOR_HASHMASK (CONFIG_NET_IPv6_NCONF_HASHSIZE - 1)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+/* Removes the expired mappings */
+
+static struct work_s g_neighbor_work;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_unlink
+ *
+ * Description:
+ *   Remove a slot in use from its hash chain and from the age list.
+ *
+ ****************************************************************************/
+
+static void neighbor_unlink(FAR struct neighbor_tabent_s *tabent)
+{
+  FAR struct neighbor_tabent_s **link;
+
+  for (link = neighbor_hash(tabent->nt_entry.ne_ipaddr); *link != NULL;
+       link = &(*link)->nt_hnext)
+    {
+      if (*link == tabent)
+        {
+          *link = tabent->nt_hnext;
+          break;
+        }
+    }
+
+  dq_rem(&tabent->nt_node, &g_neighbor_age);
+}
+
+/****************************************************************************
+ * Name: neighbor_age_work
+ *
+ * Description:
+ *   Remove all expired mappings from the head of the age list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+static void neighbor_age_work(FAR void *arg)
+{
+  FAR struct neighbor_tabent_s *tabent;
+  clock_t now;
+
+  net_lock();
+
+  now = clock_systime_ticks();
+  while ((tabent = (FAR struct neighbor_tabent_s *)
+                   dq_peek(&g_neighbor_age)) != NULL &&
+         now - tabent->nt_entry.ne_time > NEIGHBOR_MAXAGE_TICK)
+    {
+      neighbor_dumpentry("Expired entry", &tabent->nt_entry);
+
+      neighbor_unlink(tabent);
+      memset(&tabent->nt_entry, 0, sizeof(struct neighbor_entry_s));
+
+      tabent->nt_hnext = g_neighbor_free;
+      g_neighbor_free  = tabent;
+      g_neighbor_stats.expired++;
+    }
+
+  neighbor_age_schedule(now);
+  net_unlock();
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain of an IPv6 address.  This interface is internal
+ *   to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address
+ *
+ * Returned Value:
+ *   The head of the hash chain.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_tabent_s **neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash;
+
+  /* The neighbors mostly share their prefix, the interface identifier in
+   * the lower half of the address tells them apart.
+   */
+
+  hash  = ((uint32_t)ipaddr[4] << 16 | ipaddr[5]) ^
+          ((uint32_t)ipaddr[6] << 16 | ipaddr[7]);
+  hash ^= hash >> 16;
+  hash  = (hash * 0x9e3779b1) >> 16;
+  return &g_neighbor_hash[hash & NEIGHBOR_HASHMASK];
+}
+
+/****************************************************************************
+ * Name: neighbor_allocentry
+ *
+ * Description:
+ *   Allocate a slot of the Neighbor Table for a new mapping.  If the table
+ *   is full, the mapping that has not been updated for the longest time is
+ *   replaced.  This interface is internal to the neighbor implementation.
+ *
+ * Returned Value:
+ *   The slot, which is not linked into any list.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_tabent_s *neighbor_allocentry(void)
+{
+  FAR struct neighbor_tabent_s *tabent;
+
+  if (g_neighbor_free != NULL)
+    {
+      tabent          = g_neighbor_free;
+      g_neighbor_free = tabent->nt_hnext;
+      return tabent;
+    }
+
+  if (g_neighbor_nused < CONFIG_NET_IPv6_NCONF_ENTRIES)
+    {
+      return &g_neighbors[g_neighbor_nused++];
+    }
+
+  /* Replace the oldest mapping */
+
+  tabent = (FAR struct neighbor_tabent_s *)dq_peek(&g_neighbor_age);
+  DEBUGASSERT(tabent != NULL);
+
+  neighbor_unlink(tabent);
+  g_neighbor_stats.evicted++;
+  return tabent;
+}
+
+/****************************************************************************
+ * Name: neighbor_age_schedule
+ *
+ * Description:
+ *   Make sure that the mappings in the age list are removed when they
+ *   expire.  This interface is internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   now - The current time in clock ticks
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+void neighbor_age_schedule(clock_t now)
+{
+  FAR struct neighbor_tabent_s *tabent;
+  clock_t elapsed;
+
+  /* The mappings expire in the order of the age list, run the work when
+   * the first one does.
+   */
+
+  tabent = (FAR struct neighbor_tabent_s *)dq_peek(&g_neighbor_age);
+  if (tabent != NULL && work_available(&g_neighbor_work))
+    {
+      elapsed = now - tabent->nt_entry.ne_time;
+      work_queue(LPWORK, &g_neighbor_work, neighbor_age_work, NULL,
+                 elapsed < NEIGHBOR_MAXAGE_TICK ?
+                 NEIGHBOR_MAXAGE_TICK + 1 - elapsed : 1);
+    }
+}
+#endif
@@ -24,6 +24,10 @@
 
 #include <nuttx/config.h>
 
+#include <queue.h>
+
+#include <nuttx/clock.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -48,11 +52,16 @@
 
 void neighbor_update(const net_ipv6addr_t ipaddr)
 {
-  struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_tabent_s *tabent;
 
-  neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  tabent = neighbor_findentry(ipaddr);
+  if (tabent != NULL)
     {
-      neighbor->ne_time = clock_systime_ticks();
+      tabent->nt_entry.ne_time = clock_systime_ticks();
+
+      /* Keep the age list in the order of the updates */
+
+      dq_rem(&tabent->nt_node, &g_neighbor_age);
+      dq_addlast(&tabent->nt_node, &g_neighbor_age);
     }
 }
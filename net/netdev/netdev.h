@@ -36,6 +36,10 @@
 #  include <nuttx/wqueue.h>
 #endif
 
+#ifdef CONFIG_NETDEV_IOB_RX
+#  include <nuttx/mm/iob.h>
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -494,6 +498,38 @@ void netdown_notifier_teardown(int key);
 void netdown_notifier_signal(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: netdev_iob_steal
+ *
+ * Description:
+ *   Take over the I/O buffer that the device received the current packet
+ *   into, trimmed to the len bytes of payload at data.  The device gets a
+ *   new I/O buffer with a copy of everything that precedes the payload, so
+ *   the headers in d_buf remain valid and the response to the packet can
+ *   still be built in place.
+ *
+ * Input Parameters:
+ *   dev        - The device that received the packet
+ *   data       - The start of the payload in d_buf
+ *   len        - The length of the payload
+ *   consumerid - id representing the user that will free the I/O buffer
+ *
+ * Returned Value:
+ *   The I/O buffer holding the payload, now owned by the caller.  NULL if
+ *   the packet was not received into an I/O buffer or if no replacement
+ *   buffer is available; the caller must then copy the payload.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+FAR struct iob_s *netdev_iob_steal(FAR struct net_driver_s *dev,
+                                   FAR uint8_t *data, uint16_t len,
+                                   enum iob_user_e consumerid);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_IOB_RX
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_rebase
+ *
+ * Description:
+ *   Move a pointer into the first offset bytes of the old I/O buffer to the
+ *   same place in the new one.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *netdev_iob_rebase(FAR uint8_t *ptr,
+                                      FAR struct iob_s *oldiob,
+                                      FAR struct iob_s *newiob,
+                                      unsigned int offset)
+{
+  if (ptr >= oldiob->io_data && ptr <= &oldiob->io_data[offset])
+    {
+      return &newiob->io_data[ptr - oldiob->io_data];
+    }
+
+  return ptr;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device owns an I/O buffer large enough to hold one
+ *   packet and point d_buf at its start.
+ *
+ * Input Parameters:
+ *   dev       - The device driver structure
+ *   throttled - An indication of the I/O buffer may be throttled
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled)
+{
+  unsigned int size = NETDEV_MAXPKTSIZE(dev) + CONFIG_NET_GUARDSIZE;
+
+  if (dev->d_iob != NULL && IOB_BUFSIZE(dev->d_iob) < size)
+    {
+      netdev_iob_release(dev);
+    }
+
+  if (dev->d_iob == NULL)
+    {
+      dev->d_iob = iob_tryalloc_size(throttled, size,
+                                     IOBUSER_NET_NETDEV_RX);
+      if (dev->d_iob == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      /* Without large enough I/O buffers, there is no point in trying
+       * again.
+       */
+
+      if (IOB_BUFSIZE(dev->d_iob) < size)
+        {
+          netdev_iob_release(dev);
+          return -EMSGSIZE;
+        }
+    }
+
+  dev->d_buf = dev->d_iob->io_data;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Release the I/O buffer owned by the device.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void netdev_iob_release(FAR struct net_driver_s *dev)
+{
+  if (dev->d_iob != NULL)
+    {
+      if (dev->d_buf == dev->d_iob->io_data)
+        {
+          dev->d_buf = NULL;
+        }
+
+      iob_free(dev->d_iob, IOBUSER_NET_NETDEV_RX);
+      dev->d_iob = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_iob_steal
+ *
+ * Description:
+ *   Take over the I/O buffer that the device received the current packet
+ *   into, trimmed to the len bytes of payload at data.  The device gets a
+ *   new I/O buffer with a copy of everything that precedes the payload.
+ *
+ * Input Parameters:
+ *   dev        - The device that received the packet
+ *   data       - The start of the payload in d_buf
+ *   len        - The length of the payload
+ *   consumerid - id representing the user that will free the I/O buffer
+ *
+ * Returned Value:
+ *   The I/O buffer holding the payload or NULL if the payload must be
+ *   copied.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_steal(FAR struct net_driver_s *dev,
+                                   FAR uint8_t *data, uint16_t len,
+                                   enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *next;
+  unsigned int offset;
+
+  /* The packet must have been received into the I/O buffer of the device,
+   * not into a fallback buffer of the driver.
+   */
+
+  if (iob == NULL || len == 0 ||
+      dev->d_buf < iob->io_data ||
+      data < dev->d_buf ||
+      data + len > &iob->io_data[IOB_BUFSIZE(iob)])
+    {
+      return NULL;
+    }
+
+  /* The headers stay in use after the payload has been queued: the ACK or
+   * other response is built over them.  Hand the device a new buffer with
+   * a copy of them.  Do not use the reserved I/O buffers for this, falling
+   * back to a copy of the payload is better then.
+   */
+
+  offset = data - iob->io_data;
+  next   = iob_tryalloc_size(true, NETDEV_MAXPKTSIZE(dev) +
+                             CONFIG_NET_GUARDSIZE, IOBUSER_NET_NETDEV_RX);
+  if (next == NULL)
+    {
+      return NULL;
+    }
+
+  if (IOB_BUFSIZE(next) < offset)
+    {
+      iob_free(next, IOBUSER_NET_NETDEV_RX);
+      return NULL;
+    }
+
+  memcpy(next->io_data, iob->io_data, offset);
+
+  dev->d_buf     = netdev_iob_rebase(dev->d_buf, iob, next, offset);
+  dev->d_appdata = netdev_iob_rebase(dev->d_appdata, iob, next, offset);
+#ifdef CONFIG_NET_TCPURGDATA
+  dev->d_urgdata = netdev_iob_rebase(dev->d_urgdata, iob, next, offset);
+#endif
+  dev->d_iob     = next;
+
+  /* What is left of the old buffer is the payload.  It is freed as a
+   * buffer of the consumer from now on.
+   */
+
+  iob->io_flink  = NULL;
+  iob->io_offset = offset;
+  iob->io_len    = len;
+  iob->io_pktlen = len;
+
+  iob_reassign(iob, IOBUSER_NET_NETDEV_RX, consumerid);
+
+  ninfo("Queued %u bytes without copy\n", len);
+  return iob;
+}
+
+#endif /* CONFIG_NETDEV_IOB_RX */
@@ -1319,23 +1319,9 @@ static int netdev_arp_ioctl(FAR struct socket *psock, int cmd,
               FAR struct sockaddr_in *addr =
                 (FAR struct sockaddr_in *)&req->arp_pa;
 
-              /* Find the existing ARP entry for this protocol address. */
+              /* Delete the existing ARP entry for this protocol address */
 
-              FAR struct arp_entry_s *entry =
-                arp_lookup(addr->sin_addr.s_addr);
-              if (entry != NULL)
-                {
-                  /* The ARP table is fixed size; an entry is deleted
-                   * by nullifying its protocol address.
-                   */
-
-                  entry->at_ipaddr = 0;
-                  ret = OK;
-                }
-              else
-                {
-                  ret = -ENOENT;
-                }
+              ret = arp_delete(addr->sin_addr.s_addr);
             }
           else
             {
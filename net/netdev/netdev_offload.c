@@ -0,0 +1,375 @@
+/****************************************************************************
+ * net/netdev/netdev_offload.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+#include <nuttx/net/udp.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iphdrlen
+ *
+ * Description:
+ *   Return the size of the IP header of the packet in d_buf and its
+ *   protocol.
+ *
+ ****************************************************************************/
+
+static unsigned int netdev_iphdrlen(FAR struct net_driver_s *dev,
+                                    FAR uint8_t *proto)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      /* The network does not send extension headers */
+
+      *proto = IPv6BUF->proto;
+      return IPv6_HDRLEN;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      *proto = IPv4BUF->proto;
+      return (IPv4BUF->vhl & IPv4_HLMASK) << 2;
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
+/****************************************************************************
+ * Name: netdev_setiplen
+ *
+ * Description:
+ *   Set the length field of the IP header of the packet in d_buf from
+ *   d_len.
+ *
+ ****************************************************************************/
+
+static void netdev_setiplen(FAR struct net_driver_s *dev)
+{
+  uint16_t iplen = dev->d_len - NET_LL_HDRLEN(dev);
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      iplen           -= IPv6_HDRLEN;
+      IPv6BUF->len[0]  = iplen >> 8;
+      IPv6BUF->len[1]  = iplen & 0xff;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      IPv4BUF->len[0]  = iplen >> 8;
+      IPv4BUF->len[1]  = iplen & 0xff;
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
+/****************************************************************************
+ * Name: netdev_get32 and netdev_put32
+ ****************************************************************************/
+
+static inline uint32_t netdev_get32(FAR const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void netdev_put32(FAR uint8_t *p, uint32_t value)
+{
+  p[0] = value >> 24;
+  p[1] = value >> 16;
+  p[2] = value >> 8;
+  p[3] = value;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_offload_txcsum
+ *
+ * Description:
+ *   Fill in the checksums of the outgoing packet in d_buf if they have been
+ *   left to the device (NETDEV_PKT_TXCSUM).  This is the software fallback
+ *   for devices that cannot compute them.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void netdev_offload_txcsum(FAR struct net_driver_s *dev)
+{
+  FAR uint8_t *l4hdr;
+  unsigned int iphdrlen;
+  uint8_t proto;
+
+  if (!NETDEV_TXCSUM_OFFLOADED(dev))
+    {
+      return;
+    }
+
+  dev->d_pktflags &= ~NETDEV_PKT_TXCSUM;
+
+  iphdrlen = netdev_iphdrlen(dev, &proto);
+  l4hdr    = &dev->d_buf[NET_LL_HDRLEN(dev) + iphdrlen];
+
+#ifdef CONFIG_NET_IPv4
+  if (!IFF_IS_IPv6(dev->d_flags))
+    {
+      IPv4BUF->ipchksum = 0;
+      IPv4BUF->ipchksum = ~ipv4_chksum(dev);
+    }
+#endif
+
+  switch (proto)
+    {
+#ifdef CONFIG_NET_TCP
+      case IP_PROTO_TCP:
+        {
+          FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)l4hdr;
+
+          tcp->tcpchksum = 0;
+          tcp->tcpchksum = ~tcp_chksum(dev);
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_UDP
+      case IP_PROTO_UDP:
+        {
+          FAR struct udp_hdr_s *udp = (FAR struct udp_hdr_s *)l4hdr;
+
+          udp->udpchksum = 0;
+
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+          if (IFF_IS_IPv6(dev->d_flags))
+#endif
+            {
+              udp->udpchksum = ~udp_ipv6_chksum(dev);
+            }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+          else
+#endif
+            {
+              udp->udpchksum = ~udp_ipv4_chksum(dev);
+            }
+#endif /* CONFIG_NET_IPv4 */
+
+          if (udp->udpchksum == 0)
+            {
+              udp->udpchksum = 0xffff;
+            }
+#endif /* CONFIG_NET_UDP_CHECKSUMS */
+        }
+        break;
+#endif
+
+      default:
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_offload_tso
+ *
+ * Description:
+ *   Send the outgoing packet in d_buf with xmit.  If its segmentation has
+ *   been left to the device (NETDEV_PKT_TSO), the packet is split into
+ *   segments in place and xmit is called once for each segment, with d_buf
+ *   and d_len describing that segment.  The checksums of the segments are
+ *   left to the device if it has NETDEV_OFFLOAD_TXCSUM and are computed
+ *   here otherwise.
+ *
+ *   xmit must be done with d_buf when it returns.  d_buf and d_len are
+ *   restored and d_pktflags is cleared before returning.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure
+ *   xmit - The function that sends one packet
+ *
+ * Returned Value:
+ *   The value returned by the last call to xmit.  Segmentation stops early
+ *   if xmit returns a negated errno value.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int netdev_offload_tso(FAR struct net_driver_s *dev,
+                       devif_poll_callback_t xmit)
+{
+  FAR struct tcp_hdr_s *tcp;
+  FAR uint8_t *buf = dev->d_buf;
+  uint16_t len = dev->d_len;
+  unsigned int tcpoff;
+  unsigned int hdrlen;
+  unsigned int paylen;
+  unsigned int segsize;
+  unsigned int seglen;
+  unsigned int offset;
+  uint32_t seqno;
+  uint16_t ipid = 0;
+  uint8_t flags;
+  uint8_t proto;
+  int ret;
+
+  tcpoff = NET_LL_HDRLEN(dev) + netdev_iphdrlen(dev, &proto);
+  tcp    = (FAR struct tcp_hdr_s *)&buf[tcpoff];
+  hdrlen = tcpoff + ((tcp->tcpoffset >> 4) << 2);
+
+  /* Segments start at an even offset so that the headers stay aligned */
+
+  segsize = dev->d_tsosize & ~1;
+
+  if ((dev->d_pktflags & NETDEV_PKT_TSO) == 0 || proto != IP_PROTO_TCP ||
+      segsize == 0 || len <= hdrlen + segsize)
+    {
+      if ((dev->d_offload & NETDEV_OFFLOAD_TXCSUM) == 0)
+        {
+          netdev_offload_txcsum(dev);
+        }
+
+      ret = xmit(dev);
+      dev->d_pktflags = 0;
+      return ret;
+    }
+
+  /* The sum of the whole payload does not apply to the segments */
+
+  dev->d_sndsum = 0;
+
+  paylen = len - hdrlen;
+  seqno  = netdev_get32(tcp->seqno);
+  flags  = tcp->flags;
+
+#ifdef CONFIG_NET_IPv4
+  if (!IFF_IS_IPv6(dev->d_flags))
+    {
+      ipid = ((uint16_t)IPv4BUF->ipid[0] << 8) | IPv4BUF->ipid[1];
+    }
+#endif
+
+  ninfo("TSO: %u bytes in segments of %u\n", paylen, segsize);
+
+  for (offset = 0, ret = OK; offset < paylen && ret >= 0;
+       offset += seglen)
+    {
+      seglen = paylen - offset;
+      if (seglen > segsize)
+        {
+          seglen = segsize;
+        }
+
+      /* The headers of this segment go in front of its payload, over the
+       * end of the previous segment, which has been sent already.
+       */
+
+      if (offset > 0)
+        {
+          memmove(&buf[offset], &buf[offset - segsize], hdrlen);
+        }
+
+      dev->d_buf = &buf[offset];
+      dev->d_len = hdrlen + seglen;
+      tcp        = (FAR struct tcp_hdr_s *)&dev->d_buf[tcpoff];
+
+      netdev_setiplen(dev);
+      netdev_put32(tcp->seqno, seqno + offset);
+
+      /* Only the last segment carries FIN and PSH */
+
+      tcp->flags = flags;
+      if (offset + seglen < paylen)
+        {
+          tcp->flags &= ~(TCP_FIN | TCP_PSH);
+        }
+
+#ifdef CONFIG_NET_IPv4
+      if (!IFF_IS_IPv6(dev->d_flags))
+        {
+          uint16_t id = ipid + offset / segsize;
+
+          IPv4BUF->ipid[0] = id >> 8;
+          IPv4BUF->ipid[1] = id & 0xff;
+        }
+#endif
+
+      dev->d_pktflags = NETDEV_PKT_TXCSUM;
+      if ((dev->d_offload & NETDEV_OFFLOAD_TXCSUM) == 0)
+        {
+          netdev_offload_txcsum(dev);
+        }
+
+      ret = xmit(dev);
+    }
+
+  dev->d_buf      = buf;
+  dev->d_len      = len;
+  dev->d_pktflags = 0;
+  return ret;
+}
+
+#endif /* CONFIG_NETDEV_OFFLOAD */
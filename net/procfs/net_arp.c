@@ -0,0 +1,149 @@
+/****************************************************************************
+ * net/procfs/net_arp.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   Hits: n Misses: n Evicted: n Expired: n
+ *   IP Address      HW Address          Age Device
+ *   xxx.xxx.xxx.xxx xx:xx:xx:xx:xx:xx nnnnn xxxx
+ *
+ * The age is in seconds.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <arpa/inet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/arp.h>
+
+#include "netdev/netdev.h"
+#include "arp/arp.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_ARP)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Two header lines and a line per ARP table slot */
+
+#define ARP_LINES (2 + CONFIG_NET_ARPTAB_SIZE)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_arp_linegen
+ *
+ * Description:
+ *   Format one line: the counters, the column headings or an ARP table
+ *   slot.  An unused slot gives an empty line.
+ *
+ ****************************************************************************/
+
+static int netprocfs_arp_linegen(FAR struct netprocfs_file_s *netfile)
+{
+  struct arp_entry_s entry;
+  char ipaddr[INET_ADDRSTRLEN];
+  FAR const uint8_t *mac;
+  FAR const char *ifname;
+  int len = 0;
+
+  net_lock();
+
+  if (netfile->lineno == 0)
+    {
+      len = snprintf(netfile->line, NET_LINELEN,
+                     "Hits: %lu Misses: %lu Evicted: %lu Expired: %lu\n",
+                     (unsigned long)g_arpstats.hits,
+                     (unsigned long)g_arpstats.misses,
+                     (unsigned long)g_arpstats.evicted,
+                     (unsigned long)g_arpstats.expired);
+    }
+  else if (netfile->lineno == 1)
+    {
+      len = snprintf(netfile->line, NET_LINELEN,
+                     "IP Address      HW Address          Age Device\n");
+    }
+  else if (arp_get(netfile->lineno - 2, &entry) >= 0)
+    {
+      /* The device may have been unregistered since the entry was added */
+
+      ifname = netdev_verify(entry.at_dev) ? entry.at_dev->d_ifname : "-";
+      mac    = entry.at_ethaddr.ether_addr_octet;
+
+      inet_ntop(AF_INET, &entry.at_ipaddr, ipaddr, INET_ADDRSTRLEN);
+      len = snprintf(netfile->line, NET_LINELEN,
+                     "%-15s %02x:%02x:%02x:%02x:%02x:%02x %5lu %s\n",
+                     ipaddr, mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+                     (unsigned long)TICK2SEC(clock_systime_ticks() -
+                                             entry.at_time),
+                     ifname);
+    }
+
+  net_unlock();
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_arp
+ *
+ * Description:
+ *   Read and format the ARP table and its counters.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_arp(FAR struct netprocfs_file_s *priv,
+                           FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_lines(priv, buffer, buflen, netprocfs_arp_linegen,
+                              ARP_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_ARP */
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * net/procfs/net_neighbor.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   Hits: n Misses: n Evicted: n Expired: n
+ *   IPv6 Address                            Link Address              Age
+ *   xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx xx:xx:xx:xx:xx:xx       nnnnn
+ *
+ * The age is in seconds.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <arpa/inet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "inet/inet.h"
+#include "neighbor/neighbor.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_IPv6)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Two header lines and a line per Neighbor table slot */
+
+#define NEIGHBOR_LINES (2 + CONFIG_NET_IPv6_NCONF_ENTRIES)
+
+/* The width of the link address column */
+
+#define NEIGHBOR_LLWIDTH 25
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_neighbor_linegen
+ *
+ * Description:
+ *   Format one line: the counters, the column headings or a Neighbor table
+ *   slot.  An unused or expired slot gives an empty line.
+ *
+ ****************************************************************************/
+
+static int netprocfs_neighbor_linegen(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct neighbor_entry_s *neighbor;
+  char ipaddr[INET6_ADDRSTRLEN];
+  clock_t elapsed;
+  int start;
+  int len = 0;
+  int i;
+
+  net_lock();
+
+  if (netfile->lineno == 0)
+    {
+      len = snprintf(netfile->line, NET_LINELEN,
+                     "Hits: %lu Misses: %lu Evicted: %lu Expired: %lu\n",
+                     (unsigned long)g_neighbor_stats.hits,
+                     (unsigned long)g_neighbor_stats.misses,
+                     (unsigned long)g_neighbor_stats.evicted,
+                     (unsigned long)g_neighbor_stats.expired);
+      goto out;
+    }
+
+  if (netfile->lineno == 1)
+    {
+      len = snprintf(netfile->line, NET_LINELEN, "%-39s %-*s %5s\n",
+                     "IPv6 Address", NEIGHBOR_LLWIDTH, "Link Address",
+                     "Age");
+      goto out;
+    }
+
+  neighbor = &g_neighbors[netfile->lineno - 2].nt_entry;
+  elapsed  = clock_systime_ticks() - neighbor->ne_time;
+
+  if (net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr) ||
+      elapsed > NEIGHBOR_MAXAGE_TICK)
+    {
+      goto out;
+    }
+
+  inet_ntop(AF_INET6, neighbor->ne_ipaddr, ipaddr, INET6_ADDRSTRLEN);
+  len   = snprintf(netfile->line, NET_LINELEN, "%-39s ", ipaddr);
+  start = len;
+
+  /* The link layer address, as long as it fits into its column */
+
+  for (i = 0; i < neighbor->ne_addr.na_llsize &&
+              len + 3 <= start + NEIGHBOR_LLWIDTH; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len,
+                      i == 0 ? "%02x" : ":%02x",
+                      neighbor->ne_addr.u.na_addr[i]);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "%*s %5lu\n",
+                  start + NEIGHBOR_LLWIDTH - len, "",
+                  (unsigned long)TICK2SEC(elapsed));
+
+out:
+  net_unlock();
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_neighbor
+ *
+ * Description:
+ *   Read and format the IPv6 Neighbor table and its counters.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_neighbor(FAR struct netprocfs_file_s *priv,
+                                FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_lines(priv, buffer, buflen,
+                              netprocfs_neighbor_linegen, NEIGHBOR_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_IPv6 */
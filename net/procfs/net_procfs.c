@@ -55,15 +55,29 @@
 /* Directory entry indices */
 
 #ifdef CONFIG_NET_STATISTICS
-#  define STAT_INDEX     0
+#  define STAT_INDEX        0
 #  ifdef CONFIG_NET_MLD
-#    define MLD_INDEX    1
-#    define _ROUTE_INDEX 2
+#    define MLD_INDEX       1
+#    define _ARP_INDEX      2
 #  else
-#    define _ROUTE_INDEX 1
+#    define _ARP_INDEX      1
 #  endif
 #else
-#  define _ROUTE_INDEX   0
+#  define _ARP_INDEX        0
+#endif
+
+#ifdef CONFIG_NET_ARP
+#  define ARP_INDEX         _ARP_INDEX
+#  define _NEIGHBOR_INDEX   (_ARP_INDEX + 1)
+#else
+#  define _NEIGHBOR_INDEX   _ARP_INDEX
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#  define NEIGHBOR_INDEX    _NEIGHBOR_INDEX
+#  define _ROUTE_INDEX      (_NEIGHBOR_INDEX + 1)
+#else
+#  define _ROUTE_INDEX      _NEIGHBOR_INDEX
 #endif
 
 #ifdef CONFIG_NET_ROUTE
@@ -180,6 +194,32 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
 #endif
 #endif
 
+#ifdef CONFIG_NET_ARP
+  /* "net/arp" is an acceptable value for the relpath only if ARP is
+   * enabled.
+   */
+
+  if (strcmp(relpath, "net/arp") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_ARP;
+      dev   = NULL;
+    }
+  else
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  /* "net/neighbor" is an acceptable value for the relpath only if IPv6 is
+   * enabled.
+   */
+
+  if (strcmp(relpath, "net/neighbor") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_NEIGHBOR;
+      dev   = NULL;
+    }
+  else
+#endif
+
 #ifdef CONFIG_NET_ROUTE
   /* "net/route" is an acceptable value for the relpath only if routing
    * table support is initialized.
@@ -310,6 +350,24 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
 #endif
 #endif
 
+#ifdef CONFIG_NET_ARP
+      case NETPROCFS_SUBDIR_ARP:
+
+        /* Show the ARP table */
+
+        nreturned = netprocfs_read_arp(priv, buffer, buflen);
+        break;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      case NETPROCFS_SUBDIR_NEIGHBOR:
+
+        /* Show the Neighbor table */
+
+        nreturned = netprocfs_read_neighbor(priv, buffer, buflen);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -432,6 +490,12 @@ static int netprocfs_opendir(FAR const char *relpath,
       level1->base.nentries++;
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+      level1->base.nentries++;
+#endif
+#ifdef CONFIG_NET_IPv6
+      level1->base.nentries++;
+#endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
 #endif
@@ -530,6 +594,26 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir,
       else
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+      if (index == ARP_INDEX)
+        {
+          /* Copy the ARP table directory entry */
+
+          entry->d_type = DTYPE_FILE;
+          strncpy(entry->d_name, "arp", NAME_MAX + 1);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_IPv6
+      if (index == NEIGHBOR_INDEX)
+        {
+          /* Copy the Neighbor table directory entry */
+
+          entry->d_type = DTYPE_FILE;
+          strncpy(entry->d_name, "neighbor", NAME_MAX + 1);
+        }
+      else
+#endif
 #ifdef CONFIG_NET_ROUTE
       if (index == ROUTE_INDEX)
         {
@@ -661,6 +745,24 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
   else
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+  /* Check for the ARP table "net/arp" */
+
+  if (strcmp(relpath, "net/arp") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  /* Check for the Neighbor table "net/neighbor" */
+
+  if (strcmp(relpath, "net/neighbor") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
 #ifdef CONFIG_NET_ROUTE
   /* Check for network statistics "net/stat" */
 
@@ -709,32 +811,18 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: netprocfs_read_linegen
+ * Name: netprocfs_read_common
  *
  * Description:
- *   Read and format procfs data using a line generation table.
- *
- * Input Parameters:
- *   priv   - A reference to the network procfs file structure
- *   buffer - The user-provided buffer into which device status will be
- *            returned.
- *   buflen - The size in bytes of the user provided buffer.
- *   gentab - Table of line generation functions
- *   nelems - The number of elements in the table
- *
- * Returned Value:
- *   Zero (OK) is returned on success; a negated errno value is returned
- *   on failure.
+ *   Read and format procfs data with either a line generation table or a
+ *   single line generation function.
  *
  ****************************************************************************/
 
-ssize_t netprocfs_read_linegen(FAR struct netprocfs_file_s *priv,
-                               FAR char *buffer, size_t buflen,
-                               FAR const linegen_t *gentab, int nelems)
+static ssize_t netprocfs_read_common(FAR struct netprocfs_file_s *priv,
+                                     FAR char *buffer, size_t buflen,
+                                     FAR const linegen_t *gentab,
+                                     linegen_t linegen, int nelems)
 {
   size_t xfrsize;
   ssize_t nreturned;
@@ -782,7 +870,14 @@ ssize_t netprocfs_read_linegen(FAR struct netprocfs_file_s *priv,
 
       /* Read the next line into the working buffer */
 
-      len = gentab[priv->lineno](priv);
+      if (gentab != NULL)
+        {
+          len = gentab[priv->lineno](priv);
+        }
+      else
+        {
+          len = linegen(priv);
+        }
 
       /* Update line-related information */
 
@@ -813,5 +908,66 @@ ssize_t netprocfs_read_linegen(FAR struct netprocfs_file_s *priv,
   return nreturned;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_linegen
+ *
+ * Description:
+ *   Read and format procfs data using a line generation table.
+ *
+ * Input Parameters:
+ *   priv   - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which device status will be
+ *            returned.
+ *   buflen - The size in bytes of the user provided buffer.
+ *   gentab - Table of line generation functions
+ *   nelems - The number of elements in the table
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_linegen(FAR struct netprocfs_file_s *priv,
+                               FAR char *buffer, size_t buflen,
+                               FAR const linegen_t *gentab, int nelems)
+{
+  return netprocfs_read_common(priv, buffer, buflen, gentab, NULL, nelems);
+}
+
+/****************************************************************************
+ * Name: netprocfs_read_lines
+ *
+ * Description:
+ *   Read and format procfs data with a line generation function that
+ *   formats line number priv->lineno.  This suits tables with a line per
+ *   entry.  Lines may be empty.
+ *
+ * Input Parameters:
+ *   priv    - A reference to the network procfs file structure
+ *   buffer  - The user-provided buffer into which device status will be
+ *             returned.
+ *   buflen  - The size in bytes of the user provided buffer.
+ *   linegen - The line generation function
+ *   nlines  - The number of lines
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lines(FAR struct netprocfs_file_s *priv,
+                             FAR char *buffer, size_t buflen,
+                             linegen_t linegen, int nlines)
+{
+  return netprocfs_read_common(priv, buffer, buflen, NULL, linegen,
+                               nlines);
+}
+
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
         * !CONFIG_FS_PROCFS_EXCLUDE_NET */
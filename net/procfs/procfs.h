@@ -60,6 +60,12 @@ enum netprocfs_entry_e
   , NETPROCFS_SUBDIR_MLD             /* /proc/net/mld */
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+  , NETPROCFS_SUBDIR_ARP             /* /proc/net/arp */
+#endif
+#ifdef CONFIG_NET_IPv6
+  , NETPROCFS_SUBDIR_NEIGHBOR        /* /proc/net/neighbor */
+#endif
 #ifdef CONFIG_NET_ROUTE
   , NETPROCFS_SUBDIR_ROUTE           /* /proc/net/route */
 #endif
@@ -72,7 +78,7 @@ struct netprocfs_file_s
 {
   struct procfs_file_s base;         /* Base open file structure */
   FAR struct net_driver_s *dev;      /* Current network device */
-  uint8_t lineno;                    /* Line number */
+  uint16_t lineno;                   /* Line number */
   uint8_t linesize;                  /* Number of valid characters in line[] */
   uint8_t offset;                    /* Offset to first valid character in line[] */
   uint8_t entry;                     /* See enum netprocfs_entry_e */
@@ -134,6 +140,32 @@ ssize_t netprocfs_read_linegen(FAR struct netprocfs_file_s *priv,
                                 FAR char *buffer, size_t buflen,
                                 FAR const linegen_t *gentab, int nelems);
 
+/****************************************************************************
+ * Name: netprocfs_read_lines
+ *
+ * Description:
+ *   Read and format procfs data with a line generation function that
+ *   formats line number priv->lineno.  This suits tables with a line per
+ *   entry.  Lines may be empty.
+ *
+ * Input Parameters:
+ *   priv    - A reference to the network procfs file structure
+ *   buffer  - The user-provided buffer into which device status will be
+ *             returned.
+ *   buflen  - The size in bytes of the user provided buffer.
+ *   linegen - The line generation function
+ *   nlines  - The number of lines
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lines(FAR struct netprocfs_file_s *priv,
+                             FAR char *buffer, size_t buflen,
+                             linegen_t linegen, int nlines);
+
 /****************************************************************************
  * Name: netprocfs_read_netstats
  *
@@ -180,6 +212,52 @@ ssize_t netprocfs_read_mldstats(FAR struct netprocfs_file_s *priv,
                                 FAR char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: netprocfs_read_arp
+ *
+ * Description:
+ *   Read and format the ARP table and its counters.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP
+ssize_t netprocfs_read_arp(FAR struct netprocfs_file_s *priv,
+                           FAR char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_read_neighbor
+ *
+ * Description:
+ *   Read and format the IPv6 Neighbor table and its counters.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+ssize_t netprocfs_read_neighbor(FAR struct netprocfs_file_s *priv,
+                                FAR char *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: netprocfs_read_routes
  *
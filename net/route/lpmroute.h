@@ -0,0 +1,137 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The trie indexes the in-memory and file routing tables.  A read-only
+ * table is searched linearly.
+ */
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_NET_IPv4) && \
+    (defined(CONFIG_ROUTE_IPv4_RAMROUTE) || \
+     defined(CONFIG_ROUTE_IPv4_FILEROUTE))
+#  define HAVE_LPMROUTE_IPv4 1
+#endif
+
+#if defined(CONFIG_ROUTE_LPM) && defined(CONFIG_NET_IPv6) && \
+    (defined(CONFIG_ROUTE_IPv6_RAMROUTE) || \
+     defined(CONFIG_ROUTE_IPv6_FILEROUTE))
+#  define HAVE_LPMROUTE_IPv6 1
+#endif
+
+#if defined(HAVE_LPMROUTE_IPv4) || defined(HAVE_LPMROUTE_IPv6)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Find the route with the longest prefix that matches the target address
+ *   in the trie.
+ *
+ * Input Parameters:
+ *   target - An IP address on a remote network to use in the lookup.
+ *   router - The location to return the address of router on a local
+ *            network that can forward our packets to the target.
+ *
+ * Returned Value:
+ *   OK if a route was found; -ENOENT if there is no route for the target;
+ *   -ENOSYS if the trie does not hold all routes (for example, because a
+ *   route has a non-contiguous netmask) and the routing table must be
+ *   searched instead.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+int net_lpmroute_ipv4(in_addr_t target, FAR in_addr_t *router);
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target, net_ipv6addr_t router);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_add_ipv4 and net_lpmroute_add_ipv6
+ *
+ * Description:
+ *   Add a route that has just been appended to the routing table to the
+ *   trie.  If the table already has a route to the same network, that
+ *   route keeps precedence.
+ *
+ * Input Parameters:
+ *   route - The new route
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+void net_lpmroute_add_ipv4(FAR const struct net_route_ipv4_s *route);
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+void net_lpmroute_add_ipv6(FAR const struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_del_ipv4 and net_lpmroute_del_ipv6
+ *
+ * Description:
+ *   Remove the route to a network that has just been removed from the
+ *   routing table from the trie.  If the table has another route to the
+ *   same network, that one replaces it.
+ *
+ * Input Parameters:
+ *   target  - The target IP address of the removed route
+ *   netmask - The network mask of the removed route
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+void net_lpmroute_del_ipv4(in_addr_t target, in_addr_t netmask);
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+void net_lpmroute_del_ipv6(const net_ipv6addr_t target,
+                           const net_ipv6addr_t netmask);
+#endif
+
+#endif /* HAVE_LPMROUTE_IPv4 || HAVE_LPMROUTE_IPv6 */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -34,6 +34,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -84,6 +85,14 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   net_closeroute_ipv4(&fshandle);
+
+#ifdef HAVE_LPMROUTE_IPv4
+  if (nwritten >= 0)
+    {
+      net_lpmroute_add_ipv4(&route);
+    }
+#endif
+
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -118,6 +127,14 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   net_closeroute_ipv6(&fshandle);
+
+#ifdef HAVE_LPMROUTE_IPv6
+  if (nwritten >= 0)
+    {
+      net_lpmroute_add_ipv6(&route);
+    }
+#endif
+
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
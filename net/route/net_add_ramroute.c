@@ -34,6 +34,7 @@
 
 #include <arch/irq.h>
 
+#include "route/lpmroute.h"
 #include "route/ramroute.h"
 #include "route/route.h"
 
@@ -85,6 +86,11 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
+
+#ifdef HAVE_LPMROUTE_IPv4
+  net_lpmroute_add_ipv4(route);
+#endif
+
   net_unlock();
   return OK;
 }
@@ -120,6 +126,11 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
+
+#ifdef HAVE_LPMROUTE_IPv6
+  net_lpmroute_add_ipv6(route);
+#endif
+
   net_unlock();
   return OK;
 }
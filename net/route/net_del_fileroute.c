@@ -38,6 +38,7 @@
 
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -318,6 +319,18 @@ errout_with_fshandle:
 
 errout_with_lock:
   net_unlockroute_ipv4();
+
+#ifdef HAVE_LPMROUTE_IPv4
+  /* The table has been rewritten, now update the trie.  This must not be
+   * done with the table locked: lookups lock the network first.
+   */
+
+  if (ret >= 0)
+    {
+      net_lpmroute_del_ipv4(target, netmask);
+    }
+#endif
+
   return ret;
 }
 #endif
@@ -469,6 +482,18 @@ errout_with_fshandle:
 
 errout_with_lock:
   net_unlockroute_ipv6();
+
+#ifdef HAVE_LPMROUTE_IPv6
+  /* The table has been rewritten, now update the trie.  This must not be
+   * done with the table locked: lookups lock the network first.
+   */
+
+  if (ret >= 0)
+    {
+      net_lpmroute_del_ipv6(target, netmask);
+    }
+#endif
+
   return ret;
 }
 #endif
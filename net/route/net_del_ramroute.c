@@ -30,8 +30,10 @@
 #include <debug.h>
 
 #include <arpa/inet.h>
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
+#include "route/lpmroute.h"
 #include "route/ramroute.h"
 #include "route/route.h"
 
@@ -202,6 +204,7 @@ static int net_match_ipv6(
 int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 {
   struct route_match_ipv4_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -211,7 +214,18 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+  net_lock();
+  ret = net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+
+#ifdef HAVE_LPMROUTE_IPv4
+  if (ret == OK)
+    {
+      net_lpmroute_del_ipv4(target, netmask);
+    }
+#endif
+
+  net_unlock();
+  return ret;
 }
 #endif
 
@@ -219,6 +233,7 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 {
   struct route_match_ipv6_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -228,7 +243,18 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+  net_lock();
+  ret = net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+
+#ifdef HAVE_LPMROUTE_IPv6
+  if (ret == OK)
+    {
+      net_lpmroute_del_ipv6(target, netmask);
+    }
+#endif
+
+  net_unlock();
+  return ret;
 }
 #endif
 
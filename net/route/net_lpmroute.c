@@ -0,0 +1,783 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#if defined(HAVE_LPMROUTE_IPv4) || defined(HAVE_LPMROUTE_IPv6)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The prefix of a node and the router address of its route follow the
+ * node, both in network order.
+ */
+
+#define LPM_PREFIX(n)      ((n)->data)
+#define LPM_ROUTER(t,n)    (&(n)->data[(t)->keysize])
+
+/* An in-memory routing table starts empty, a routing table in a file is
+ * read into the trie when it is first needed.
+ */
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+#  define LPM_IPv4_LOADED  true
+#else
+#  define LPM_IPv4_LOADED  false
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+#  define LPM_IPv6_LOADED  true
+#else
+#  define LPM_IPv6_LOADED  false
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of the path compressed binary trie.  Each node stands for a prefix
+ * and only exists if it has a route or if two sub-tries branch off there.
+ * The child taken is selected by the bit following the prefix.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *child[2]; /* Sub-tries for next bit 0 and 1 */
+  uint8_t plen;                    /* Length of the prefix in bits */
+  bool valid;                      /* True: there is a route to prefix */
+  uint8_t data[1];                 /* Prefix and router address */
+};
+
+struct lpm_trie_s
+{
+  FAR struct lpm_node_s *root;     /* The root of the trie */
+  uint8_t keysize;                 /* Size of an address in bytes */
+  bool loaded;                     /* The trie reflects the routing table */
+  bool linear;                     /* Some routes are missing from the trie */
+};
+
+#ifdef HAVE_LPMROUTE_IPv6
+struct lpm_match_ipv6_s
+{
+  net_ipv6addr_t target;           /* The target IP address to match */
+  net_ipv6addr_t netmask;          /* The network mask to match */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+static struct lpm_trie_s g_ipv4_trie =
+{
+  NULL, sizeof(in_addr_t), LPM_IPv4_LOADED, false
+};
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+static struct lpm_trie_s g_ipv6_trie =
+{
+  NULL, sizeof(net_ipv6addr_t), LPM_IPv6_LOADED, false
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_bit
+ *
+ * Description:
+ *   Return bit n of an address, counting from the most significant bit.
+ *
+ ****************************************************************************/
+
+static inline int lpm_bit(FAR const uint8_t *addr, unsigned int n)
+{
+  return (addr[n >> 3] >> (7 - (n & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits that two addresses have in common,
+ *   up to maxbits.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_common(FAR const uint8_t *addr1,
+                               FAR const uint8_t *addr2,
+                               unsigned int maxbits)
+{
+  unsigned int nbits;
+  uint8_t diff;
+
+  for (nbits = 0; nbits < maxbits; nbits += 8)
+    {
+      diff = addr1[nbits >> 3] ^ addr2[nbits >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              nbits++;
+            }
+
+          break;
+        }
+    }
+
+  return MIN(nbits, maxbits);
+}
+
+/****************************************************************************
+ * Name: lpm_match
+ *
+ * Description:
+ *   Return true if the first plen bits of an address match the prefix.
+ *
+ ****************************************************************************/
+
+static bool lpm_match(FAR const uint8_t *prefix, FAR const uint8_t *addr,
+                      unsigned int plen)
+{
+  unsigned int nbytes = plen >> 3;
+  uint8_t mask;
+
+  if (memcmp(prefix, addr, nbytes) != 0)
+    {
+      return false;
+    }
+
+  mask = (uint8_t)(0xff00 >> (plen & 7));
+  return mask == 0 || ((prefix[nbytes] ^ addr[nbytes]) & mask) == 0;
+}
+
+/****************************************************************************
+ * Name: lpm_mask2plen
+ *
+ * Description:
+ *   Convert a network mask to a prefix length.
+ *
+ * Returned Value:
+ *   The prefix length or -EINVAL if the mask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_mask2plen(FAR const uint8_t *mask, unsigned int keysize)
+{
+  unsigned int i;
+  uint8_t bits;
+  int plen = 0;
+
+  for (i = 0; i < keysize && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < keysize)
+    {
+      for (bits = mask[i++]; (bits & 0x80) != 0; bits <<= 1)
+        {
+          plen++;
+        }
+
+      if (bits != 0)
+        {
+          return -EINVAL;
+        }
+
+      for (; i < keysize; i++)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: lpm_newnode
+ *
+ * Description:
+ *   Allocate a node for the first plen bits of an address.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_newnode(FAR struct lpm_trie_s *trie,
+                                          FAR const uint8_t *addr,
+                                          unsigned int plen)
+{
+  FAR struct lpm_node_s *node;
+  unsigned int nbytes = plen >> 3;
+
+  node = kmm_zalloc(sizeof(struct lpm_node_s) + 2 * trie->keysize);
+  if (node != NULL)
+    {
+      memcpy(LPM_PREFIX(node), addr, nbytes);
+      if ((plen & 7) != 0)
+        {
+          LPM_PREFIX(node)[nbytes] = addr[nbytes] &
+                                     (uint8_t)(0xff00 >> (plen & 7));
+        }
+
+      node->plen = plen;
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add a route to the network addr/plen to the trie.  A new node is fully
+ *   set up before it is linked in.
+ *
+ * Returned Value:
+ *   OK on success; -EEXIST if there already is a route to that network;
+ *   -ENOMEM if no node could be allocated.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *addr,
+                      unsigned int plen, FAR const uint8_t *router)
+{
+  FAR struct lpm_node_s **pnode = &trie->root;
+  FAR struct lpm_node_s *branch;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *leaf;
+  unsigned int common = 0;
+
+  /* Walk down while the prefix of the node is a prefix of the network */
+
+  while ((node = *pnode) != NULL)
+    {
+      common = lpm_common(LPM_PREFIX(node), addr, MIN(node->plen, plen));
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          if (node->valid)
+            {
+              return -EEXIST;
+            }
+
+          memcpy(LPM_ROUTER(trie, node), router, trie->keysize);
+          node->valid = true;
+          return OK;
+        }
+
+      pnode = &node->child[lpm_bit(addr, node->plen)];
+    }
+
+  leaf = lpm_newnode(trie, addr, plen);
+  if (leaf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(LPM_ROUTER(trie, leaf), router, trie->keysize);
+  leaf->valid = true;
+
+  if (node == NULL)
+    {
+      *pnode = leaf;
+    }
+  else if (common == plen)
+    {
+      /* The network contains the prefix of the node: it goes above it */
+
+      leaf->child[lpm_bit(LPM_PREFIX(node), plen)] = node;
+      *pnode = leaf;
+    }
+  else
+    {
+      /* They diverge within the prefix of the node: add a branch there */
+
+      branch = lpm_newnode(trie, addr, common);
+      if (branch == NULL)
+        {
+          kmm_free(leaf);
+          return -ENOMEM;
+        }
+
+      branch->child[lpm_bit(addr, common)]              = leaf;
+      branch->child[lpm_bit(LPM_PREFIX(node), common)] = node;
+      *pnode = branch;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_remove
+ *
+ * Description:
+ *   Remove the route to the network addr/plen from the trie, together with
+ *   the nodes that are no longer needed without it.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no route to that network.
+ *
+ ****************************************************************************/
+
+static int lpm_remove(FAR struct lpm_trie_s *trie, FAR const uint8_t *addr,
+                      unsigned int plen)
+{
+  FAR struct lpm_node_s **pparent = NULL;
+  FAR struct lpm_node_s **pnode = &trie->root;
+  FAR struct lpm_node_s *parent;
+  FAR struct lpm_node_s *node;
+
+  while ((node = *pnode) != NULL)
+    {
+      if (node->plen > plen ||
+          !lpm_match(LPM_PREFIX(node), addr, node->plen))
+        {
+          return -ENOENT;
+        }
+
+      if (node->plen == plen)
+        {
+          break;
+        }
+
+      pparent = pnode;
+      pnode   = &node->child[lpm_bit(addr, node->plen)];
+    }
+
+  if (node == NULL || !node->valid)
+    {
+      return -ENOENT;
+    }
+
+  /* A node with two children is still needed as a branch */
+
+  node->valid = false;
+  if (node->child[0] != NULL && node->child[1] != NULL)
+    {
+      return OK;
+    }
+
+  /* Otherwise replace it by its child, if any */
+
+  *pnode = node->child[0] != NULL ? node->child[0] : node->child[1];
+  kmm_free(node);
+
+  /* The parent may now be a branch with only one child left */
+
+  if (pparent != NULL)
+    {
+      parent = *pparent;
+      if (!parent->valid &&
+          (parent->child[0] == NULL || parent->child[1] == NULL))
+        {
+          *pparent = parent->child[0] != NULL ?
+                     parent->child[0] : parent->child[1];
+          kmm_free(parent);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_lookup
+ *
+ * Description:
+ *   Return the router address of the longest prefix in the trie that
+ *   matches addr or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *lpm_lookup(FAR struct lpm_trie_s *trie,
+                                     FAR const uint8_t *addr)
+{
+  FAR struct lpm_node_s *node = trie->root;
+  FAR struct lpm_node_s *best = NULL;
+  unsigned int maxbits = trie->keysize << 3;
+
+  while (node != NULL && lpm_match(LPM_PREFIX(node), addr, node->plen))
+    {
+      if (node->valid)
+        {
+          best = node;
+        }
+
+      if (node->plen >= maxbits)
+        {
+          break;
+        }
+
+      node = node->child[lpm_bit(addr, node->plen)];
+    }
+
+  return best != NULL ? LPM_ROUTER(trie, best) : NULL;
+}
+
+/****************************************************************************
+ * Name: lpm_add
+ *
+ * Description:
+ *   Add a route of the routing table to the trie.  A route that the trie
+ *   cannot hold switches the lookups back to searching the routing table.
+ *
+ ****************************************************************************/
+
+static void lpm_add(FAR struct lpm_trie_s *trie, FAR const uint8_t *target,
+                    FAR const uint8_t *netmask, FAR const uint8_t *router)
+{
+  int plen;
+  int ret;
+
+  plen = lpm_mask2plen(netmask, trie->keysize);
+  if (plen < 0)
+    {
+      nwarn("WARNING: Non-contiguous netmask, searching the table\n");
+      trie->linear = true;
+      return;
+    }
+
+  /* If there already is a route to this network, it was added first and
+   * takes precedence, as it does when the table is searched.
+   */
+
+  ret = lpm_insert(trie, target, plen, router);
+  if (ret == -ENOMEM)
+    {
+      nerr("ERROR: Failed to allocate a trie node\n");
+      trie->linear = true;
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_load_ipv4 and lpm_load_ipv6
+ *
+ * Description:
+ *   Routing table traversal callbacks that add each route to the trie.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+static int lpm_load_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
+{
+  lpm_add(&g_ipv4_trie, (FAR const uint8_t *)&route->target,
+          (FAR const uint8_t *)&route->netmask,
+          (FAR const uint8_t *)&route->router);
+  return 0;
+}
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+static int lpm_load_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
+{
+  lpm_add(&g_ipv6_trie, (FAR const uint8_t *)route->target,
+          (FAR const uint8_t *)route->netmask,
+          (FAR const uint8_t *)route->router);
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: lpm_readd_ipv4 and lpm_readd_ipv6
+ *
+ * Description:
+ *   Routing table traversal callbacks that add the first remaining route
+ *   to the network of a removed route back to the trie.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+static int lpm_readd_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
+{
+  FAR struct net_route_ipv4_s *match = (FAR struct net_route_ipv4_s *)arg;
+
+  if (net_ipv4addr_maskcmp(route->target, match->target, match->netmask) &&
+      net_ipv4addr_cmp(route->netmask, match->netmask))
+    {
+      lpm_load_ipv4(route, NULL);
+      return 1;
+    }
+
+  return 0;
+}
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+static int lpm_readd_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
+{
+  FAR struct lpm_match_ipv6_s *match = (FAR struct lpm_match_ipv6_s *)arg;
+
+  if (net_ipv6addr_maskcmp(route->target, match->target, match->netmask) &&
+      net_ipv6addr_cmp(route->netmask, match->netmask))
+    {
+      lpm_load_ipv6(route, NULL);
+      return 1;
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4
+ *
+ * Description:
+ *   Find the route with the longest prefix that matches the target address
+ *   in the trie.
+ *
+ * Input Parameters:
+ *   target - An IPv4 address on a remote network to use in the lookup.
+ *   router - The location to return the address of router on a local
+ *            network that can forward our packets to the target.
+ *
+ * Returned Value:
+ *   OK if a route was found; -ENOENT if there is no route for the target;
+ *   -ENOSYS if the routing table must be searched instead.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+int net_lpmroute_ipv4(in_addr_t target, FAR in_addr_t *router)
+{
+  FAR const uint8_t *found;
+  int ret;
+
+  net_lock();
+
+  if (!g_ipv4_trie.loaded &&
+      net_foreachroute_ipv4(lpm_load_ipv4, NULL) >= 0)
+    {
+      g_ipv4_trie.loaded = true;
+    }
+
+  if (!g_ipv4_trie.loaded || g_ipv4_trie.linear)
+    {
+      ret = -ENOSYS;
+    }
+  else
+    {
+      found = lpm_lookup(&g_ipv4_trie, (FAR const uint8_t *)&target);
+      if (found != NULL)
+        {
+          memcpy(router, found, sizeof(in_addr_t));
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv6
+ *
+ * Description:
+ *   Find the route with the longest prefix that matches the target address
+ *   in the trie.
+ *
+ * Input Parameters:
+ *   target - An IPv6 address on a remote network to use in the lookup.
+ *   router - The location to return the address of router on a local
+ *            network that can forward our packets to the target.
+ *
+ * Returned Value:
+ *   OK if a route was found; -ENOENT if there is no route for the target;
+ *   -ENOSYS if the routing table must be searched instead.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target, net_ipv6addr_t router)
+{
+  FAR const uint8_t *found;
+  int ret;
+
+  net_lock();
+
+  if (!g_ipv6_trie.loaded &&
+      net_foreachroute_ipv6(lpm_load_ipv6, NULL) >= 0)
+    {
+      g_ipv6_trie.loaded = true;
+    }
+
+  if (!g_ipv6_trie.loaded || g_ipv6_trie.linear)
+    {
+      ret = -ENOSYS;
+    }
+  else
+    {
+      found = lpm_lookup(&g_ipv6_trie, (FAR const uint8_t *)target);
+      if (found != NULL)
+        {
+          memcpy(router, found, sizeof(net_ipv6addr_t));
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_add_ipv4 and net_lpmroute_add_ipv6
+ *
+ * Description:
+ *   Add a route that has just been appended to the routing table to the
+ *   trie.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+void net_lpmroute_add_ipv4(FAR const struct net_route_ipv4_s *route)
+{
+  net_lock();
+
+  /* If the table has not been read yet, the route will be read with it */
+
+  if (g_ipv4_trie.loaded)
+    {
+      lpm_load_ipv4((FAR struct net_route_ipv4_s *)route, NULL);
+    }
+
+  net_unlock();
+}
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+void net_lpmroute_add_ipv6(FAR const struct net_route_ipv6_s *route)
+{
+  net_lock();
+
+  /* If the table has not been read yet, the route will be read with it */
+
+  if (g_ipv6_trie.loaded)
+    {
+      lpm_load_ipv6((FAR struct net_route_ipv6_s *)route, NULL);
+    }
+
+  net_unlock();
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_del_ipv4 and net_lpmroute_del_ipv6
+ *
+ * Description:
+ *   Remove the route to a network that has just been removed from the
+ *   routing table from the trie.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+void net_lpmroute_del_ipv4(in_addr_t target, in_addr_t netmask)
+{
+  struct net_route_ipv4_s match;
+  int plen;
+
+  net_lock();
+
+  plen = lpm_mask2plen((FAR const uint8_t *)&netmask, sizeof(in_addr_t));
+  if (g_ipv4_trie.loaded && plen >= 0 &&
+      lpm_remove(&g_ipv4_trie, (FAR const uint8_t *)&target, plen) >= 0)
+    {
+      /* Fall back to the next route to the same network, if any */
+
+      net_ipv4addr_copy(match.target, target);
+      net_ipv4addr_copy(match.netmask, netmask);
+      net_foreachroute_ipv4(lpm_readd_ipv4, &match);
+    }
+
+  net_unlock();
+}
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+void net_lpmroute_del_ipv6(const net_ipv6addr_t target,
+                           const net_ipv6addr_t netmask)
+{
+  struct lpm_match_ipv6_s match;
+  int plen;
+
+  net_lock();
+
+  plen = lpm_mask2plen((FAR const uint8_t *)netmask,
+                       sizeof(net_ipv6addr_t));
+  if (g_ipv6_trie.loaded && plen >= 0 &&
+      lpm_remove(&g_ipv6_trie, (FAR const uint8_t *)target, plen) >= 0)
+    {
+      /* Fall back to the next route to the same network, if any */
+
+      net_ipv6addr_copy(match.target, target);
+      net_ipv6addr_copy(match.netmask, netmask);
+      net_foreachroute_ipv6(lpm_readd_ipv6, &match);
+    }
+
+  net_unlock();
+}
+#endif
+
+#endif /* HAVE_LPMROUTE_IPv4 || HAVE_LPMROUTE_IPv6 */
@@ -34,6 +34,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -208,6 +209,18 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
       return -ENOENT;
     }
 
+#ifdef HAVE_LPMROUTE_IPv4
+  /* Find the most specific route in the trie, unless it does not hold all
+   * of the routes.
+   */
+
+  ret = net_lpmroute_ipv4(target, router);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -283,6 +296,18 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
       return -ENOENT;
     }
 
+#ifdef HAVE_LPMROUTE_IPv6
+  /* Find the most specific route in the trie, unless it does not hold all
+   * of the routes.
+   */
+
+  ret = net_lpmroute_ipv6(target, router);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
@@ -251,6 +251,7 @@ int accept(int sockfd, FAR struct sockaddr *addr, FAR socklen_t *addrlen)
 
       if (fs_getfilep(sockfd, &filep) == 0)
         {
+          fs_putfilep(filep);
           errcode = ENOTSOCK;
         }
       else
@@ -148,6 +148,7 @@ int listen(int sockfd, int backlog)
 
       if (fs_getfilep(sockfd, &filep) == 0)
         {
+          fs_putfilep(filep);
           errcode = ENOTSOCK;
         }
       else
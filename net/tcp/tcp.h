@@ -100,6 +100,7 @@
 /* The TCP options flags */
 
 #define TCP_WSCALE            0x01U /* Window Scale option enabled */
+#define TCP_SACK              0x02U /* Selective ACK option enabled */
 
 /* After receiving 3 duplicate ACKs, TCP performs a retransmission
  * (RFC 5681 (3.2))
@@ -107,6 +108,12 @@
 
 #define TCP_FAST_RETRANSMISSION_THRESH 3
 
+/* The number of SACK blocks kept in the scoreboard of a connection.  A peer
+ * reports at most 4 blocks per segment (3 with timestamps).
+ */
+
+#define TCP_SACK_NBLOCKS      4
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -115,6 +122,40 @@ struct file;      /* Forward reference */
 struct sockaddr;  /* Forward reference */
 struct socket;    /* Forward reference */
 struct pollfd;    /* Forward reference */
+struct tcp_conn_s; /* Forward reference */
+
+#ifdef CONFIG_NET_TCP_CC
+/* A congestion control algorithm.  The common logic in tcp_cc.c does slow
+ * start, fast recovery (RFC 6582) and the retransmission timeout response;
+ * the algorithm only decides how the window grows in congestion avoidance
+ * and how far it is reduced after a loss.  All operations are called with
+ * the network locked.
+ *
+ *   name       - The name used with the TCP_CONGESTION socket option
+ *   init       - Reset the private state when the connection starts or the
+ *                algorithm is changed
+ *   cong_avoid - nacked bytes were acknowledged while cwnd >= ssthresh
+ *   ssthresh   - Return the slow start threshold after a loss
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t nacked);
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* A block of data received by the peer out of order (RFC 2018) */
+
+struct tcp_sack_s
+{
+  uint32_t left;          /* First sequence number of the block */
+  uint32_t right;         /* Sequence number following the block */
+};
+#endif
 
 /* Representation of a TCP connection.
  *
@@ -178,6 +219,10 @@ struct tcp_conn_s
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS) || \
     defined(CONFIG_NET_SENDFILE)
   uint32_t rexmit_seq;    /* The sequence number to be retrasmitted */
+#endif
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR struct tcp_conn_s *hnext; /* Next in the active connection hash */
+  FAR struct tcp_conn_s *lnext; /* Next in the listener hash */
 #endif
   uint8_t  crefs;         /* Reference counts on this instance */
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
@@ -263,6 +308,41 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control (RFC 5681).  All sizes are in bytes.
+   *
+   *   cc       - The congestion control algorithm in use
+   *   cwnd     - Limit on the data in flight (tx_unacked)
+   *   ssthresh - Slow start threshold
+   *   recover  - sndseq_max when fast recovery was entered; recovery ends
+   *              when this is acknowledged
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t   cwnd;        /* Congestion window */
+  uint32_t   ssthresh;    /* Slow start threshold */
+  uint32_t   recover;     /* End of the current fast recovery */
+  bool       inrecovery;  /* True: In fast recovery */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  uint32_t   cubic_wmax;  /* Window before the last reduction */
+  uint32_t   cubic_origin; /* Window at the plateau of the cubic curve */
+  uint32_t   cubic_west;  /* Estimate of a Reno window (TCP friendliness) */
+  uint32_t   cubic_k;     /* Time to reach the plateau (msec) */
+  clock_t    cubic_epoch; /* Start of the congestion avoidance epoch */
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* The SACK scoreboard, sorted by sequence number, and the end of the
+   * data retransmitted from the holes between its blocks during the
+   * current recovery.
+   */
+
+  struct tcp_sack_s sack[TCP_SACK_NBLOCKS];
+  uint8_t    nsack;       /* The number of valid blocks */
+  uint32_t   sack_rexmit; /* Highest retransmitted sequence number */
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -380,6 +460,15 @@ extern "C"
 {
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* The available congestion control algorithms */
+
+extern const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+extern const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1208,6 +1297,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device driver structure that received the data
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1224,7 +1314,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 
 /****************************************************************************
@@ -1711,6 +1802,167 @@ uint32_t tcp_wrbuffer_inqueue_size(FAR struct tcp_conn_s *conn);
 int tcp_wrbuffer_test(void);
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Select the default congestion control algorithm for a newly allocated
+ *   connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_start
+ *
+ * Description:
+ *   Set the initial congestion window (RFC 3390) when the connection
+ *   enters the ESTABLISHED state and the MSS is known.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_start(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_setalgo
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no algorithm of that name.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+int tcp_cc_setalgo(FAR struct tcp_conn_s *conn, FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window when nacked bytes of new data are
+ *   acknowledged by ackno.
+ *
+ * Returned Value:
+ *   True if this is a partial acknowledgement during fast recovery and the
+ *   segment at ackno must be retransmitted.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                uint32_t nacked);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_dupack
+ *
+ * Description:
+ *   Handle a duplicate ACK.  The threshold-th duplicate starts fast
+ *   recovery, later ones inflate the window by one segment each.
+ *
+ * Returned Value:
+ *   True if fast recovery has just been entered and the segment at the
+ *   acknowledged sequence number must be retransmitted.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+bool tcp_cc_dupack(FAR struct tcp_conn_s *conn, uint8_t ndupacks);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission timeout.  Must
+ *   be called before the data in flight is reset for the retransmission.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Merge the SACK blocks of an incoming ACK into the scoreboard of the
+ *   connection and discard the blocks below the acknowledged sequence
+ *   number.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_input(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_nexthole
+ *
+ * Description:
+ *   Find the next range of data that the peer has not received, but has
+ *   received data beyond, and that has not been retransmitted yet during
+ *   the current recovery.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   ackno  - The cumulative acknowledgement of the peer
+ *   seq    - Returns the start of the hole
+ *   len    - Returns the length of the hole
+ *
+ * Returned Value:
+ *   True if there is such a hole.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+bool tcp_sack_nexthole(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                       FAR uint32_t *seq, FAR uint32_t *len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_reset
+ *
+ * Description:
+ *   Forget the scoreboard, as required after a retransmission timeout
+ *   (RFC 2018, section 8).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_reset(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_event_handler_dump
  *
@@ -35,6 +35,7 @@
 #include <nuttx/net/netstats.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "tcp/tcp.h"
 
 #ifdef NET_TCP_HAVE_STACK
@@ -85,7 +86,7 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        * partial packets will not be buffered.
        */
 
-      recvlen = tcp_datahandler(conn, buffer, buflen);
+      recvlen = tcp_datahandler(dev, conn, buffer, buflen);
       if (recvlen < buflen)
         {
           /* There is no handler to receive new data and there are no free
@@ -215,6 +216,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device driver structure that received the data
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -231,7 +233,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t buflen)
 {
   FAR struct iob_s *iob;
@@ -239,6 +242,32 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
   int ret;
   unsigned int i;
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* If the packet was received into an I/O buffer, append that buffer to
+   * the read-ahead data instead of copying the payload.
+   */
+
+  iob = netdev_iob_steal(dev, buffer, buflen, IOBUSER_NET_TCP_READAHEAD);
+  if (iob != NULL)
+    {
+      if (conn->readahead == NULL)
+        {
+          conn->readahead = iob;
+        }
+      else
+        {
+          iob_concat(conn->readahead, iob);
+        }
+
+#ifdef CONFIG_NET_TCP_NOTIFIER
+      tcp_readahead_signal(conn);
+#endif
+
+      ninfo("Buffered %" PRIu16 " bytes\n", buflen);
+      return buflen;
+    }
+#endif
+
   /* Try to allocate I/O buffers and copy the data into them
    * without waiting (and throttling as necessary).
    */
@@ -264,7 +293,8 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
 
       if (iob == NULL)
         {
-          iob = iob_tryalloc(throttled, IOBUSER_NET_TCP_READAHEAD);
+          iob = iob_tryalloc_size(throttled, buflen,
+                                  IOBUSER_NET_TCP_READAHEAD);
           if (iob == NULL)
             {
               continue;
@@ -0,0 +1,368 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#  define MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_newreno_init(FAR struct tcp_conn_s *conn);
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t nacked);
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",                  /* name */
+  tcp_newreno_init,           /* init */
+  tcp_newreno_cong_avoid,     /* cong_avoid */
+  tcp_newreno_ssthresh        /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algos[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+};
+
+#define TCP_CC_NALGOS (sizeof(g_tcp_cc_algos) / sizeof(g_tcp_cc_algos[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_find
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s *tcp_cc_find(FAR const char *name)
+{
+  int i;
+
+  for (i = 0; i < TCP_CC_NALGOS; i++)
+    {
+      if (strcmp(g_tcp_cc_algos[i]->name, name) == 0)
+        {
+          return g_tcp_cc_algos[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_init
+ ****************************************************************************/
+
+static void tcp_newreno_init(FAR struct tcp_conn_s *conn)
+{
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   Grow the window by about one segment per round trip (RFC 5681, 3.1).
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t nacked)
+{
+  uint32_t inc;
+
+  inc = (uint32_t)(((uint64_t)conn->mss * MIN(nacked, conn->mss)) /
+                   conn->cwnd);
+  conn->cwnd += MAX(inc, 1);
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked / 2, 2 * (uint32_t)conn->mss);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Select the default congestion control algorithm for a newly allocated
+ *   connection.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cc = tcp_cc_find(CONFIG_NET_TCP_CC_DEFAULT);
+  if (conn->cc == NULL)
+    {
+      conn->cc = &g_tcp_cc_newreno;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_start
+ *
+ * Description:
+ *   Set the initial congestion window (RFC 3390) when the connection
+ *   enters the ESTABLISHED state and the MSS is known.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_start(FAR struct tcp_conn_s *conn)
+{
+  uint32_t mss = conn->mss;
+
+  conn->cwnd       = MIN(4 * mss, MAX(2 * mss, 4380));
+  conn->ssthresh   = UINT32_MAX;
+  conn->recover    = tcp_getsequence(conn->sndseq);
+  conn->inrecovery = false;
+  conn->cc->init(conn);
+
+#ifdef CONFIG_NET_TCP_SACK
+  tcp_sack_reset(conn);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_cc_setalgo
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no algorithm of that name.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_setalgo(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  FAR const struct tcp_cc_ops_s *cc = tcp_cc_find(name);
+
+  if (cc == NULL)
+    {
+      return -ENOENT;
+    }
+
+  if (cc != conn->cc)
+    {
+      conn->cc = cc;
+      cc->init(conn);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window when nacked bytes of new data are
+ *   acknowledged by ackno.
+ *
+ * Returned Value:
+ *   True if this is a partial acknowledgement during fast recovery and the
+ *   segment at ackno must be retransmitted.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                uint32_t nacked)
+{
+  if (conn->inrecovery)
+    {
+      if (TCP_SEQ_GTE(ackno, conn->recover))
+        {
+          /* A full acknowledgement ends the recovery and deflates the
+           * window (RFC 6582, 3.2 step 3).
+           */
+
+          conn->cwnd       = MIN(conn->ssthresh,
+                                 conn->tx_unacked + conn->mss);
+          conn->inrecovery = false;
+          return false;
+        }
+
+      /* A partial acknowledgement: the next hole must be retransmitted.
+       * Deflate the window by the amount of new data acknowledged and add
+       * back one segment (RFC 6582, 3.2 step 4).
+       */
+
+      conn->cwnd = conn->cwnd > nacked ? conn->cwnd - nacked : 0;
+      if (nacked >= conn->mss)
+        {
+          conn->cwnd += conn->mss;
+        }
+
+      conn->cwnd = MAX(conn->cwnd, conn->mss);
+      return true;
+    }
+
+  /* Only grow the window if it limited the sender (RFC 7661) */
+
+  if (conn->tx_unacked + nacked + conn->mss < conn->cwnd)
+    {
+      return false;
+    }
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start (RFC 5681, 3.1 and RFC 3465 with L = 1 SMSS) */
+
+      conn->cwnd += MIN(nacked, conn->mss);
+    }
+  else
+    {
+      conn->cc->cong_avoid(conn, nacked);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_dupack
+ *
+ * Description:
+ *   Handle a duplicate ACK.  The threshold-th duplicate starts fast
+ *   recovery, later ones inflate the window by one segment each.
+ *
+ * Returned Value:
+ *   True if fast recovery has just been entered and the segment at the
+ *   acknowledged sequence number must be retransmitted.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_dupack(FAR struct tcp_conn_s *conn, uint8_t ndupacks)
+{
+  if (conn->inrecovery)
+    {
+      /* Each duplicate means that a segment has left the network */
+
+      conn->cwnd += conn->mss;
+      return false;
+    }
+
+  if (ndupacks != TCP_FAST_RETRANSMISSION_THRESH)
+    {
+      return false;
+    }
+
+  ninfo("Fast recovery: cwnd=%" PRIu32 " flight=%" PRIu32 "\n",
+        conn->cwnd, (uint32_t)conn->tx_unacked);
+
+  conn->ssthresh   = conn->cc->ssthresh(conn);
+  conn->cwnd       = conn->ssthresh + 3 * conn->mss;
+  conn->recover    = conn->sndseq_max;
+  conn->inrecovery = true;
+  return true;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission timeout.  Must
+ *   be called before the data in flight is reset for the retransmission.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  /* Only the first timeout of a loss episode lowers the threshold, the
+   * data in flight is meaningless for the backed off retransmissions.
+   */
+
+  if (conn->nrtx <= 1)
+    {
+      conn->ssthresh = conn->cc->ssthresh(conn);
+    }
+
+  conn->cwnd       = conn->mss;
+  conn->inrecovery = false;
+
+#ifdef CONFIG_NET_TCP_SACK
+  tcp_sack_reset(conn);
+#endif
+}
+
+#endif /* CONFIG_NET_TCP_CC */
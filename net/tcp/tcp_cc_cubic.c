@@ -0,0 +1,230 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CUBIC (RFC 8312) with C = 0.4 and beta = 0.7.  The window is kept in
+ * bytes and the time in milliseconds, so the cubic function
+ *
+ *   W(t) = C * (t - K)^3 + W_max        (segments, seconds)
+ *
+ * becomes W(t) = W_max + mss * (t - K)^3 / CUBIC_SCALE with t and K in
+ * milliseconds, CUBIC_SCALE = 1e9 / C.
+ */
+
+#define CUBIC_SCALE         2500000000ull
+#define CUBIC_BETA(w)       ((uint32_t)(((uint64_t)(w) * 717) >> 10))
+#define CUBIC_FASTCONV(w)   ((uint32_t)(((uint64_t)(w) * 1741) >> 11))
+
+/* The Reno friendly window grows by 3 * (1 - beta) / (1 + beta) ~ 9 / 17
+ * segments per round trip.
+ */
+
+#define CUBIC_RENO_NUM      9
+#define CUBIC_RENO_DEN      17
+
+/* Bound (t - K) to keep (t - K)^3 within 64 bits */
+
+#define CUBIC_MAXDELTA      (1 << 20)
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#  define MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t nacked);
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                    /* name */
+  tcp_cubic_init,             /* init */
+  tcp_cubic_cong_avoid,       /* cong_avoid */
+  tcp_cubic_ssthresh          /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cubic_wmax  = 0;
+  conn->cubic_epoch = 0;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Grow the window towards the cubic function of the time since the last
+ *   reduction, but never slower than Reno would (RFC 8312, 4.2 - 4.4).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t nacked)
+{
+  uint32_t cwnd = conn->cwnd;
+  uint32_t mss = conn->mss;
+  uint32_t target;
+  int64_t delta;
+  int64_t offs;
+  clock_t now = clock_systime_ticks();
+
+  if (conn->cubic_epoch == 0)
+    {
+      /* A new congestion avoidance epoch */
+
+      conn->cubic_epoch = now != 0 ? now : 1;
+      conn->cubic_west  = cwnd;
+
+      if (cwnd < conn->cubic_wmax)
+        {
+          conn->cubic_k      =
+            tcp_cubic_cbrt((conn->cubic_wmax - cwnd) * CUBIC_SCALE / mss);
+          conn->cubic_origin = conn->cubic_wmax;
+        }
+      else
+        {
+          conn->cubic_k      = 0;
+          conn->cubic_origin = cwnd;
+        }
+    }
+
+  delta = (int64_t)TICK2MSEC(now - conn->cubic_epoch) - conn->cubic_k;
+  delta = MIN(MAX(delta, -CUBIC_MAXDELTA), CUBIC_MAXDELTA);
+
+  offs   = delta * delta * delta / (int64_t)(CUBIC_SCALE / 1000) *
+           mss / 1000;
+  offs  += conn->cubic_origin;
+  target = offs < 0 ? 0 : offs > UINT32_MAX ? UINT32_MAX : (uint32_t)offs;
+
+  /* Do not more than grow by half a window per round trip */
+
+  target = MIN(target, cwnd + cwnd / 2);
+  if (target > cwnd)
+    {
+      cwnd += (uint32_t)((uint64_t)(target - cwnd) * nacked / cwnd);
+    }
+  else
+    {
+      cwnd += (uint32_t)((uint64_t)mss * nacked / (100 * (uint64_t)cwnd));
+    }
+
+  /* TCP friendly region: follow the Reno estimate if it is ahead */
+
+  conn->cubic_west += (uint32_t)((uint64_t)mss * nacked * CUBIC_RENO_NUM /
+                                 (CUBIC_RENO_DEN * (uint64_t)conn->cwnd));
+  conn->cwnd = MAX(MAX(cwnd, conn->cubic_west), conn->cwnd + 1);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   Remember where the loss happened and reduce the window by beta.  With
+ *   fast convergence, a flow whose window is shrinking releases bandwidth
+ *   by remembering a lower maximum (RFC 8312, 4.6).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t cwnd = conn->cwnd;
+
+  if (cwnd < conn->cubic_wmax)
+    {
+      conn->cubic_wmax = CUBIC_FASTCONV(cwnd);
+    }
+  else
+    {
+      conn->cubic_wmax = cwnd;
+    }
+
+  conn->cubic_epoch = 0;
+  return MAX(CUBIC_BETA(cwnd), 2 * (uint32_t)conn->mss);
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -76,6 +76,22 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  if (CONFIG_NET_TCP_CONN_HASHSIZE & (CONFIG_NET_TCP_CONN_HASHSIZE - 1)) != 0
+#    error CONFIG_NET_TCP_CONN_HASHSIZE must be a power of two
+#  endif
+
+/* Active connections are hashed on their port pair only.  The addresses
+ * live in a union whose meaning depends on the domain of the packet, and
+ * the local address may be a wildcard, so they are compared while walking
+ * the bucket instead.
+ */
+
+#  define TCP_CONN_HASH(lport, rport) \
+     (((lport) ^ (rport) ^ (((lport) ^ (rport)) >> 8)) & \
+      (CONFIG_NET_TCP_CONN_HASHSIZE - 1))
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,10 +110,85 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The active connections again, indexed by TCP_CONN_HASH() */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_CONN_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_activate
+ *
+ * Description:
+ *   Add a connection to the active list.  Its local and remote ports must
+ *   already be set.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_activate(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR struct tcp_conn_s **pprev;
+
+  /* Append to the bucket so that the older of two connections with the
+   * same ports, e.g. one in TIME_WAIT, is still found first as it would be
+   * in the active list.
+   */
+
+  pprev = &g_tcp_connhash[TCP_CONN_HASH(conn->lport, conn->rport)];
+  while (*pprev != NULL)
+    {
+      pprev = &(*pprev)->hnext;
+    }
+
+  conn->hnext = NULL;
+  *pprev      = conn;
+#endif
+
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+}
+
+/****************************************************************************
+ * Name: tcp_deactivate
+ *
+ * Description:
+ *   Remove a connection from the active list.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_deactivate(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR struct tcp_conn_s **pprev;
+
+  pprev = &g_tcp_connhash[TCP_CONN_HASH(conn->lport, conn->rport)];
+  while (*pprev != NULL)
+    {
+      if (*pprev == conn)
+        {
+          *pprev = conn->hnext;
+          break;
+        }
+
+      pprev = &(*pprev)->hnext;
+    }
+
+  conn->hnext = NULL;
+#endif
+
+  dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -293,7 +384,11 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = g_tcp_connhash[TCP_CONN_HASH(tcp->destport, tcp->srcport)];
+#else
   conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
@@ -332,7 +427,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -360,7 +459,11 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = g_tcp_connhash[TCP_CONN_HASH(tcp->destport, tcp->srcport)];
+#else
   conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
@@ -399,7 +502,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -737,6 +844,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
       nxsem_init(&conn->snd_sem, 0, 0);
       nxsem_set_protocol(&conn->snd_sem, SEM_PRIO_NONE);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+      tcp_cc_init(conn);
 #endif
     }
 
@@ -789,7 +899,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_deactivate(conn);
     }
 
   /* Release any read-ahead buffers attached to the connection */
@@ -1058,7 +1168,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_activate(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1331,7 +1441,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_activate(conn);
   ret = OK;
 
 errout_with_lock:
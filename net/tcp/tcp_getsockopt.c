@@ -26,6 +26,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -82,9 +83,9 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC)
+  /* Keep alive and congestion control are the only TCP protocol socket
+   * options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -105,10 +106,9 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
-
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -137,6 +137,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret                = OK;
           }
         break;
+#endif
 
       case TCP_NODELAY:  /* Avoid coalescing of small segments. */
         if (*value_len < sizeof(int))
@@ -155,6 +156,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
       case TCP_KEEPINTVL: /* Interval between keepalives */
         {
@@ -221,6 +223,24 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret              = OK;
           }
         break;
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          size_t len = strlen(conn->cc->name) + 1;
+
+          if (*value_len < len)
+            {
+              len = *value_len;
+            }
+
+          strncpy(value, conn->cc->name, len);
+          *value_len = len;
+          ret        = OK;
+        }
+        break;
+#endif
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -231,7 +251,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
@@ -324,9 +324,9 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_RXCSUM_VERIFIED(dev) && tcp_chksum(dev) != 0xffff)
     {
-      /* Compute and check the TCP checksum. */
+      /* Compute and check the TCP checksum, unless the device did. */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.tcp.drop++;
@@ -488,6 +488,14 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                       conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                       conn->flags    |= TCP_WSCALE;
                     }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (opt == TCP_OPT_SACK_PERM &&
+                          dev->d_buf[hdrlen + 1 + i] ==
+                          TCP_OPT_SACK_PERM_LEN)
+                    {
+                      conn->flags    |= TCP_SACK;
+                    }
 #endif
                   else
                     {
@@ -815,6 +823,16 @@ found:
       tcp_snd_wnd_update(conn, tcp);
     }
 
+#ifdef CONFIG_NET_TCP_SACK
+  /* Update the SACK scoreboard before the sender looks at the ACK */
+
+  if ((tcp->flags & TCP_ACK) != 0 && (conn->flags & TCP_SACK) != 0 &&
+      (conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+    {
+      tcp_sack_input(conn, tcp);
+    }
+#endif
+
   /* Do different things depending on in what state the connection is. */
 
   switch (conn->tcpstateflags & TCP_STATE_MASK)
@@ -872,6 +890,9 @@ found:
             conn->tx_unacked    = 0;
             tcp_snd_wnd_init(conn, tcp);
             tcp_snd_wnd_update(conn, tcp);
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_start(conn);
+#endif
 
             flags               = TCP_CONNECTED;
             ninfo("TCP state: TCP_ESTABLISHED\n");
@@ -952,6 +973,14 @@ found:
                         conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                         conn->flags    |= TCP_WSCALE;
                       }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                    else if (opt == TCP_OPT_SACK_PERM &&
+                            dev->d_buf[hdrlen + 1 + i] ==
+                            TCP_OPT_SACK_PERM_LEN)
+                      {
+                        conn->flags    |= TCP_SACK;
+                      }
 #endif
                     else
                       {
@@ -985,6 +1014,9 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_start(conn);
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -46,6 +46,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -55,6 +56,15 @@
 #include "inet/inet.h"
 #include "tcp/tcp.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  define TCP_LISTEN_HASH(portno) \
+     (((portno) ^ ((portno) >> 8)) & (CONFIG_NET_TCP_CONN_HASHSIZE - 1))
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -63,6 +73,14 @@
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The same listeners indexed by TCP_LISTEN_HASH() of their local port.  The
+ * slots above then only bound the number of listeners.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_listenhash[CONFIG_NET_TCP_CONN_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -87,6 +105,16 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno)
 #endif
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR struct tcp_conn_s *conn;
+
+  /* Examine each connection structure in the bucket of this port */
+
+  for (conn = g_tcp_listenhash[TCP_LISTEN_HASH(portno)];
+       conn != NULL;
+       conn = conn->lnext)
+    {
+#else
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
@@ -98,6 +126,7 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
        */
 
       FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       if (conn && conn->lport == portno && conn->domain == domain)
 #else
@@ -158,6 +187,9 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR struct tcp_conn_s **pprev;
+#endif
   int ndx;
   int ret = -EINVAL;
 
@@ -172,6 +204,21 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
         }
     }
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  if (ret == OK)
+    {
+      pprev = &g_tcp_listenhash[TCP_LISTEN_HASH(conn->lport)];
+      while (*pprev != conn)
+        {
+          DEBUGASSERT(*pprev != NULL);
+          pprev = &(*pprev)->lnext;
+        }
+
+      *pprev      = conn->lnext;
+      conn->lnext = NULL;
+    }
+#endif
+
   net_unlock();
   return ret;
 }
@@ -233,6 +280,24 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      if (ret == OK)
+        {
+          FAR struct tcp_conn_s **pprev;
+
+          /* Append so that earlier listeners are still found first */
+
+          pprev = &g_tcp_listenhash[TCP_LISTEN_HASH(conn->lport)];
+          while (*pprev != NULL)
+            {
+              pprev = &(*pprev)->lnext;
+            }
+
+          conn->lnext = NULL;
+          *pprev      = conn;
+        }
+#endif
     }
 
   net_unlock();
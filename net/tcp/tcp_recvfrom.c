@@ -186,7 +186,7 @@ static inline uint16_t tcp_newdata(FAR struct net_driver_s *dev,
       uint16_t buflen = dev->d_len - recvlen;
       uint16_t nsaved;
 
-      nsaved = tcp_datahandler(conn, buffer, buflen);
+      nsaved = tcp_datahandler(dev, conn, buffer, buflen);
       if (nsaved < buflen)
         {
           nwarn("WARNING: packet data not fully saved "
@@ -0,0 +1,288 @@
+/****************************************************************************
+ * net/tcp/tcp_sack.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_SACK
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_get32
+ ****************************************************************************/
+
+static inline uint32_t tcp_sack_get32(FAR const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/****************************************************************************
+ * Name: tcp_sack_add
+ *
+ * Description:
+ *   Add a block to the scoreboard, merging it with the blocks it overlaps
+ *   or touches.  If the scoreboard is full, the highest block is dropped:
+ *   the holes at the low end are the ones that stall the sender.
+ *
+ ****************************************************************************/
+
+static void tcp_sack_add(FAR struct tcp_conn_s *conn, uint32_t left,
+                         uint32_t right)
+{
+  FAR struct tcp_sack_s *sack = conn->sack;
+  int n = conn->nsack;
+  int i;
+  int j;
+
+  /* Absorb the existing blocks that overlap or touch the new one */
+
+  for (i = 0; i < n; )
+    {
+      if (TCP_SEQ_GT(sack[i].left, right) ||
+          TCP_SEQ_LT(sack[i].right, left))
+        {
+          i++;
+          continue;
+        }
+
+      if (TCP_SEQ_LT(sack[i].left, left))
+        {
+          left = sack[i].left;
+        }
+
+      if (TCP_SEQ_GT(sack[i].right, right))
+        {
+          right = sack[i].right;
+        }
+
+      for (j = i + 1; j < n; j++)
+        {
+          sack[j - 1] = sack[j];
+        }
+
+      n--;
+    }
+
+  /* Insert the result in sequence order */
+
+  i = 0;
+  while (i < n && TCP_SEQ_LT(sack[i].left, left))
+    {
+      i++;
+    }
+
+  if (i < TCP_SACK_NBLOCKS)
+    {
+      if (n == TCP_SACK_NBLOCKS)
+        {
+          n--;
+        }
+
+      for (j = n; j > i; j--)
+        {
+          sack[j] = sack[j - 1];
+        }
+
+      sack[i].left  = left;
+      sack[i].right = right;
+      n++;
+    }
+
+  conn->nsack = n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Merge the SACK blocks of an incoming ACK into the scoreboard of the
+ *   connection and discard the blocks below the acknowledged sequence
+ *   number.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_input(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
+{
+  FAR const uint8_t *opt = tcp->optdata;
+  uint32_t ackno = tcp_getsequence(tcp->ackno);
+  uint32_t left;
+  uint32_t right;
+  int optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  int len;
+  int i;
+  int j;
+
+  /* Look for the SACK option */
+
+  for (i = 0; i < optlen; )
+    {
+      if (opt[i] == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt[i] == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+
+      len = i + 1 < optlen ? opt[i + 1] : 0;
+      if (len < 2 || i + len > optlen)
+        {
+          /* Malformed options */
+
+          break;
+        }
+
+      if (opt[i] == TCP_OPT_SACK)
+        {
+          for (j = i + 2; j + 8 <= i + len; j += 8)
+            {
+              left  = tcp_sack_get32(&opt[j]);
+              right = tcp_sack_get32(&opt[j + 4]);
+
+              /* Ignore the blocks that are empty, beyond what we have sent
+               * or already ACKed (as are the D-SACK blocks of RFC 2883).
+               */
+
+              if (TCP_SEQ_GT(right, left) && TCP_SEQ_GT(right, ackno) &&
+                  TCP_SEQ_LTE(right, conn->sndseq_max))
+                {
+                  ninfo("SACK: %" PRIu32 "-%" PRIu32 " ackno=%" PRIu32 "\n",
+                        left, right, ackno);
+                  tcp_sack_add(conn, left, right);
+                }
+            }
+        }
+
+      i += len;
+    }
+
+  /* Drop what the cumulative ACK now covers */
+
+  for (i = 0, j = 0; i < conn->nsack; i++)
+    {
+      if (TCP_SEQ_LTE(conn->sack[i].right, ackno))
+        {
+          continue;
+        }
+
+      conn->sack[j] = conn->sack[i];
+      if (TCP_SEQ_LT(conn->sack[j].left, ackno))
+        {
+          conn->sack[j].left = ackno;
+        }
+
+      j++;
+    }
+
+  conn->nsack = j;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_nexthole
+ *
+ * Description:
+ *   Find the next range of data that the peer has not received, but has
+ *   received data beyond, and that has not been retransmitted yet during
+ *   the current recovery.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   ackno  - The cumulative acknowledgement of the peer
+ *   seq    - Returns the start of the hole
+ *   len    - Returns the length of the hole
+ *
+ * Returned Value:
+ *   True if there is such a hole.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+bool tcp_sack_nexthole(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                       FAR uint32_t *seq, FAR uint32_t *len)
+{
+  uint32_t start = ackno;
+  int i;
+
+  if (TCP_SEQ_GT(conn->sack_rexmit, start))
+    {
+      start = conn->sack_rexmit;
+    }
+
+  for (i = 0; i < conn->nsack; i++)
+    {
+      if (TCP_SEQ_LT(start, conn->sack[i].left))
+        {
+          *seq = start;
+          *len = TCP_SEQ_SUB(conn->sack[i].left, start);
+          return true;
+        }
+
+      if (TCP_SEQ_LT(start, conn->sack[i].right))
+        {
+          start = conn->sack[i].right;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_reset
+ *
+ * Description:
+ *   Forget the scoreboard, as required after a retransmission timeout
+ *   (RFC 2018, section 8).
+ *
+ ****************************************************************************/
+
+void tcp_sack_reset(FAR struct tcp_conn_s *conn)
+{
+  conn->nsack = 0;
+}
+
+#endif /* CONFIG_NET_TCP_SACK */
@@ -155,7 +155,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]      = 0;
 
   tcp->tcpchksum    = 0;
-  tcp->tcpchksum    = ~tcp_ipv4_chksum(dev);
+  if (!NETDEV_TXCSUM_OFFLOADED(dev))
+    {
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+    }
 
   /* Finish initializing the IP header and calculate the IP checksum */
 
@@ -170,7 +173,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~ipv4_chksum(dev);
+  if (!NETDEV_TXCSUM_OFFLOADED(dev))
+    {
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
 
   ninfo("IPv4 length: %d\n", ((int)ipv4->len[0] << 8) + ipv4->len[1]);
 
@@ -227,7 +233,10 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]     = 0;
 
   tcp->tcpchksum   = 0;
-  tcp->tcpchksum   = ~tcp_ipv6_chksum(dev);
+  if (!NETDEV_TXCSUM_OFFLOADED(dev))
+    {
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
 
   /* Finish initializing the IP header (no IPv6 checksum) */
 
@@ -252,6 +261,8 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
  *
  * Input Parameters:
  *   dev - The device driver structure to use in the send operation
+ *   tcp - The TCP header of the packet
+ *   mss - The MSS of the connection, zero if not known
  *
  * Returned Value:
  *   None
@@ -262,8 +273,33 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
  ****************************************************************************/
 
 static void tcp_sendcomplete(FAR struct net_driver_s *dev,
-                             FAR struct tcp_hdr_s *tcp)
+                             FAR struct tcp_hdr_s *tcp, uint16_t mss)
 {
+#ifdef CONFIG_NETDEV_OFFLOAD
+  unsigned int hdrlen;
+
+  /* Leave the checksums to the device if it can compute them and segments
+   * larger than the MSS to the device if it can split them.
+   */
+
+  hdrlen = (FAR uint8_t *)tcp - &dev->d_buf[NET_LL_HDRLEN(dev)] +
+           ((tcp->tcpoffset >> 4) << 2);
+
+  dev->d_pktflags = 0;
+  if (mss > 0 && dev->d_len > hdrlen + mss &&
+      (dev->d_offload & NETDEV_OFFLOAD_TSO) != 0)
+    {
+      dev->d_pktflags = NETDEV_PKT_TSO | NETDEV_PKT_TXCSUM;
+      dev->d_tsosize  = mss;
+    }
+  else if ((dev->d_offload & NETDEV_OFFLOAD_TXCSUM) != 0)
+    {
+      dev->d_pktflags = NETDEV_PKT_TXCSUM;
+    }
+#else
+  UNUSED(mss);
+#endif
+
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -381,7 +417,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 
   /* Finish the IP portion of the message and calculate checksums */
 
-  tcp_sendcomplete(dev, tcp);
+  tcp_sendcomplete(dev, tcp, conn->mss);
 
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS)
   if ((tcp->flags & (TCP_SYN | TCP_FIN)) != 0)
@@ -581,7 +617,7 @@ void tcp_reset(FAR struct net_driver_s *dev)
 
   /* And send out the RST packet */
 
-  tcp_sendcomplete(dev, tcp);
+  tcp_sendcomplete(dev, tcp, 0);
 }
 
 /****************************************************************************
@@ -709,6 +745,22 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+  /* Offer SACK in our SYN and accept it in the SYNACK if the peer offered
+   * it.  We never send SACK blocks ourselves since out-of-order data is not
+   * kept, but we make use of the blocks reported by the peer.
+   */
+
+  if (tcp->flags == TCP_SYN ||
+      ((tcp->flags == (TCP_ACK | TCP_SYN)) && (conn->flags & TCP_SACK)))
+    {
+      tcp->optdata[optlen++] = TCP_OPT_NOOP;
+      tcp->optdata[optlen++] = TCP_OPT_NOOP;
+      tcp->optdata[optlen++] = TCP_OPT_SACK_PERM;
+      tcp->optdata[optlen++] = TCP_OPT_SACK_PERM_LEN;
+    }
+#endif
+
   tcp->tcpoffset         = ((TCP_HDRLEN + optlen) / 4) << 4;
   dev->d_len            += optlen;
 
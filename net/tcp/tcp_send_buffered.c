@@ -290,6 +290,47 @@ static inline void send_ipselect(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: send_maxlen
+ *
+ * Description:
+ *   Return the largest amount of data to send in one packet.  This is the
+ *   MSS unless the device splits larger segments itself, then as many whole
+ *   MSS sized segments as fit into the largest packet of the device.
+ *
+ * Input Parameters:
+ *   dev  - The structure of the network driver that caused the event
+ *   conn - The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   The maximum number of bytes of payload.
+ *
+ ****************************************************************************/
+
+static inline uint32_t send_maxlen(FAR struct net_driver_s *dev,
+                                   FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NETDEV_OFFLOAD
+  if ((dev->d_offload & NETDEV_OFFLOAD_TSO) != 0)
+    {
+      uint32_t maxlen = dev->d_tsomax - NET_LL_HDRLEN(dev) - TCP_HDRLEN;
+
+#ifdef CONFIG_NET_IPv6
+      maxlen -= IPv6_HDRLEN;
+#else
+      maxlen -= IPv4_HDRLEN;
+#endif
+
+      if (maxlen > conn->mss)
+        {
+          return maxlen - maxlen % conn->mss;
+        }
+    }
+#endif
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -378,6 +419,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
       uint32_t ackno;
+#ifdef CONFIG_NET_TCP_CC
+      uint32_t acked = 0;
+#endif
 
       /* Get the offset address of the TCP header */
 
@@ -444,6 +488,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                   /* Yes... Remove the write buffer from ACK waiting queue */
 
                   sq_rem(entry, &conn->unacked_q);
+#ifdef CONFIG_NET_TCP_CC
+                  acked += TCP_WBPKTLEN(wrb);
+#endif
 
                   /* And return the write buffer to the pool of free
                    * buffers
@@ -476,10 +523,16 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                     }
 
                   ninfo("ACK: wrb=%p trim %u bytes\n", wrb, trimlen);
+#ifdef CONFIG_NET_TCP_CC
+                  acked += trimlen;
+#endif
 
                   TCP_WBTRIM(wrb, trimlen);
                   TCP_WBSEQNO(wrb) += trimlen;
                   TCP_WBSENT(wrb) -= trimlen;
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+                  TCP_WBNACK(wrb) = 0;
+#endif
 
                   /* Set the new sequence number for what remains */
 
@@ -499,6 +552,35 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
               /* Duplicate ACK? Retransmit data if need */
 
+#ifdef CONFIG_NET_TCP_CC
+              /* The congestion control decides when to enter fast
+               * recovery, and retransmits from the SACK holes after.  An
+               * ACK that has just freed the previous buffers is not a
+               * duplicate.
+               */
+
+              if (acked == 0)
+                {
+                  if (TCP_WBNACK(wrb) < UINT8_MAX)
+                    {
+                      TCP_WBNACK(wrb)++;
+                    }
+
+                  if (tcp_cc_dupack(conn, TCP_WBNACK(wrb)))
+                    {
+                      rexmitno = ackno;
+#ifdef CONFIG_NET_TCP_SACK
+                      conn->sack_rexmit = ackno;
+#endif
+                    }
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (conn->inrecovery && conn->nsack > 0)
+                    {
+                      rexmitno = ackno;
+                    }
+#endif
+                }
+#else
               if (++TCP_WBNACK(wrb) == TCP_FAST_RETRANSMISSION_THRESH)
                 {
                   /* Do fast retransmit */
@@ -509,6 +591,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
                   TCP_WBNACK(wrb) = 0;
                 }
+#endif
             }
 #endif
         }
@@ -545,7 +628,21 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
           ninfo("ACK: wrb=%p seqno=%" PRIu32 " pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
+#ifdef CONFIG_NET_TCP_CC
+          acked += nacked;
+#endif
         }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Let the congestion control account the new data ACKed.  A partial
+       * ACK during fast recovery asks for the next hole to be resent.
+       */
+
+      if (acked > 0 && tcp_cc_ack(conn, ackno, acked))
+        {
+          rexmitno = ackno;
+        }
+#endif
     }
 
   /* Check for a loss of connection */
@@ -578,18 +675,34 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR struct tcp_wrbuffer_s *wrb;
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
+      uint32_t rexmitlen = conn->mss;
+      uint32_t offset;
       size_t sndlen;
 
+#ifdef CONFIG_NET_TCP_SACK
+      /* With the SACK scoreboard, resend the first hole that has not been
+       * retransmitted during this recovery (RFC 6675, NextSeg rule 1).
+       */
+
+      if (conn->inrecovery && conn->nsack > 0 &&
+          !tcp_sack_nexthole(conn, rexmitno, &rexmitno, &rexmitlen))
+        {
+          rexmitno = 0;
+        }
+#endif
+
       /* According to RFC 6298 (5.4), retransmit the earliest segment
        * that has not been acknowledged by the TCP receiver.
        */
 
-      for (entry = sq_peek(&conn->unacked_q); entry; entry = next)
+      for (entry = sq_peek(&conn->unacked_q);
+           entry != NULL && rexmitno != 0; entry = next)
         {
           wrb = (FAR struct tcp_wrbuffer_s *)entry;
           next = sq_next(entry);
 
-          if (rexmitno != TCP_WBSEQNO(wrb))
+          if (TCP_SEQ_LT(rexmitno, TCP_WBSEQNO(wrb)) ||
+              TCP_SEQ_GTE(rexmitno, TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb)))
             {
               continue;
             }
@@ -598,7 +711,13 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
            * retransmitted.
            */
 
-          sndlen = TCP_WBPKTLEN(wrb);
+          offset = TCP_SEQ_SUB(rexmitno, TCP_WBSEQNO(wrb));
+          sndlen = TCP_WBPKTLEN(wrb) - offset;
+
+          if (sndlen > rexmitlen)
+            {
+              sndlen = rexmitlen;
+            }
 
           if (sndlen > conn->mss)
             {
@@ -624,7 +743,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, 0);
+          tcp_setsequence(conn->sndseq, rexmitno);
+          devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, offset);
+
+#ifdef CONFIG_NET_TCP_SACK
+          conn->sack_rexmit = rexmitno + sndlen;
+#endif
 
           /* Reset the retransmission timer. */
 
@@ -646,6 +770,14 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Collapse the congestion window while tx_unacked still holds the
+       * data in flight.
+       */
+
+      tcp_cc_timeout(conn);
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -864,14 +996,29 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       seq = TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb);
       snd_wnd_edge = conn->snd_wl2 + conn->snd_wnd;
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Keep no more than cwnd bytes in flight */
+
+      if (conn->tx_unacked >= conn->cwnd)
+        {
+          snd_wnd_edge = seq;
+        }
+      else if (TCP_SEQ_GT(snd_wnd_edge,
+                          seq + conn->cwnd - conn->tx_unacked))
+        {
+          snd_wnd_edge = seq + conn->cwnd - conn->tx_unacked;
+        }
+#endif
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
+          uint32_t maxlen = send_maxlen(dev, conn);
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > maxlen)
             {
-              sndlen = conn->mss;
+              sndlen = maxlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
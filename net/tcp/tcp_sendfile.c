@@ -320,6 +320,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
         }
 
       dev->d_sndlen = sndlen;
+      dev->d_sndsum = 0;
 
       /* Continue waiting */
 
@@ -398,6 +399,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
             }
 
           dev->d_sndlen = sndlen;
+          dev->d_sndsum = 0;
 
           /* Update the amount of data sent (but not necessarily ACKed) */
 
@@ -26,6 +26,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -72,9 +73,9 @@
 int tcp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC)
+  /* Keep alive and congestion control are the only TCP protocol socket
+   * options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -94,10 +95,9 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
-
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -134,6 +134,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif
 
       case TCP_NODELAY: /* Avoid coalescing of small segments. */
         if (value_len != sizeof(int))
@@ -152,6 +153,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
       case TCP_KEEPINTVL: /* Interval between keepalives */
         {
@@ -233,6 +235,28 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          char name[16];
+          size_t len = value_len;
+
+          if (len >= sizeof(name))
+            {
+              return -EINVAL;
+            }
+
+          memcpy(name, value, len);
+          name[len] = '\0';
+
+          net_lock();
+          ret = tcp_cc_setalgo(conn, name);
+          net_unlock();
+        }
+        break;
+#endif
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -243,7 +267,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
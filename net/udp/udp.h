@@ -31,6 +31,7 @@
 #include <sys/socket.h>
 #include <queue.h>
 
+#include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
@@ -107,6 +108,9 @@ struct udp_conn_s
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR struct udp_conn_s *hnext; /* Next in the local port hash */
+#endif
   uint8_t  flags;         /* See _UDP_FLAG_* definitions */
   uint8_t  domain;        /* IP domain: PF_INET or PF_INET6 */
   uint8_t  ttl;           /* Default time-to-live */
@@ -141,6 +145,7 @@ struct udp_conn_s
 
   sq_queue_t write_q;             /* Write buffering for UDP packets */
   FAR struct net_driver_s *dev;   /* Last device */
+  mutex_t    sndlock;             /* Serializes the senders on the socket */
 
   /* Callback instance for UDP sendto() */
 
@@ -260,6 +265,19 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_setlport
+ *
+ * Description:
+ *   Set the local port number (network byte order) of a connection.  A
+ *   zero port number unbinds the connection.  All changes of the local
+ *   port must go through this function so that the connection stays
+ *   reachable by udp_active().
+ *
+ ****************************************************************************/
+
+void udp_setlport(FAR struct udp_conn_s *conn, uint16_t lport);
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -35,6 +35,7 @@
 #include <nuttx/net/udp.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "udp/udp.h"
 
 /****************************************************************************
@@ -65,6 +66,9 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
                                 FAR uint8_t *buffer, uint16_t buflen)
 {
   FAR struct iob_s *iob;
+#ifdef CONFIG_NETDEV_IOB_RX
+  FAR struct iob_s *payload;
+#endif
   int ret;
 #ifdef CONFIG_NET_IPv6
   FAR struct sockaddr_in6 src_addr6 =
@@ -197,6 +201,19 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
       return 0;
     }
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* If the packet was received into an I/O buffer, chain that buffer after
+   * the address instead of copying the payload.
+   */
+
+  payload = netdev_iob_steal(dev, buffer, buflen,
+                             IOBUSER_NET_UDP_READAHEAD);
+  if (payload != NULL)
+    {
+      iob_concat(iob, payload);
+    }
+  else
+#endif
   if (buflen > 0)
     {
       /* Copy the new appdata into the I/O buffer chain */
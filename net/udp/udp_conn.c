@@ -75,6 +75,26 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* Traversal of the connections that may match an incoming datagram, either
+ * the bucket of its destination port or the whole active list.
+ */
+
+#ifdef CONFIG_NET_UDP_CONN_HASH
+#  if (CONFIG_NET_UDP_CONN_HASHSIZE & (CONFIG_NET_UDP_CONN_HASHSIZE - 1)) != 0
+#    error CONFIG_NET_UDP_CONN_HASHSIZE must be a power of two
+#  endif
+
+#  define UDP_CONN_HASH(portno) \
+     (((portno) ^ ((portno) >> 8)) & (CONFIG_NET_UDP_CONN_HASHSIZE - 1))
+#  define UDP_CONN_FIRST(portno) g_udp_connhash[UDP_CONN_HASH(portno)]
+#  define UDP_CONN_NEXT(conn)    (conn)->hnext
+#else
+#  define UDP_CONN_FIRST(portno) \
+     ((FAR struct udp_conn_s *)g_active_udp_connections.head)
+#  define UDP_CONN_NEXT(conn) \
+     ((FAR struct udp_conn_s *)(conn)->sconn.node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,6 +114,14 @@ static sem_t g_free_sem = SEM_INITIALIZER(1);
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+/* The bound connections again, indexed by UDP_CONN_HASH() of their local
+ * port.
+ */
+
+static FAR struct udp_conn_s *g_udp_connhash[CONFIG_NET_UDP_CONN_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -128,11 +156,12 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
                                             uint16_t portno)
 {
-  FAR struct udp_conn_s *conn = NULL;
+  FAR struct udp_conn_s *conn;
 
   /* Now search each connection structure. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  for (conn = UDP_CONN_FIRST(portno); conn != NULL;
+       conn = UDP_CONN_NEXT(conn))
     {
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -194,7 +223,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = UDP_CONN_FIRST(udp->destport);
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -307,7 +336,7 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = UDP_CONN_NEXT(conn);
     }
 
   return conn;
@@ -333,7 +362,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = UDP_CONN_FIRST(udp->destport);
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -446,7 +475,7 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = UDP_CONN_NEXT(conn);
     }
 
   return conn;
@@ -567,6 +596,61 @@ uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
   return portno;
 }
 
+/****************************************************************************
+ * Name: udp_setlport
+ *
+ * Description:
+ *   Set the local port number (network byte order) of a connection.  A
+ *   zero port number unbinds the connection.
+ *
+ ****************************************************************************/
+
+void udp_setlport(FAR struct udp_conn_s *conn, uint16_t lport)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR struct udp_conn_s **pprev;
+
+  /* The hash is walked by the network event logic */
+
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      pprev = &g_udp_connhash[UDP_CONN_HASH(conn->lport)];
+      while (*pprev != NULL)
+        {
+          if (*pprev == conn)
+            {
+              *pprev = conn->hnext;
+              break;
+            }
+
+          pprev = &(*pprev)->hnext;
+        }
+    }
+
+  conn->hnext = NULL;
+  conn->lport = lport;
+
+  if (lport != 0)
+    {
+      /* Append so that earlier bound connections are still found first */
+
+      pprev = &g_udp_connhash[UDP_CONN_HASH(lport)];
+      while (*pprev != NULL)
+        {
+          pprev = &(*pprev)->hnext;
+        }
+
+      *pprev = conn;
+    }
+
+  net_unlock();
+#else
+  conn->lport = lport;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_initialize
  *
@@ -639,6 +723,7 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       /* Initialize the write buffer lists */
 
       sq_init(&conn->write_q);
+      nxmutex_init(&conn->sndlock);
 #endif
       /* Enqueue the connection into the active list */
 
@@ -668,8 +753,8 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+  udp_setlport(conn, 0);
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
 
   /* Remove the connection from the active list */
 
@@ -688,6 +773,8 @@ void udp_free(FAR struct udp_conn_s *conn)
       udp_wrbuffer_release(wrbuffer);
     }
 
+  nxmutex_destroy(&conn->sndlock);
+
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
 
@@ -829,8 +916,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setlport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -846,7 +933,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setlport(conn, portno);
           ret         = OK;
         }
       else
@@ -899,7 +986,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setlport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
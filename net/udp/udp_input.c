@@ -135,7 +135,13 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
   chksum = udp->udpchksum;
-  if (chksum != 0)
+  if (chksum != 0 && NETDEV_RXCSUM_VERIFIED(dev))
+    {
+      /* The device has verified the checksum */
+
+      chksum = 0;
+    }
+  else if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
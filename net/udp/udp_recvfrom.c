@@ -179,91 +179,88 @@ static inline void udp_newdata(FAR struct net_driver_s *dev,
   dev->d_len = 0;
 }
 
-static inline void udp_readahead(struct udp_recvfrom_s *pstate)
+/****************************************************************************
+ * Name: udp_readahead
+ *
+ * Description:
+ *   Copy a datagram that was taken from the read-ahead queue into the user
+ *   buffer and free it.  The datagram no longer belongs to the connection,
+ *   so this is done with the network unlocked.
+ *
+ * Input Parameters:
+ *   pstate   recvfrom state structure
+ *   iob      The I/O buffer chain holding the datagram
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+static inline void udp_readahead(FAR struct udp_recvfrom_s *pstate,
+                                 FAR struct iob_s *iob)
 {
-  FAR struct udp_conn_s *conn = pstate->ir_conn;
-  FAR struct iob_s *iob;
+  uint8_t src_addr_size;
   int recvlen;
 
-  /* Check there is any UDP datagram already buffered in a read-ahead
-   * buffer.
-   */
+  DEBUGASSERT(iob->io_pktlen > 0);
 
-  pstate->ir_recvlen = -1;
+  /* Transfer that buffered data from the I/O buffer chain into
+   * the user buffer.
+   */
 
-  if ((iob = iob_peek_queue(&conn->readahead)) != NULL)
+  recvlen = iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0);
+  if (recvlen != sizeof(uint8_t))
     {
-      FAR struct iob_s *tmp;
-      uint8_t src_addr_size;
-
-      DEBUGASSERT(iob->io_pktlen > 0);
-
-      /* Transfer that buffered data from the I/O buffer chain into
-       * the user buffer.
-       */
-
-      recvlen = iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0);
-      if (recvlen != sizeof(uint8_t))
-        {
-          goto out;
-        }
+      goto out;
+    }
 
-      if (0
+  if (0
 #ifdef CONFIG_NET_IPv6
-          || src_addr_size == sizeof(struct sockaddr_in6)
+      || src_addr_size == sizeof(struct sockaddr_in6)
 #endif
 #ifdef CONFIG_NET_IPv4
-          || src_addr_size == sizeof(struct sockaddr_in)
+      || src_addr_size == sizeof(struct sockaddr_in)
 #endif
-        )
+    )
+    {
+      if (pstate->ir_from)
         {
-          if (pstate->ir_from)
+          socklen_t len = *pstate->ir_fromlen;
+          len = (socklen_t)
+            src_addr_size > len ? len : (socklen_t)src_addr_size;
+
+          recvlen = iob_copyout((FAR uint8_t *)pstate->ir_from, iob,
+                                len, sizeof(uint8_t));
+          if (recvlen != len)
             {
-              socklen_t len = *pstate->ir_fromlen;
-              len = (socklen_t)
-                src_addr_size > len ? len : (socklen_t)src_addr_size;
-
-              recvlen = iob_copyout((FAR uint8_t *)pstate->ir_from, iob,
-                                    len, sizeof(uint8_t));
-              if (recvlen != len)
-                {
-                  goto out;
-                }
+              goto out;
             }
         }
+    }
 
-      if (pstate->ir_buflen > 0)
-        {
-          recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen,
-                                src_addr_size + sizeof(uint8_t));
+  if (pstate->ir_buflen > 0)
+    {
+      recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen,
+                            src_addr_size + sizeof(uint8_t));
 
-          ninfo("Received %d bytes (of %d)\n", recvlen, iob->io_pktlen);
+      ninfo("Received %d bytes (of %d)\n", recvlen, iob->io_pktlen);
 
-          /* Update the accumulated size of the data read */
+      /* Update the accumulated size of the data read */
 
-          pstate->ir_recvlen  = recvlen;
-          pstate->ir_buffer  += recvlen;
-          pstate->ir_buflen  -= recvlen;
-          *pstate->ir_fromlen = src_addr_size;
-        }
-      else
-        {
-          pstate->ir_recvlen = 0;
-        }
+      pstate->ir_recvlen  = recvlen;
+      pstate->ir_buffer  += recvlen;
+      pstate->ir_buflen  -= recvlen;
+      *pstate->ir_fromlen = src_addr_size;
+    }
+  else
+    {
+      pstate->ir_recvlen = 0;
+    }
 
 out:
-      /* Remove the I/O buffer chain from the head of the read-ahead
-       * buffer queue.
-       */
+  /* And free the I/O buffer chain */
 
-      tmp = iob_remove_queue(&conn->readahead);
-      DEBUGASSERT(tmp == iob);
-      UNUSED(tmp);
-
-      /* And free the I/O buffer chain */
-
-      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
-    }
+  iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
 }
 
 /****************************************************************************
@@ -603,6 +600,7 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
   struct udp_recvfrom_s state;
+  FAR struct iob_s *iob;
   int ret;
 
   /* Perform the UDP recvfrom() operation */
@@ -614,9 +612,20 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
   net_lock();
   udp_recvfrom_initialize(conn, buf, len, from, fromlen, &state);
 
-  /* Copy the read-ahead data from the packet */
+  /* Take the next datagram from the read-ahead queue, if any, and copy it
+   * with the network unlocked.  Other sockets and the network devices can
+   * make progress while the data is copied.
+   */
+
+  state.ir_recvlen = -1;
 
-  udp_readahead(&state);
+  iob = iob_remove_queue(&conn->readahead);
+  if (iob != NULL)
+    {
+      net_unlock();
+      udp_readahead(&state, iob);
+      net_lock();
+    }
 
   /* The default return value is the number of bytes that we just copied
    * into the user buffer.  We will return this if the socket has become
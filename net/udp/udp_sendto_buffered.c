@@ -260,7 +260,7 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setlport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Get the device that will handle the remote packet transfers.  This
@@ -637,13 +637,24 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   if (len > 0)
     {
-      net_lock();
+      /* Senders on the same socket are serialized by the connection lock.
+       * The network lock is only held while the connection state and the
+       * write queue are examined or updated, so that copying the user data
+       * does not stall the rest of the network.
+       */
+
+      ret = nxmutex_lock(&conn->sndlock);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
       /* If the send buffer size exceeds the send limit,
        * wait for the write buffer to be released
        */
 
+      net_lock();
       while (udp_wrbuffer_inqueue_size(conn) + len > conn->sndbufs)
         {
           if (nonblock)
@@ -663,10 +674,12 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
               goto errout_with_lock;
             }
         }
+
+      net_unlock();
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
-      /* Allocate a write buffer.  Careful, the network will be momentarily
-       * unlocked here.
+      /* Allocate a write buffer.  The network is not locked, so waiting
+       * for a buffer does not hold up the network.
        */
 
       if (nonblock)
@@ -693,9 +706,37 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
               ret = -ENOMEM;
             }
 
-          goto errout_with_lock;
+          goto errout_with_sndlock;
         }
 
+      /* Copy the user data into the write buffer.  We cannot wait for
+       * buffer space if the socket was opened non-blocking.  The write
+       * buffer is still private, so this needs no network lock.
+       */
+
+      if (nonblock)
+        {
+          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
+                              IOBUSER_NET_SOCK_UDP);
+        }
+      else
+        {
+          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
+                           IOBUSER_NET_SOCK_UDP);
+        }
+
+      if (ret < 0)
+        {
+          udp_wrbuffer_release(wrb);
+          goto errout_with_sndlock;
+        }
+
+      /* Dump I/O buffer chain */
+
+      UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
+
+      net_lock();
+
       /* Initialize the write buffer
        *
        * Check if the socket is connected
@@ -743,43 +784,6 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           memcpy(&wrb->wb_dest, to, tolen);
         }
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
-       */
-
-      if (nonblock)
-        {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
-                              IOBUSER_NET_SOCK_UDP);
-        }
-      else
-        {
-          unsigned int count;
-          int blresult;
-
-          /* iob_copyin might wait for buffers to be freed, but if
-           * network is locked this might never happen, since network
-           * driver is also locked, therefore we need to break the lock
-           */
-
-          blresult = net_breaklock(&count);
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
-                           IOBUSER_NET_SOCK_UDP);
-          if (blresult >= 0)
-            {
-              net_restorelock(count);
-            }
-        }
-
-      if (ret < 0)
-        {
-          goto errout_with_wrb;
-        }
-
-      /* Dump I/O buffer chain */
-
-      UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
-
       /* sendto_eventhandler() will send data in FIFO order from the
        * conn->write_q.
        *
@@ -815,6 +819,7 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
         }
 
       net_unlock();
+      nxmutex_unlock(&conn->sndlock);
     }
 
   /* Return the number of bytes that will be sent */
@@ -826,6 +831,9 @@ errout_with_wrb:
 
 errout_with_lock:
   net_unlock();
+
+errout_with_sndlock:
+  nxmutex_unlock(&conn->sndlock);
   return ret;
 }
 
@@ -38,6 +38,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
@@ -116,13 +117,14 @@ void udp_wrbuffer_initialize(void)
  *   None
  *
  * Assumptions:
- *   Called from user logic with the network locked.
+ *   Called from user logic.  The network may or may not be locked.
  *
  ****************************************************************************/
 
 FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
 {
   FAR struct udp_wrbuffer_s *wrb;
+  irqstate_t flags;
 
   /* We need to allocate two things:  (1) A write buffer structure and (2)
    * at least one I/O buffer to start the chain.
@@ -138,7 +140,10 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
    * for us in the free list.
    */
 
+  flags = enter_critical_section();
   wrb = (FAR struct udp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
+  leave_critical_section(flags);
+
   DEBUGASSERT(wrb);
   memset(wrb, 0, sizeof(struct udp_wrbuffer_s));
 
@@ -169,13 +174,14 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
  *   timeout   - The relative time to wait until a timeout is declared.
  *
  * Assumptions:
- *   Called from user logic with the network locked.
+ *   Called from user logic.  The network may or may not be locked.
  *
  ****************************************************************************/
 
 FAR struct udp_wrbuffer_s *udp_wrbuffer_timedalloc(unsigned int timeout)
 {
   FAR struct udp_wrbuffer_s *wrb;
+  irqstate_t flags;
   int ret;
 
   /* We need to allocate two things:  (1) A write buffer structure and (2)
@@ -196,7 +202,10 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_timedalloc(unsigned int timeout)
    * for us in the free list.
    */
 
+  flags = enter_critical_section();
   wrb = (FAR struct udp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
+  leave_critical_section(flags);
+
   DEBUGASSERT(wrb);
   memset(wrb, 0, sizeof(struct udp_wrbuffer_s));
 
@@ -232,14 +241,15 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_timedalloc(unsigned int timeout)
  *   None
  *
  * Assumptions:
- *   Called from user logic with the network locked. Will return if no buffer
- *   is available.
+ *   Called from user logic.  The network may or may not be locked.  Will
+ *   return if no buffer is available.
  *
  ****************************************************************************/
 
 FAR struct udp_wrbuffer_s *udp_wrbuffer_tryalloc(void)
 {
   FAR struct udp_wrbuffer_s *wrb;
+  irqstate_t flags;
 
   /* We need to allocate two things:  (1) A write buffer structure and (2)
    * at least one I/O buffer to start the chain.
@@ -258,7 +268,10 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_tryalloc(void)
    * for us in the free list.
    */
 
+  flags = enter_critical_section();
   wrb = (FAR struct udp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
+  leave_critical_section(flags);
+
   DEBUGASSERT(wrb);
   memset(wrb, 0, sizeof(struct udp_wrbuffer_s));
 
@@ -284,12 +297,15 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_tryalloc(void)
  *   buffered data.
  *
  * Assumptions:
- *   This function must be called with the network locked.
+ *   The free list is protected by a critical section, so this may be called
+ *   with or without the network locked.
  *
  ****************************************************************************/
 
 void udp_wrbuffer_release(FAR struct udp_wrbuffer_s *wrb)
 {
+  irqstate_t flags;
+
   DEBUGASSERT(wrb);
 
   /* To avoid deadlocks, we must following this ordering:  Release the I/O
@@ -303,7 +319,10 @@ void udp_wrbuffer_release(FAR struct udp_wrbuffer_s *wrb)
 
   /* Then free the write buffer structure */
 
+  flags = enter_critical_section();
   sq_addlast(&wrb->wb_node, &g_wrbuffer.freebuffers);
+  leave_critical_section(flags);
+
   nxsem_post(&g_wrbuffer.sem);
 }
 
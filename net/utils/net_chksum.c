@@ -25,8 +25,189 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/mm/iob.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_swap16
+ ****************************************************************************/
+
+static inline uint16_t chksum_swap16(uint16_t value)
+{
+  return (uint16_t)((value << 8) | (value >> 8));
+}
+
+/****************************************************************************
+ * Name: chksum_add
+ *
+ * Description:
+ *   Add two 16-bit one's complement sums.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_add(uint16_t sum1, uint16_t sum2)
+{
+  uint32_t sum = (uint32_t)sum1 + sum2;
+
+  return (uint16_t)((sum & 0xffff) + (sum >> 16));
+}
+
+/****************************************************************************
+ * Name: chksum_block
+ *
+ * Description:
+ *   Sum the len bytes at src 32 bits at a time into a 64-bit accumulator,
+ *   which cannot overflow for any len, and fold the result to 16 bits at
+ *   the end.  If dest is not NULL, the data is copied there at the same
+ *   time; dest must then have the same alignment as src modulo 4.
+ *
+ *   The words are loaded in host byte order.  As the one's complement sum
+ *   commutes with swapping the bytes of the words, the folded sum only has
+ *   to be swapped once to get the sum of the big endian words that chksum()
+ *   returns.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_block(FAR uint8_t *dest,
+                                    FAR const uint8_t *src, uint16_t len)
+{
+  uint64_t acc = 0;
+  uint32_t sum;
+  bool odd = false;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  /* Start the word accesses at an even address.  The bytes that follow the
+   * first one are then paired the other way around: sum that byte as the
+   * second byte of a word and swap the result at the end.
+   */
+
+  if (((uintptr_t)src & 1) != 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc = *src;
+#else
+      acc = (uint32_t)*src << 8;
+#endif
+      if (dest != NULL)
+        {
+          *dest++ = *src;
+        }
+
+      odd = true;
+      src++;
+      len--;
+    }
+
+  if (((uintptr_t)src & 2) != 0 && len >= 2)
+    {
+      acc += *(FAR const uint16_t *)src;
+      if (dest != NULL)
+        {
+          *(FAR uint16_t *)dest = *(FAR const uint16_t *)src;
+          dest += 2;
+        }
+
+      src += 2;
+      len -= 2;
+    }
+
+  /* src is now 32-bit aligned */
+
+  while (len >= 16)
+    {
+      FAR const uint32_t *s = (FAR const uint32_t *)src;
+      uint32_t w0 = s[0];
+      uint32_t w1 = s[1];
+      uint32_t w2 = s[2];
+      uint32_t w3 = s[3];
+
+      acc += (uint64_t)w0 + w1 + w2 + w3;
+      if (dest != NULL)
+        {
+          FAR uint32_t *d = (FAR uint32_t *)dest;
+
+          d[0]  = w0;
+          d[1]  = w1;
+          d[2]  = w2;
+          d[3]  = w3;
+          dest += 16;
+        }
+
+      src += 16;
+      len -= 16;
+    }
+
+  while (len >= 4)
+    {
+      uint32_t w = *(FAR const uint32_t *)src;
+
+      acc += w;
+      if (dest != NULL)
+        {
+          *(FAR uint32_t *)dest = w;
+          dest += 4;
+        }
+
+      src += 4;
+      len -= 4;
+    }
+
+  if (len >= 2)
+    {
+      acc += *(FAR const uint16_t *)src;
+      if (dest != NULL)
+        {
+          *(FAR uint16_t *)dest = *(FAR const uint16_t *)src;
+          dest += 2;
+        }
+
+      src += 2;
+      len -= 2;
+    }
+
+  if (len > 0)
+    {
+      /* The last byte is the first byte of a word padded with zero */
+
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint32_t)*src << 8;
+#else
+      acc += *src;
+#endif
+      if (dest != NULL)
+        {
+          *dest = *src;
+        }
+    }
+
+  /* Fold the accumulator to 16 bits */
+
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  sum = (uint32_t)acc;
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+
+#ifdef CONFIG_ENDIAN_BIG
+  return odd ? chksum_swap16(sum) : sum;
+#else
+  return odd ? sum : chksum_swap16(sum);
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -53,42 +234,128 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  /* Return sum in host byte order. */
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  return chksum_add(sum, chksum_block(NULL, data, len));
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
 
-  while (dataptr < last_byte)
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy len bytes from src to dest and add them to the raw checksum sum,
+ *   reading the data only once.
+ *
+ * Input Parameters:
+ *   sum  - The partial checksum as returned by chksum()
+ *   dest - Where to copy the data
+ *   src  - The data to copy and to include in the checksum
+ *   len  - Length of the data
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len)
+{
+  /* The words cannot be copied as they are loaded if the buffers are not
+   * aligned alike.
+   */
+
+  if ((((uintptr_t)dest ^ (uintptr_t)src) & 3) != 0)
     {
-      /* At least two more bytes */
+      memcpy(dest, src, len);
+      return chksum(sum, dest, len);
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  return chksum_add(sum, chksum_block(dest, src, len));
+}
+
+/****************************************************************************
+ * Name: chksum_iob_copyout
+ *
+ * Description:
+ *   This is chksum_copy() with the source data in an I/O buffer chain:
+ *   copy len bytes starting at offset in the chain to dest, as
+ *   iob_copyout() does, and add them to the raw checksum sum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
 
-      dataptr += 2;
+#ifdef CONFIG_MM_IOB
+uint16_t chksum_iob_copyout(uint16_t sum, FAR uint8_t *dest,
+                            FAR const struct iob_s *iob, unsigned int len,
+                            unsigned int offset)
+{
+  unsigned int ncopy;
+  unsigned int done = 0;
+  uint16_t part;
+
+  /* Skip to the I/O buffer containing the offset */
+
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
     }
 
-  if (dataptr == last_byte)
+  while (iob != NULL && done < len)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
+      ncopy = iob->io_len - offset;
+      if (ncopy > len - done)
         {
-          sum++; /* carry */
+          ncopy = len - done;
         }
-    }
 
-  /* Return sum in host byte order. */
+      part = chksum_copy(0, &dest[done],
+                         &iob->io_data[iob->io_offset + offset], ncopy);
+
+      /* A part that starts at an odd offset is summed with its bytes paired
+       * the other way around.
+       */
+
+      if ((done & 1) != 0)
+        {
+          part = chksum_swap16(part);
+        }
+
+      sum    = chksum_add(sum, part);
+      done  += ncopy;
+      iob    = iob->io_flink;
+      offset = 0;
+    }
 
   return sum;
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* CONFIG_MM_IOB */
+
+/****************************************************************************
+ * Name: chksum_adjust
+ *
+ * Description:
+ *   Update an Internet checksum after a 16-bit word of the data it covers
+ *   has been changed from oldval to newval, without summing the data again
+ *   (RFC 1624, equation 3).  A 32-bit field, such as an address rewritten
+ *   by NAT, is updated one half at a time.
+ *
+ *   chksum, oldval and newval must all be in the same byte order, as they
+ *   are in the packet.
+ *
+ * Returned Value:
+ *   The new checksum.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_adjust(uint16_t chksum, uint16_t oldval, uint16_t newval)
+{
+  return (uint16_t)~chksum_add(chksum_add((uint16_t)~chksum,
+                                          (uint16_t)~oldval), newval);
+}
 
 /****************************************************************************
  * Name: net_chksum
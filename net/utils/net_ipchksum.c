@@ -40,6 +40,45 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: upperlayer_payload_chksum
+ *
+ * Description:
+ *   Sum the len bytes of the upper layer header and payload at data.  If
+ *   this is an outgoing packet whose application data was summed while it
+ *   was copied into d_appdata, only the header needs to be read.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+static uint16_t upperlayer_payload_chksum(FAR struct net_driver_s *dev,
+                                          uint16_t sum,
+                                          FAR const uint8_t *data,
+                                          uint16_t len)
+{
+  uint16_t hdrlen;
+  uint32_t total;
+
+  if (dev->d_sndsum != 0 && dev->d_sndlen > 0 &&
+      dev->d_appdata >= data &&
+      dev->d_appdata + dev->d_sndlen == data + len)
+    {
+      hdrlen = dev->d_appdata - data;
+      if ((hdrlen & 1) == 0)
+        {
+          total = (uint32_t)chksum(sum, data, hdrlen) + dev->d_sndsum;
+          return (uint16_t)((total & 0xffff) + (total >> 16));
+        }
+    }
+
+  return chksum(sum, data, len);
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -100,7 +139,9 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)], upperlen);
+  sum = upperlayer_payload_chksum(dev, sum,
+                                  &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)],
+                                  upperlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -167,7 +208,9 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+  sum = upperlayer_payload_chksum(dev, sum,
+                                  &dev->d_buf[NET_LL_HDRLEN(dev) + iplen],
+                                  upperlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
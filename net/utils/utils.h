@@ -60,6 +60,7 @@ extern "C"
 
 struct net_driver_s;      /* Forward reference */
 struct timeval;           /* Forward reference */
+struct iob_s;             /* Forward reference */
 
 /****************************************************************************
  * Name: net_breaklock
@@ -211,6 +212,61 @@ void net_ipv6_pref2mask(uint8_t preflen, net_ipv6addr_t mask);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy len bytes from src to dest and add them to the raw checksum sum,
+ *   reading the data only once.
+ *
+ * Input Parameters:
+ *   sum  - The partial checksum as returned by chksum()
+ *   dest - Where to copy the data
+ *   src  - The data to copy and to include in the checksum
+ *   len  - Length of the data
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_copy(uint16_t sum, FAR uint8_t *dest,
+                     FAR const uint8_t *src, uint16_t len);
+
+/****************************************************************************
+ * Name: chksum_iob_copyout
+ *
+ * Description:
+ *   This is chksum_copy() with the source data in an I/O buffer chain:
+ *   copy len bytes starting at offset in the chain to dest, as
+ *   iob_copyout() does, and add them to the raw checksum sum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+uint16_t chksum_iob_copyout(uint16_t sum, FAR uint8_t *dest,
+                            FAR const struct iob_s *iob, unsigned int len,
+                            unsigned int offset);
+#endif
+
+/****************************************************************************
+ * Name: chksum_adjust
+ *
+ * Description:
+ *   Update an Internet checksum after a 16-bit word of the data it covers
+ *   has been changed from oldval to newval (RFC 1624).  chksum, oldval and
+ *   newval must all be in the same byte order, as they are in the packet.
+ *
+ * Returned Value:
+ *   The new checksum.
+ *
+ ****************************************************************************/
+
+uint16_t chksum_adjust(uint16_t chksum, uint16_t oldval, uint16_t newval);
+
 /****************************************************************************
  * Name: net_chksum
  *
@@ -120,6 +120,17 @@ volatile dq_queue_t g_readytorun;
 volatile dq_queue_t g_assignedtasks[CONFIG_SMP_NCPUS];
 #endif
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* These index the g_readytorun and g_assignedtasks[] lists by priority so
+ * that a TCB can be inserted without searching the list.
+ */
+
+struct sched_rqindex_s g_readytorun_index;
+#ifdef CONFIG_SMP
+struct sched_rqindex_s g_assignedtasks_index[CONFIG_SMP_NCPUS];
+#endif
+#endif
+
 /* g_running_tasks[] holds a references to the running task for each cpu.
  * It is valid only when up_interrupt_context() returns true.
  */
@@ -434,6 +445,7 @@ void nx_start(void)
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[i], tasklist);
+      nxsched_rqindex_add(&g_idletcb[i].cmn, tasklist);
 
       /* Mark the idle task as the running task */
 
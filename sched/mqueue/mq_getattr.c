@@ -111,6 +111,7 @@ int mq_getattr(mqd_t mqdes, struct mq_attr *mq_stat)
     }
 
   ret = file_mq_getattr(filep, mq_stat);
+  fs_putfilep(filep);
   if (ret < 0)
     {
       set_errno(-ret);
@@ -118,7 +118,7 @@ int mq_notify(mqd_t mqdes, FAR const struct sigevent *notification)
       /* No.. return EBADF */
 
       errval = EBADF;
-      goto errout_without_lock;
+      goto errout_with_filep;
     }
 
   /* Get a pointer to the message queue */
@@ -182,11 +182,15 @@ int mq_notify(mqd_t mqdes, FAR const struct sigevent *notification)
     }
 
   leave_critical_section(flags);
+  fs_putfilep(filep);
   return OK;
 
 errout:
   leave_critical_section(flags);
 
+errout_with_filep:
+  fs_putfilep(filep);
+
 errout_without_lock:
   set_errno(errval);
   return ERROR;
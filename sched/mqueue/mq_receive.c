@@ -151,7 +151,7 @@ ssize_t nxmq_receive(mqd_t mqdes, FAR char *msg, size_t msglen,
                      FAR unsigned int *prio)
 {
   FAR struct file *filep;
-  int ret;
+  ssize_t ret;
 
   ret = fs_getfilep(mqdes, &filep);
   if (ret < 0)
@@ -159,7 +159,9 @@ ssize_t nxmq_receive(mqd_t mqdes, FAR char *msg, size_t msglen,
       return ret;
     }
 
-  return file_mq_receive(filep, msg, msglen, prio);
+  ret = file_mq_receive(filep, msg, msglen, prio);
+  fs_putfilep(filep);
+  return ret;
 }
 
 /****************************************************************************
@@ -123,6 +123,7 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mq_stat,
     }
 
   ret = file_mq_setattr(filep, mq_stat, oldstat);
+  fs_putfilep(filep);
   if (ret < 0)
     {
       set_errno(-ret);
@@ -86,6 +86,10 @@
 #  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
 #endif
 
+/* Number of words in the priority bitmap of a ready-to-run list index */
+
+#define RQINDEX_NWORDS           ((SCHED_PRIORITY_MAX >> 5) + 1)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -100,6 +104,20 @@ struct tasklist_s
   uint8_t attr;                   /* List attribute flags */
 };
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* This structure indexes a prioritized ready-to-run list by priority.  The
+ * TCBs of each priority form a contiguous run in the list; 'last' holds
+ * the tail of each run and 'map' has a bit set for each non-empty run, so
+ * the insertion point of a new TCB is found without walking the list.
+ */
+
+struct sched_rqindex_s
+{
+  uint32_t map[RQINDEX_NWORDS];                   /* Non-empty priorities */
+  FAR struct tcb_s *last[SCHED_PRIORITY_MAX + 1]; /* Last TCB per priority */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -157,6 +175,15 @@ extern volatile dq_queue_t g_readytorun;
 extern volatile dq_queue_t g_assignedtasks[CONFIG_SMP_NCPUS];
 #endif
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* Priority indexes of the g_readytorun and g_assignedtasks[] lists */
+
+extern struct sched_rqindex_s g_readytorun_index;
+#ifdef CONFIG_SMP
+extern struct sched_rqindex_s g_assignedtasks_index[CONFIG_SMP_NCPUS];
+#endif
+#endif
+
 /* g_running_tasks[] holds a references to the running task for each cpu.
  * It is valid only when up_interrupt_context() returns true.
  */
@@ -322,6 +349,20 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
 void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
                                uint8_t task_state);
 bool nxsched_merge_pending(void);
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+FAR struct sched_rqindex_s *nxsched_rqindex(FAR dq_queue_t *list);
+FAR struct tcb_s *nxsched_rqindex_find(FAR struct sched_rqindex_s *index,
+                                       uint8_t sched_priority);
+void nxsched_rqindex_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_rqindex_rem(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void nxsched_rqindex_reset(FAR dq_queue_t *list);
+#else
+#  define nxsched_rqindex_add(tcb,list)
+#  define nxsched_rqindex_rem(tcb,list)
+#  define nxsched_rqindex_reset(list)
+#endif
+
 void nxsched_add_blocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
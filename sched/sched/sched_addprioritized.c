@@ -65,6 +65,9 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 {
   FAR struct tcb_s *next;
   FAR struct tcb_s *prev;
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  FAR struct sched_rqindex_s *index;
+#endif
   uint8_t sched_priority = tcb->sched_priority;
   bool ret = false;
 
@@ -72,13 +75,28 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
-  /* Search the list to find the location to insert the new Tcb.
-   * Each is list is maintained in descending sched_priority order.
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  /* The ready-to-run lists are indexed by priority.  The new TCB goes just
+   * after the last TCB of the same or the next higher priority.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
-       next = next->flink);
+  index = nxsched_rqindex(list);
+  if (index != NULL)
+    {
+      prev = nxsched_rqindex_find(index, sched_priority);
+      next = prev != NULL ? prev->flink : (FAR struct tcb_s *)list->head;
+    }
+  else
+#endif
+    {
+      /* Search the list to find the location to insert the new Tcb.
+       * Each is list is maintained in descending sched_priority order.
+       */
+
+      for (next = (FAR struct tcb_s *)list->head;
+           (next && sched_priority <= next->sched_priority);
+           next = next->flink);
+    }
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
@@ -136,5 +154,6 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+  nxsched_rqindex_add(tcb, list);
   return ret;
 }
@@ -76,6 +76,7 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
    */
 
   dq_move(list1, &clone);
+  nxsched_rqindex_reset(list1);
 
   /* Get the TCB at the head of list1 */
 
@@ -99,6 +100,22 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       tmp->task_state = task_state;
     }
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  /* If list2 is indexed by priority, each TCB can be inserted directly at
+   * its position without walking list2.
+   */
+
+  if (nxsched_rqindex(list2) != NULL)
+    {
+      while ((tmp = (FAR struct tcb_s *)dq_remfirst(&clone)) != NULL)
+        {
+          nxsched_add_prioritized(tmp, list2);
+        }
+
+      goto out;
+    }
+#endif
+
   /* Get the head of list2 */
 
   tcb2 = (FAR struct tcb_s *)dq_peek(list2);
@@ -86,6 +86,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  nxsched_rqindex_rem(rtcb, (FAR dq_queue_t *)&g_readytorun);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -177,6 +178,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      nxsched_rqindex_rem(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -214,8 +216,10 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
+          nxsched_rqindex_rem(rtrtcb, (FAR dq_queue_t *)&g_readytorun);
           dq_rem((FAR dq_entry_t *)rtrtcb, (FAR dq_queue_t *)&g_readytorun);
           dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
+          nxsched_rqindex_add(rtrtcb, tasklist);
 
           rtrtcb->cpu = cpu;
           nxttcb = rtrtcb;
@@ -268,6 +272,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      nxsched_rqindex_rem(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
@@ -0,0 +1,173 @@
+/****************************************************************************
+ * sched/sched/sched_rqindex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rqindex
+ *
+ * Description:
+ *   Return the priority index of a task list, or NULL if the list is not
+ *   one of the indexed ready-to-run lists.
+ *
+ ****************************************************************************/
+
+FAR struct sched_rqindex_s *nxsched_rqindex(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorun_index;
+    }
+
+#ifdef CONFIG_SMP
+  if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+      list < (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedtasks_index[list -
+                                    (FAR dq_queue_t *)&g_assignedtasks[0]];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_rqindex_find
+ *
+ * Description:
+ *   Return the last TCB whose priority is greater than or equal to
+ *   sched_priority.  A new TCB of that priority goes right after it, or at
+ *   the head of the list if NULL is returned.  The lookup scans at most
+ *   RQINDEX_NWORDS bitmap words, whatever the length of the list.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_rqindex_find(FAR struct sched_rqindex_s *index,
+                                       uint8_t sched_priority)
+{
+  int word = sched_priority >> 5;
+  uint32_t map;
+
+  map = index->map[word] & (~(uint32_t)0 << (sched_priority & 31));
+  while (map == 0)
+    {
+      if (++word >= RQINDEX_NWORDS)
+        {
+          return NULL;
+        }
+
+      map = index->map[word];
+    }
+
+  return index->last[(word << 5) + ffs(map) - 1];
+}
+
+/****************************************************************************
+ * Name: nxsched_rqindex_add
+ *
+ * Description:
+ *   Update the index of a list after the TCB has been linked into it.  The
+ *   TCB becomes the last of its priority unless it was put in front of
+ *   another TCB of the same priority.
+ *
+ ****************************************************************************/
+
+void nxsched_rqindex_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct sched_rqindex_s *index = nxsched_rqindex(list);
+  uint8_t sched_priority = tcb->sched_priority;
+
+  if (index != NULL &&
+      (tcb->flink == NULL || tcb->flink->sched_priority < sched_priority))
+    {
+      index->last[sched_priority] = tcb;
+      index->map[sched_priority >> 5] |=
+        (uint32_t)1 << (sched_priority & 31);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rqindex_rem
+ *
+ * Description:
+ *   Update the index of a list before the TCB is unlinked from it.  The
+ *   priority of the TCB must not have changed since it was added.
+ *
+ ****************************************************************************/
+
+void nxsched_rqindex_rem(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct sched_rqindex_s *index = nxsched_rqindex(list);
+  uint8_t sched_priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  if (index != NULL && index->last[sched_priority] == tcb)
+    {
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == sched_priority)
+        {
+          index->last[sched_priority] = prev;
+        }
+      else
+        {
+          index->last[sched_priority] = NULL;
+          index->map[sched_priority >> 5] &=
+            ~((uint32_t)1 << (sched_priority & 31));
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_rqindex_reset
+ *
+ * Description:
+ *   Clear the index of a list that has just been emptied.
+ *
+ ****************************************************************************/
+
+void nxsched_rqindex_reset(FAR dq_queue_t *list)
+{
+  FAR struct sched_rqindex_s *index = nxsched_rqindex(list);
+
+  if (index != NULL)
+    {
+      memset(index, 0, sizeof(struct sched_rqindex_s));
+    }
+}
+
+#endif /* CONFIG_SCHED_READYTORUN_BITMAP */
@@ -149,9 +149,26 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+      /* The task stays at the head of its list, but it must move to its
+       * new priority in the list index.
+       */
+
+#ifdef CONFIG_SMP
+      FAR dq_queue_t *tasklist =
+        (FAR dq_queue_t *)&g_assignedtasks[tcb->cpu];
+#else
+      FAR dq_queue_t *tasklist = (FAR dq_queue_t *)&g_readytorun;
+#endif
+
+      nxsched_rqindex_rem(tcb, tasklist);
+      tcb->sched_priority = (uint8_t)sched_priority;
+      nxsched_rqindex_add(tcb, tasklist);
+#else
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+#endif
     }
 }
 
@@ -74,7 +74,7 @@ int nxsem_destroy (FAR sem_t *sem)
 
       if (sem->semcount >= 0)
         {
-          sem->semcount = 1;
+          nxsem_count_set(sem, 1);
         }
 
       /* Release holders of the semaphore */
@@ -71,8 +71,18 @@ int nxsem_post(FAR sem_t *sem)
 {
   FAR struct tcb_s *stcb = NULL;
   irqstate_t flags;
+  int16_t semcount;
   int ret = -EINVAL;
 
+  /* Give the count back without the critical section if nobody is waiting
+   * for it and no holder has to be released.
+   */
+
+  if (sem != NULL && NXSEM_FASTPATH(sem) && nxsem_count_give(sem))
+    {
+      return OK;
+    }
+
   /* Make sure we were supplied with a valid semaphore. */
 
   if (sem != NULL)
@@ -110,7 +120,7 @@ int nxsem_post(FAR sem_t *sem)
        */
 
       nxsem_release_holder(sem);
-      sem->semcount++;
+      semcount = nxsem_count_inc(sem);
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
       /* Don't let any unblocked tasks run until we complete any priority
@@ -127,7 +137,7 @@ int nxsem_post(FAR sem_t *sem)
        * there must be some task waiting for the semaphore.
        */
 
-      if (sem->semcount <= 0)
+      if (semcount <= 0)
         {
           /* Check if there are any tasks in the waiting for semaphore
            * task list that are waiting for this semaphore. This is a
@@ -97,7 +97,7 @@ void nxsem_recover(FAR struct tcb_s *tcb)
        * place.
        */
 
-      sem->semcount++;
+      nxsem_count_inc(sem);
 
       /* Clear the semaphore to assure that it is not reused.  But leave the
        * state as TSTATE_WAIT_SEM.  This is necessary because this is a
@@ -98,7 +98,7 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
 
   if (sem->semcount >= 0)
     {
-      sem->semcount = count;
+      nxsem_count_set(sem, count);
     }
 
   /* Allow any pending context switches to occur now */
@@ -76,7 +76,13 @@ int nxsem_trywait(FAR sem_t *sem)
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask() ||
               up_interrupt_context());
 
-  if (sem != NULL)
+  if (sem != NULL && NXSEM_FASTPATH(sem))
+    {
+      /* No holder has to be recorded, the count is all there is to take */
+
+      ret = nxsem_count_take(sem) ? OK : -EAGAIN;
+    }
+  else if (sem != NULL)
     {
       /* The following operations must be performed with interrupts disabled
        * because sem_post() may be called from an interrupt handler.
@@ -86,11 +92,10 @@ int nxsem_trywait(FAR sem_t *sem)
 
       /* If the semaphore is available, give it to the requesting task */
 
-      if (sem->semcount > 0)
+      if (nxsem_count_take(sem))
         {
-          /* It is, let the task take the semaphore */
+          /* It was, let the task take the semaphore */
 
-          sem->semcount--;
           nxsem_add_holder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -79,6 +79,15 @@ int nxsem_wait(FAR sem_t *sem)
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask());
 
+  /* Take an available count without the critical section if no holder has
+   * to be recorded.
+   */
+
+  if (sem != NULL && NXSEM_FASTPATH(sem) && nxsem_count_take(sem))
+    {
+      return OK;
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -90,13 +99,12 @@ int nxsem_wait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* Check if the lock is available */
+      /* Take a count and check if the lock was available */
 
-      if (sem->semcount > 0)
+      if (nxsem_count_dec(sem) > 0)
         {
-          /* It is, let the task take the semaphore. */
+          /* It was, let the task take the semaphore. */
 
-          sem->semcount--;
           nxsem_add_holder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -114,10 +122,6 @@ int nxsem_wait(FAR sem_t *sem)
 
           DEBUGASSERT(rtcb->waitsem == NULL);
 
-          /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-          sem->semcount--;
-
           /* Save the waited on semaphore in the TCB */
 
           rtcb->waitsem = sem;
@@ -32,8 +32,98 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <queue.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* True if the semaphore may be taken and released without the critical
+ * section.  The holders of a semaphore with priority inheritance must be
+ * tracked, so it always takes the slow path.
+ */
+
+#if !defined(CONFIG_SEM_FASTPATH)
+#  define NXSEM_FASTPATH(s) false
+#elif defined(CONFIG_PRIORITY_INHERITANCE)
+#  define NXSEM_FASTPATH(s) (((s)->flags & PRIOINHERIT_FLAGS_DISABLE) != 0)
+#else
+#  define NXSEM_FASTPATH(s) true
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_count_take
+ *
+ * Description:
+ *   Decrement the semaphore count if it is positive.
+ *
+ * Returned Value:
+ *   True if a count was taken.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_count_take(FAR sem_t *sem)
+{
+#ifdef CONFIG_SEM_FASTPATH
+  int16_t count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+
+  while (count > 0)
+    {
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, count - 1,
+                                      false, __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+#else
+  if (sem->semcount > 0)
+    {
+      sem->semcount--;
+      return true;
+    }
+#endif
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_count_give
+ *
+ * Description:
+ *   Increment the semaphore count if no thread is waiting for it and it is
+ *   below SEM_VALUE_MAX.
+ *
+ * Returned Value:
+ *   True if the count was given back.  False if a waiter must be woken up
+ *   or the count would overflow; the slow path handles both cases.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_count_give(FAR sem_t *sem)
+{
+#ifdef CONFIG_SEM_FASTPATH
+  int16_t count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+
+  while (count >= 0 && count < SEM_VALUE_MAX)
+    {
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, count + 1,
+                                      false, __ATOMIC_RELEASE,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+#endif
+
+  return false;
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -138,6 +138,7 @@ int nxtask_restart(pid_t pid)
   tasklist = TLIST_HEAD(tcb->cmn.task_state);
 #endif
 
+  nxsched_rqindex_rem((FAR struct tcb_s *)tcb, tasklist);
   dq_rem((FAR dq_entry_t *)tcb, tasklist);
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
 
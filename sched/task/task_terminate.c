@@ -142,6 +142,7 @@ int nxtask_terminate(pid_t pid, bool nonblocking)
 
   /* Remove the task from the task list */
 
+  nxsched_rqindex_rem(dtcb, tasklist);
   dq_rem((FAR dq_entry_t *)dtcb, tasklist);
 
   /* At this point, the TCB should no longer be accessible to the system */
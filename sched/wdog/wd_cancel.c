@@ -57,8 +57,10 @@
 
 int wd_cancel(FAR struct wdog_s *wdog)
 {
+#ifndef CONFIG_WDOG_TIMER_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -74,6 +76,29 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      /* Check if this watchdog is due at the next timer event before it is
+       * unlinked.  Removing any other one can't move that event later.
+       */
+
+      bool first = (sclock_t)(wdog->expired - g_wdtickbase) <=
+                   (sclock_t)wd_wheel_next();
+
+      /* The watchdog knows the link that points to it, so it can be
+       * removed from its wheel slot without any search.
+       */
+
+      wd_wheel_del(wdog);
+
+      if (first)
+        {
+          /* Reassess the interval timer that will generate the next
+           * interval event.
+           */
+
+          nxsched_reassess_timer();
+        }
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -123,6 +148,7 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
           nxsched_reassess_timer();
         }
+#endif
 
       /* Mark the watchdog inactive */
 
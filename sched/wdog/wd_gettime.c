@@ -59,6 +59,14 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
   flags = enter_critical_section();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      /* The expiration time is kept in the watchdog itself */
+
+      sclock_t delay = wdog->expired - g_wdtickbase - wd_elapse();
+
+      leave_critical_section(flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -78,6 +86,7 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
               return delay;
             }
         }
+#endif
     }
 
   leave_critical_section(flags);
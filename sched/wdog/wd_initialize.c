@@ -37,13 +37,15 @@
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 sq_queue_t g_wdactivelist;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_WDOG_TIMER_WHEEL)
 clock_t g_wdtickbase;
 #endif
 
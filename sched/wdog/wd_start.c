@@ -98,6 +98,22 @@ static inline void wd_expiration(void)
   FAR struct wdog_s *wdog;
   wdentry_t func;
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* Run all of the watchdogs that the wheel has collected as expired */
+
+  while ((wdog = wd_wheel_expired()) != NULL)
+    {
+      /* Indicate that the watchdog is no longer active. */
+
+      func = wdog->func;
+      wdog->func = NULL;
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(wdog->picbase);
+      CALL_FUNC(func, wdog->arg);
+    }
+#else
   /* Process the watchdog at the head of the list as well as any
    * other watchdogs that became ready to run at this time
    */
@@ -128,6 +144,7 @@ static inline void wd_expiration(void)
       up_setpicbase(wdog->picbase);
       CALL_FUNC(func, wdog->arg);
     }
+#endif
 }
 
 /****************************************************************************
@@ -173,10 +190,12 @@ static inline void wd_expiration(void)
 int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
              wdentry_t wdentry, wdparm_t arg)
 {
+#ifndef CONFIG_WDOG_TIMER_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   sclock_t now;
+#endif
   irqstate_t flags;
 
   /* Verify the wdog and setup parameters */
@@ -238,6 +257,23 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   nxsched_cancel_timer();
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* With a timer wheel the watchdog simply goes into the slot for its
+   * expiration time.
+   */
+
+#ifdef CONFIG_SCHED_TICKLESS
+  if (wd_wheel_empty())
+    {
+      /* Update clock tickbase */
+
+      g_wdtickbase = clock_systime_ticks();
+    }
+#endif
+
+  wdog->expired = g_wdtickbase + delay;
+  wd_wheel_add(wdog);
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -331,6 +367,7 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   /* Put the lag into the watchdog structure and mark it as active. */
 
   wdog->lag = delay;
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Resume the interval timer that will generate the next interval event.
@@ -371,7 +408,36 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
  *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_WDOG_TIMER_WHEEL) && defined(CONFIG_SCHED_TICKLESS)
+unsigned int wd_timer(int ticks, bool noswitches)
+{
+  /* Move the wheel over the interval that just expired */
+
+  if (ticks > 0)
+    {
+      wd_wheel_advance(ticks);
+    }
+
+  /* Run the expired watchdogs unless context switches are not allowed */
+
+  if (!noswitches)
+    {
+      wd_expiration();
+    }
+
+  /* Return the delay until the wheel has more work to do */
+
+  return wd_wheel_next();
+}
+
+#elif defined(CONFIG_WDOG_TIMER_WHEEL)
+void wd_timer(void)
+{
+  wd_wheel_advance(1);
+  wd_expiration();
+}
+
+#elif defined(CONFIG_SCHED_TICKLESS)
 unsigned int wd_timer(int ticks, bool noswitches)
 {
   FAR struct wdog_s *wdog;
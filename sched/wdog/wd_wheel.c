@@ -0,0 +1,403 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The wheel has WDOG_WHEEL_LEVELS levels of WDOG_WHEEL_SIZE slots each.
+ * A slot at level 0 holds the watchdogs expiring at one tick, a slot at
+ * level n spans WDOG_WHEEL_SIZE^n ticks and is cascaded into the lower
+ * levels when the wheel time reaches it.  Delays beyond WDOG_WHEEL_RANGE
+ * are parked in the last level and re-inserted when they are cascaded.
+ */
+
+#define WDOG_WHEEL_BITS       6
+#define WDOG_WHEEL_SIZE       (1 << WDOG_WHEEL_BITS)
+#define WDOG_WHEEL_MASK       (WDOG_WHEEL_SIZE - 1)
+#define WDOG_WHEEL_LEVELS     4
+#define WDOG_WHEEL_RANGE      ((clock_t)1 << (WDOG_WHEEL_BITS * \
+                                              WDOG_WHEEL_LEVELS))
+
+#define WDOG_WHEEL_SHIFT(l)   (WDOG_WHEEL_BITS * (l))
+#define WDOG_WHEEL_SLOT(t, l) (((t) >> WDOG_WHEEL_SHIFT(l)) & WDOG_WHEEL_MASK)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The slot lists and a bitmap of the non-empty slots of each level */
+
+static FAR struct wdog_s *g_wdwheel[WDOG_WHEEL_LEVELS][WDOG_WHEEL_SIZE];
+static uint64_t g_wdslotmap[WDOG_WHEEL_LEVELS];
+
+/* Watchdogs whose time has come but whose function has not run yet */
+
+static FAR struct wdog_s *g_wdexpired;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_link
+ *
+ * Description:
+ *   Add a watchdog to the head of a list.
+ *
+ ****************************************************************************/
+
+static inline void wd_link(FAR struct wdog_s **head, FAR struct wdog_s *wdog)
+{
+  wdog->next  = *head;
+  wdog->pprev = head;
+  if (wdog->next != NULL)
+    {
+      wdog->next->pprev = &wdog->next;
+    }
+
+  *head = wdog;
+}
+
+/****************************************************************************
+ * Name: wd_unlink
+ *
+ * Description:
+ *   Remove a watchdog from whatever list it is on.  If that empties a
+ *   wheel slot, the slot bit is cleared as well.
+ *
+ ****************************************************************************/
+
+static void wd_unlink(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s **base = &g_wdwheel[0][0];
+  uintptr_t ndx;
+
+  *wdog->pprev = wdog->next;
+  if (wdog->next != NULL)
+    {
+      wdog->next->pprev = wdog->pprev;
+    }
+  else if (wdog->pprev >= base &&
+           wdog->pprev < base + WDOG_WHEEL_LEVELS * WDOG_WHEEL_SIZE &&
+           *wdog->pprev == NULL)
+    {
+      /* The watchdog was the only entry of a wheel slot */
+
+      ndx = wdog->pprev - base;
+      g_wdslotmap[ndx >> WDOG_WHEEL_BITS] &=
+        ~((uint64_t)1 << (ndx & WDOG_WHEEL_MASK));
+    }
+
+  wdog->next  = NULL;
+  wdog->pprev = NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_ffs
+ *
+ * Description:
+ *   Return the distance from slot 'start' to the first non-empty slot of a
+ *   level, wrapping around the end of the level.  The map must not be
+ *   zero.
+ *
+ ****************************************************************************/
+
+static inline unsigned int wd_wheel_ffs(uint64_t map, unsigned int start)
+{
+  if (start != 0)
+    {
+      map = (map >> start) | (map << (WDOG_WHEEL_SIZE - start));
+    }
+
+  return ffsll((long long)map) - 1;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_nextslot
+ *
+ * Description:
+ *   Return the number of ticks from the wheel time to the next tick that
+ *   has a slot to expire or to cascade, or zero if the wheel is empty.
+ *
+ ****************************************************************************/
+
+static unsigned int wd_wheel_nextslot(void)
+{
+  clock_t base = g_wdtickbase + 1;
+  clock_t period;
+  clock_t start;
+  unsigned int delta;
+  unsigned int ret = 0;
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (g_wdslotmap[level] == 0)
+        {
+          continue;
+        }
+
+      /* Slots of this level are processed on period boundaries, the first
+       * one at or after the next tick.
+       */
+
+      period = (clock_t)1 << WDOG_WHEEL_SHIFT(level);
+      start  = (base + period - 1) & ~(period - 1);
+      delta  = start - g_wdtickbase +
+               wd_wheel_ffs(g_wdslotmap[level],
+                            WDOG_WHEEL_SLOT(start, level)) * period;
+
+      if (ret == 0 || delta < ret)
+        {
+          ret = delta;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Redistribute the watchdogs of a higher level slot into the lower
+ *   levels.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level, int slot)
+{
+  FAR struct wdog_s *wdog = g_wdwheel[level][slot];
+  FAR struct wdog_s *next;
+
+  g_wdwheel[level][slot] = NULL;
+  g_wdslotmap[level] &= ~((uint64_t)1 << slot);
+
+  while (wdog != NULL)
+    {
+      next = wdog->next;
+      wd_wheel_add(wdog);
+      wdog = next;
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_tick
+ *
+ * Description:
+ *   Advance the wheel time by one tick, cascading the higher levels on
+ *   their boundaries and moving the watchdogs expiring at the new time to
+ *   the expired list.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_tick(void)
+{
+  clock_t now = g_wdtickbase + 1;
+  FAR struct wdog_s *wdog;
+  int index = WDOG_WHEEL_SLOT(now, 0);
+  int level;
+
+  for (level = 1; index == 0 && level < WDOG_WHEEL_LEVELS; level++)
+    {
+      index = WDOG_WHEEL_SLOT(now, level);
+      wd_wheel_cascade(level, index);
+    }
+
+  g_wdtickbase = now;
+
+  index = WDOG_WHEEL_SLOT(now, 0);
+  while ((wdog = g_wdwheel[0][index]) != NULL)
+    {
+      wd_unlink(wdog);
+      wd_link(&g_wdexpired, wdog);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Insert a watchdog into the wheel slot for its expiration time.
+ *   Interrupts must be disabled.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+  clock_t base = g_wdtickbase + 1;
+  clock_t expired = wdog->expired;
+  sclock_t delta = expired - base;
+  int level = 0;
+  int slot;
+
+  if (delta < 0)
+    {
+      /* Already due, expire it on the next tick */
+
+      expired = base;
+    }
+  else if ((clock_t)delta >= WDOG_WHEEL_RANGE)
+    {
+      /* Too far ahead, park it at the end of the wheel.  The expiration
+       * time is kept so the watchdog will move down when cascaded.
+       */
+
+      expired = base + WDOG_WHEEL_RANGE - 1;
+    }
+
+  delta = expired - base;
+  while (level < WDOG_WHEEL_LEVELS - 1 &&
+         delta >= ((sclock_t)1 << WDOG_WHEEL_SHIFT(level + 1)))
+    {
+      level++;
+    }
+
+  slot = WDOG_WHEEL_SLOT(expired, level);
+  wd_link(&g_wdwheel[level][slot], wdog);
+  g_wdslotmap[level] |= (uint64_t)1 << slot;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_del
+ *
+ * Description:
+ *   Remove an active watchdog from the wheel or from the expired list.
+ *   Interrupts must be disabled.
+ *
+ ****************************************************************************/
+
+void wd_wheel_del(FAR struct wdog_s *wdog)
+{
+  DEBUGASSERT(wdog->pprev != NULL);
+  wd_unlink(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_empty
+ *
+ * Description:
+ *   Return true if there are no active watchdogs.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_empty(void)
+{
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (g_wdslotmap[level] != 0)
+        {
+          return false;
+        }
+    }
+
+  return g_wdexpired == NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks until wd_timer() has work to do, or zero if
+ *   there are no active watchdogs.  This may be earlier than the first
+ *   expiration if a higher level slot must be cascaded first.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void)
+{
+  return g_wdexpired != NULL ? 1 : wd_wheel_nextslot();
+}
+
+/****************************************************************************
+ * Name: wd_wheel_advance
+ *
+ * Description:
+ *   Advance the wheel time by a number of ticks.  Only the ticks that have
+ *   a slot to process are visited, so a long tickless interval costs no
+ *   more than the watchdogs it expires.  Expired watchdogs are collected
+ *   for wd_wheel_expired().
+ *
+ ****************************************************************************/
+
+void wd_wheel_advance(unsigned int ticks)
+{
+  unsigned int next;
+
+  while (ticks > 0)
+    {
+      next = wd_wheel_nextslot();
+      if (next == 0 || next > ticks)
+        {
+          g_wdtickbase += ticks;
+          break;
+        }
+
+      g_wdtickbase += next - 1;
+      ticks        -= next;
+      wd_wheel_tick();
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return the next expired watchdog, or NULL if there is none.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+  FAR struct wdog_s *wdog = g_wdexpired;
+
+  if (wdog != NULL)
+    {
+      wd_unlink(wdog);
+    }
+
+  return wdog;
+}
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
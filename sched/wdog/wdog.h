@@ -72,13 +72,16 @@ extern "C"
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
+ * With CONFIG_WDOG_TIMER_WHEEL it is also the current time of the wheel.
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_WDOG_TIMER_WHEEL)
 extern clock_t g_wdtickbase;
 #endif
 
@@ -140,6 +143,27 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_add, wd_wheel_del, wd_wheel_empty, wd_wheel_next,
+ *       wd_wheel_advance and wd_wheel_expired
+ *
+ * Description:
+ *   Hierarchical timer wheel operations used in place of the ordered
+ *   g_wdactivelist when CONFIG_WDOG_TIMER_WHEEL is selected.  Start and
+ *   cancel are O(1) and a timer interrupt only visits the slots due at
+ *   the new time.  All of these must be called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+void wd_wheel_add(FAR struct wdog_s *wdog);
+void wd_wheel_del(FAR struct wdog_s *wdog);
+bool wd_wheel_empty(void);
+unsigned int wd_wheel_next(void);
+void wd_wheel_advance(unsigned int ticks);
+FAR struct wdog_s *wd_wheel_expired(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -87,7 +87,20 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
         }
       else
         {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+          int wndx;
+
+          /* The work is on the lane of the CPU that queued it.  sq_rem()
+           * ignores the lanes that do not hold it.
+           */
+
+          for (wndx = 0; wndx < CONFIG_SMP_NCPUS; wndx++)
+            {
+              sq_rem((FAR sq_entry_t *)work, &wqueue->worker[wndx].q);
+            }
+#else
           sq_rem((FAR sq_entry_t *)work, &wqueue->q);
+#endif
         }
 
       work->worker = NULL;
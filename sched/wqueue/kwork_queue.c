@@ -42,6 +42,76 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_wakeup
+ *
+ * Description:
+ *   Wake up a per-CPU worker unless it is already running or has already
+ *   been posted.  This keeps the worker semaphore count at most one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static void work_wakeup(FAR struct kworker_s *kworker)
+{
+  if (!kworker->awake)
+    {
+      kworker->awake = true;
+      nxsem_post(&kworker->sem);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: work_dispatch
+ *
+ * Description:
+ *   Add work that is ready to run to a work queue and wake up a worker.
+ *
+ *   With per-CPU work queues, the work goes to the lane of the calling CPU.
+ *   If the worker of that CPU is busy, an idle peer is woken up as well so
+ *   that it can steal the work instead of waiting.
+ *
+ *   Interrupts must be disabled.
+ *
+ ****************************************************************************/
+
+static void work_dispatch(FAR struct kwork_wqueue_s *wqueue,
+                          FAR struct work_s *work)
+{
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR struct kworker_s *kworker = &wqueue->worker[up_cpu_index()];
+  int wndx;
+#endif
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  work->ready = work_stats_now();
+#endif
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  sq_addlast((FAR sq_entry_t *)work, &kworker->q);
+  if (!kworker->awake)
+    {
+      work_wakeup(kworker);
+      return;
+    }
+
+  /* Our worker is busy, wake up an idle peer to steal the work */
+
+  for (wndx = 0; wndx < CONFIG_SMP_NCPUS; wndx++)
+    {
+      if (!wqueue->worker[wndx].awake)
+        {
+          work_wakeup(&wqueue->worker[wndx]);
+          break;
+        }
+    }
+#else
+  sq_addlast((FAR sq_entry_t *)work, &wqueue->q);
+  nxsem_post(&wqueue->sem);
+#endif
+}
+
 /****************************************************************************
  * Name: hp_work_timer_expiry
  ****************************************************************************/
@@ -50,8 +120,8 @@
 static void hp_work_timer_expiry(wdparm_t arg)
 {
   irqstate_t flags = enter_critical_section();
-  sq_addlast((FAR sq_entry_t *)arg, &g_hpwork.q);
-  nxsem_post(&g_hpwork.sem);
+  work_dispatch((FAR struct kwork_wqueue_s *)&g_hpwork,
+                (FAR struct work_s *)arg);
   leave_critical_section(flags);
 }
 #endif
@@ -64,8 +134,8 @@ static void hp_work_timer_expiry(wdparm_t arg)
 static void lp_work_timer_expiry(wdparm_t arg)
 {
   irqstate_t flags = enter_critical_section();
-  sq_addlast((FAR sq_entry_t *)arg, &g_lpwork.q);
-  nxsem_post(&g_lpwork.sem);
+  work_dispatch((FAR struct kwork_wqueue_s *)&g_lpwork,
+                (FAR struct work_s *)arg);
   leave_critical_section(flags);
 }
 #endif
@@ -134,8 +204,7 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
 
       if (!delay)
         {
-          sq_addlast((FAR sq_entry_t *)work, &g_hpwork.q);
-          nxsem_post(&g_hpwork.sem);
+          work_dispatch((FAR struct kwork_wqueue_s *)&g_hpwork, work);
         }
       else
         {
@@ -152,8 +221,7 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
 
       if (!delay)
         {
-          sq_addlast((FAR sq_entry_t *)work, &g_lpwork.q);
-          nxsem_post(&g_lpwork.sem);
+          work_dispatch((FAR struct kwork_wqueue_s *)&g_lpwork, work);
         }
       else
         {
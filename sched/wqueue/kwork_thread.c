@@ -77,22 +77,30 @@
 #if defined(CONFIG_SCHED_HPWORK)
 /* The state of the kernel mode, high priority work queue(s). */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+struct hp_wqueue_s g_hpwork;
+#else
 struct hp_wqueue_s g_hpwork =
 {
   {},
   NXSEM_INITIALIZER(0, PRIOINHERIT_FLAGS_DISABLE),
 };
+#endif
 
 #endif /* CONFIG_SCHED_HPWORK */
 
 #if defined(CONFIG_SCHED_LPWORK)
 /* The state of the kernel mode, low priority work queue(s). */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+struct lp_wqueue_s g_lpwork;
+#else
 struct lp_wqueue_s g_lpwork =
 {
   {},
   NXSEM_INITIALIZER(0, PRIOINHERIT_FLAGS_DISABLE),
 };
+#endif
 
 #endif /* CONFIG_SCHED_LPWORK */
 
@@ -100,6 +108,37 @@ struct lp_wqueue_s g_lpwork =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_steal
+ *
+ * Description:
+ *   Remove the oldest work from the lane of another worker, starting with
+ *   the next one so that the stealing is spread over the peers.  Interrupts
+ *   must be disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static FAR struct work_s *work_steal(FAR struct kwork_wqueue_s *wqueue,
+                                     int wndx)
+{
+  FAR struct work_s *work;
+  int i;
+
+  for (i = 1; i < CONFIG_SMP_NCPUS; i++)
+    {
+      work = (FAR struct work_s *)
+        sq_remfirst(&wqueue->worker[(wndx + i) % CONFIG_SMP_NCPUS].q);
+      if (work != NULL)
+        {
+          return work;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
 /****************************************************************************
  * Name: work_thread
  *
@@ -125,13 +164,23 @@ struct lp_wqueue_s g_lpwork =
 static int work_thread(int argc, FAR char *argv[])
 {
   FAR struct kwork_wqueue_s *wqueue;
+  FAR struct kworker_s *kworker;
   FAR struct work_s *work;
   worker_t  worker;
   irqstate_t flags;
   FAR void *arg;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  uint32_t start;
+  uint32_t elapsed;
+#endif
+  int wndx;
+
+  wqueue  = (FAR struct kwork_wqueue_s *)
+            ((uintptr_t)strtoul(argv[1], NULL, 0));
+  wndx    = atoi(argv[2]);
+  kworker = &wqueue->worker[wndx];
 
-  wqueue = (FAR struct kwork_wqueue_s *)
-           ((uintptr_t)strtoul(argv[1], NULL, 0));
+  UNUSED(kworker);
 
   flags = enter_critical_section();
 
@@ -139,6 +188,29 @@ static int work_thread(int argc, FAR char *argv[])
 
   for (; ; )
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* Take the oldest work of our own lane.  If it is empty, steal from
+       * a busy peer and only go to sleep when there is no work anywhere.
+       * Whoever queues work for us marks us awake before posting, so the
+       * semaphore count never exceeds one.
+       */
+
+      work = (FAR struct work_s *)sq_remfirst(&kworker->q);
+      if (work == NULL)
+        {
+          work = work_steal(wqueue, wndx);
+          if (work == NULL)
+            {
+              kworker->awake = false;
+              nxsem_wait_uninterruptible(&kworker->sem);
+              continue;
+            }
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          kworker->nstolen++;
+#endif
+        }
+#else
       /* Then process queued work.  work_process will not return until: (1)
        * there is no further work in the work queue, and (2) semaphore is
        * posted.
@@ -154,6 +226,7 @@ static int work_thread(int argc, FAR char *argv[])
       /* Remove the ready-to-execute work from the list */
 
       work = (FAR struct work_s *)sq_remfirst(&wqueue->q);
+#endif
       if (work && work->worker)
         {
           /* Extract the work description from the entry (in case the work
@@ -170,6 +243,18 @@ static int work_thread(int argc, FAR char *argv[])
 
           work->worker = NULL;
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          start   = work_stats_now();
+          elapsed = start - work->ready;
+
+          kworker->nrun++;
+          kworker->totalwait += elapsed;
+          if (elapsed > kworker->maxwait)
+            {
+              kworker->maxwait = elapsed;
+            }
+#endif
+
           /* Do the work.  Re-enable interrupts while the work is being
            * performed... we don't have any idea how long this will take!
            */
@@ -177,6 +262,16 @@ static int work_thread(int argc, FAR char *argv[])
           leave_critical_section(flags);
           CALL_WORKER(worker, arg);
           flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          elapsed = work_stats_now() - start;
+
+          kworker->totalrun += elapsed;
+          if (elapsed > kworker->maxrun)
+            {
+              kworker->maxrun = elapsed;
+            }
+#endif
         }
     }
 
@@ -208,14 +303,19 @@ static int work_thread_create(FAR const char *name, int priority,
                               int stack_size, int nthread,
                               FAR struct kwork_wqueue_s *wqueue)
 {
-  FAR char *argv[2];
+  FAR char *argv[3];
   char args[32];
+  char arg2[16];
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  cpu_set_t cpuset;
+#endif
   int wndx;
   int pid;
 
   snprintf(args, sizeof(args), "0x%" PRIxPTR, (uintptr_t)wqueue);
   argv[0] = args;
-  argv[1] = NULL;
+  argv[1] = arg2;
+  argv[2] = NULL;
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_hpwork and g_lpwork.
@@ -225,6 +325,16 @@ static int work_thread_create(FAR const char *name, int priority,
 
   for (wndx = 0; wndx < nthread; wndx++)
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      nxsem_init(&wqueue->worker[wndx].sem, 0, 0);
+      nxsem_set_protocol(&wqueue->worker[wndx].sem, SEM_PRIO_NONE);
+#endif
+
+      /* The worker index is passed to the thread.  The argument strings are
+       * copied by kthread_create(), so the buffer can be reused.
+       */
+
+      snprintf(arg2, sizeof(arg2), "%d", wndx);
       pid = kthread_create(name, priority, stack_size,
                            (main_t)work_thread, argv);
 
@@ -237,6 +347,14 @@ static int work_thread_create(FAR const char *name, int priority,
         }
 
       wqueue->worker[wndx].pid  = pid;
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* Bind the worker to the CPU whose lane it serves */
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(wndx, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
     }
 
   sched_unlock();
@@ -274,7 +392,7 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
   if (qid == HPWORK)
     {
       wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork;
-      nthread = CONFIG_SCHED_HPNTHREADS;
+      nthread = HPWORK_NTHREADS;
     }
   else
 #endif
@@ -282,7 +400,7 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
   if (qid == LPWORK)
     {
       wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
-      nthread = CONFIG_SCHED_LPNTHREADS;
+      nthread = LPWORK_NTHREADS;
     }
   else
 #endif
@@ -296,6 +414,84 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
     }
 }
 
+/****************************************************************************
+ * Name: work_stats
+ *
+ * Description:
+ *   Return the statistics of one worker thread of a kernel work queue.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID (must be HPWORK or LPWORK)
+ *   wndx  - The index of the worker thread in the queue
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure:
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *   -ENOENT - There is no such worker thread
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_stats(int qid, int wndx, FAR struct work_stats_s *stats)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  FAR struct kworker_s *kworker;
+  irqstate_t flags;
+  int nthread;
+
+  DEBUGASSERT(stats != NULL);
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork;
+      nthread = HPWORK_NTHREADS;
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
+      nthread = LPWORK_NTHREADS;
+    }
+  else
+#endif
+    {
+      return -EINVAL;
+    }
+
+  if (wndx < 0 || wndx >= nthread)
+    {
+      return -ENOENT;
+    }
+
+  kworker = &wqueue->worker[wndx];
+
+  /* Take a consistent snapshot of the counters */
+
+  flags = enter_critical_section();
+
+  stats->pid       = kworker->pid;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  stats->cpu       = wndx;
+#else
+  stats->cpu       = -1;
+#endif
+  stats->nrun      = kworker->nrun;
+  stats->nstolen   = kworker->nstolen;
+  stats->maxwait   = kworker->maxwait;
+  stats->totalwait = kworker->totalwait;
+  stats->maxrun    = kworker->maxrun;
+  stats->totalrun  = kworker->totalrun;
+
+  leave_critical_section(flags);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: work_start_highpri
  *
@@ -319,7 +515,7 @@ int work_start_highpri(void)
 
   return work_thread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
                             CONFIG_SCHED_HPWORKSTACKSIZE,
-                            CONFIG_SCHED_HPNTHREADS,
+                            HPWORK_NTHREADS,
                             (FAR struct kwork_wqueue_s *)&g_hpwork);
 }
 #endif /* CONFIG_SCHED_HPWORK */
@@ -347,7 +543,7 @@ int work_start_lowpri(void)
 
   return work_thread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
                             CONFIG_SCHED_LPWORKSTACKSIZE,
-                            CONFIG_SCHED_LPNTHREADS,
+                            LPWORK_NTHREADS,
                             (FAR struct kwork_wqueue_s *)&g_lpwork);
 }
 #endif /* CONFIG_SCHED_LPWORK */
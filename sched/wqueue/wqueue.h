@@ -31,6 +31,7 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -43,6 +44,18 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* Number of worker threads of each kernel work queue.  With per-CPU work
+ * queues there is exactly one worker bound to each CPU.
+ */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+#  define HPWORK_NTHREADS CONFIG_SMP_NCPUS
+#  define LPWORK_NTHREADS CONFIG_SMP_NCPUS
+#else
+#  define HPWORK_NTHREADS CONFIG_SCHED_HPNTHREADS
+#  define LPWORK_NTHREADS CONFIG_SCHED_LPNTHREADS
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -52,14 +65,29 @@
 struct kworker_s
 {
   pid_t             pid;       /* The task ID of the worker thread */
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  struct sq_queue_s q;         /* The work queued on this worker's CPU */
+  sem_t             sem;       /* Wakes up the worker */
+  volatile bool     awake;     /* The worker is running or has been posted */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  uint32_t          nrun;      /* Number of work items run */
+  uint32_t          nstolen;   /* Number taken from another worker */
+  uint32_t          maxwait;   /* Longest queue-to-start time (usec) */
+  uint64_t          totalwait; /* Sum of the queue-to-start times (usec) */
+  uint32_t          maxrun;    /* Longest run time (usec) */
+  uint64_t          totalrun;  /* Sum of the run times (usec) */
+#endif
 };
 
 /* This structure defines the state of one kernel-mode work queue */
 
 struct kwork_wqueue_s
 {
+#ifndef CONFIG_SCHED_WORKQUEUE_PERCPU
   struct sq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+#endif
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -70,12 +98,14 @@ struct kwork_wqueue_s
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s
 {
+#ifndef CONFIG_SCHED_WORKQUEUE_PERCPU
   struct sq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_HPNTHREADS];
+  struct kworker_s  worker[HPWORK_NTHREADS];
 };
 #endif
 
@@ -86,12 +116,14 @@ struct hp_wqueue_s
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s
 {
+#ifndef CONFIG_SCHED_WORKQUEUE_PERCPU
   struct sq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_LPNTHREADS];
+  struct kworker_s  worker[LPWORK_NTHREADS];
 };
 #endif
 
@@ -111,6 +143,30 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_stats_now
+ *
+ * Description:
+ *   Return the time stamp used by the work queue statistics, in
+ *   microseconds.  It wraps around after about 71 minutes, which is fine
+ *   for measuring intervals.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+static inline uint32_t work_stats_now(void)
+{
+  struct timespec ts;
+
+  clock_systime_timespec(&ts);
+  return (uint32_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
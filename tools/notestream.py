@@ -0,0 +1,269 @@
+#!/usr/bin/python3
+# tools/notestream.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+import argparse
+import sys
+
+program_description = """
+This program converts the binary note stream written by the note streaming
+driver (CONFIG_DRIVER_NOTESTREAM) to the ftrace text format, which can be
+loaded into Perfetto (ui.perfetto.dev), Trace Compass and other tools that
+read Linux traces.
+"""
+
+# See include/nuttx/note/notestream_driver.h
+
+NOTESTREAM_MAGIC = b"NXNS"
+NOTESTREAM_VERSION = 1
+NOTESTREAM_FLAG_SMP = 1 << 0
+NOTESTREAM_FLAG_HIRES = 1 << 1
+NOTESTREAM_HEADER_SIZE = 14
+
+# See enum note_type_e in include/nuttx/sched_note.h
+
+NOTE_START = 0
+NOTE_STOP = 1
+NOTE_SUSPEND = 2
+NOTE_RESUME = 3
+NOTE_PREEMPT_LOCK = 10
+NOTE_PREEMPT_UNLOCK = 11
+NOTE_SYSCALL_ENTER = 18
+NOTE_SYSCALL_LEAVE = 19
+NOTE_IRQ_ENTER = 20
+NOTE_IRQ_LEAVE = 21
+NOTE_DUMP_STRING = 22
+
+
+def getint(data, offset, size, signed=False):
+    return int.from_bytes(data[offset : offset + size], "little", signed=signed)
+
+
+class note_stream:
+    def __init__(self, data):
+        if len(data) < NOTESTREAM_HEADER_SIZE or data[0:4] != NOTESTREAM_MAGIC:
+            raise ValueError("not a note stream")
+
+        if data[4] != NOTESTREAM_VERSION:
+            raise ValueError("unsupported note stream version %d" % data[4])
+
+        flags = data[5]
+        self.smp = (flags & NOTESTREAM_FLAG_SMP) != 0
+        self.hires = (flags & NOTESTREAM_FLAG_HIRES) != 0
+        self.pidsize = data[6]
+        self.ptrsize = data[7]
+        self.timesize = (data[8], data[9])
+        self.usecpertick = getint(data, 10, 4)
+        self.data = data
+        self.offset = NOTESTREAM_HEADER_SIZE
+
+        # The size of struct note_common_s
+
+        self.cmnsize = 3 + (1 if self.smp else 0) + self.pidsize
+        self.cmnsize += self.timesize[0] + self.timesize[1]
+
+        # The state of a task switched out of a CPU that is still ready to
+        # run (TSTATE_TASK_RUNNING and below)
+
+        self.runstate = 4 if self.smp else 3
+
+    def notes(self):
+        while self.offset + self.cmnsize <= len(self.data):
+            length = self.data[self.offset]
+            if length < self.cmnsize or self.offset + length > len(self.data):
+                break
+
+            yield self.parse(self.data[self.offset : self.offset + length])
+            self.offset += length
+
+    def parse(self, note):
+        offset = 3
+        cpu = 0
+        if self.smp:
+            cpu = note[offset]
+            offset += 1
+
+        pid = getint(note, offset, self.pidsize)
+        offset += self.pidsize
+
+        if self.hires:
+            sec = getint(note, offset, self.timesize[0])
+            nsec = getint(note, offset + self.timesize[0], self.timesize[1])
+            timestamp = sec + nsec / 1000000000
+        else:
+            ticks = getint(note, offset, self.timesize[0])
+            timestamp = ticks * self.usecpertick / 1000000
+
+        return {
+            "type": note[1],
+            "prio": note[2],
+            "cpu": cpu,
+            "pid": pid,
+            "time": timestamp,
+            "payload": note[self.cmnsize :],
+        }
+
+
+class ftrace_output:
+    def __init__(self, stream, out):
+        self.stream = stream
+        self.out = out
+        self.names = {}
+        self.running = {}
+        self.suspended = {}
+
+    def comm(self, pid):
+        return self.names.get(pid, "<...>")
+
+    def event(self, note, pid, text):
+        self.out.write(
+            "%16s-%-5d [%03d] .... %12.6f: %s\n"
+            % (self.comm(pid), pid, note["cpu"], note["time"], text)
+        )
+
+    def convert(self):
+        self.out.write("# tracer: nop\n#\n")
+        for note in self.stream.notes():
+            handler = self.handlers.get(note["type"])
+            if handler is not None:
+                handler(self, note)
+
+    def start(self, note):
+        name = note["payload"].split(b"\0")[0].decode(errors="replace")
+        name = name.replace(" ", "_") or "<...>"
+        self.names[note["pid"]] = name
+        self.event(
+            note,
+            note["pid"],
+            "sched_wakeup_new: comm=%s pid=%d prio=%d target_cpu=%03d"
+            % (name, note["pid"], note["prio"], note["cpu"]),
+        )
+
+    def stop(self, note):
+        self.event(
+            note,
+            note["pid"],
+            "sched_process_exit: comm=%s pid=%d prio=%d"
+            % (self.comm(note["pid"]), note["pid"], note["prio"]),
+        )
+
+    def suspend(self, note):
+        state = note["payload"][0] if note["payload"] else 0
+        self.suspended[note["cpu"]] = (note["pid"], note["prio"], state)
+
+    def resume(self, note):
+        cpu = note["cpu"]
+        prev = self.suspended.pop(cpu, None)
+        if prev is None:
+            prev = (self.running.get(cpu, 0), 0, self.stream.runstate)
+
+        prevpid, prevprio, state = prev
+        prevstate = "R" if state <= self.stream.runstate else "S"
+        self.running[cpu] = note["pid"]
+        self.event(
+            note,
+            prevpid,
+            "sched_switch: prev_comm=%s prev_pid=%d prev_prio=%d "
+            "prev_state=%s ==> next_comm=%s next_pid=%d next_prio=%d"
+            % (
+                self.comm(prevpid),
+                prevpid,
+                prevprio,
+                prevstate,
+                self.comm(note["pid"]),
+                note["pid"],
+                note["prio"],
+            ),
+        )
+
+    def preempt(self, note):
+        if note["type"] == NOTE_PREEMPT_LOCK:
+            text = "preempt_disable"
+        else:
+            text = "preempt_enable"
+
+        self.event(note, note["pid"], text + ": caller=0 parent=0")
+
+    def syscall_enter(self, note):
+        payload = note["payload"]
+        size = self.stream.ptrsize
+        args = [
+            "0x%x" % getint(payload, 2 + i * size, size) for i in range(payload[1])
+        ]
+        self.event(
+            note,
+            note["pid"],
+            "sys_enter: NR %d (%s)" % (payload[0], ", ".join(args)),
+        )
+
+    def syscall_leave(self, note):
+        payload = note["payload"]
+        size = self.stream.ptrsize
+        self.event(
+            note,
+            note["pid"],
+            "sys_exit: NR %d = %d"
+            % (payload[0], getint(payload, 1, size, signed=True)),
+        )
+
+    def irq_enter(self, note):
+        irq = note["payload"][0]
+        self.event(
+            note, note["pid"], "irq_handler_entry: irq=%d name=irq%d" % (irq, irq)
+        )
+
+    def irq_leave(self, note):
+        irq = note["payload"][0]
+        self.event(note, note["pid"], "irq_handler_exit: irq=%d ret=handled" % irq)
+
+    def dump_string(self, note):
+        text = note["payload"][self.stream.ptrsize :].split(b"\0")[0]
+        self.event(
+            note,
+            note["pid"],
+            "tracing_mark_write: %s" % text.decode(errors="replace"),
+        )
+
+    handlers = {
+        NOTE_START: start,
+        NOTE_STOP: stop,
+        NOTE_SUSPEND: suspend,
+        NOTE_RESUME: resume,
+        NOTE_PREEMPT_LOCK: preempt,
+        NOTE_PREEMPT_UNLOCK: preempt,
+        NOTE_SYSCALL_ENTER: syscall_enter,
+        NOTE_SYSCALL_LEAVE: syscall_leave,
+        NOTE_IRQ_ENTER: irq_enter,
+        NOTE_IRQ_LEAVE: irq_leave,
+        NOTE_DUMP_STRING: dump_string,
+    }
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=program_description)
+    parser.add_argument("input", help="the note stream written by the target")
+    parser.add_argument("-o", "--output", help="the ftrace file, stdout if omitted")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        stream = note_stream(f.read())
+
+    if args.output:
+        with open(args.output, "w") as out:
+            ftrace_output(stream, out).convert()
+    else:
+        ftrace_output(stream, sys.stdout).convert()